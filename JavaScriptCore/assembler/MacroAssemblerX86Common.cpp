@@ -29,6 +29,12 @@
 #include "MacroAssemblerX86Common.h"
 
 #include <wtf/InlineASM.h>
+#include <mutex>
+
+#if COMPILER(MSVC)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
 
 namespace JSC {
 
@@ -552,6 +558,110 @@ void MacroAssemblerX86Common::probe(MacroAssemblerX86Common::ProbeFunction funct
 MacroAssemblerX86Common::SSE2CheckState MacroAssemblerX86Common::s_sse2CheckState = NotCheckedSSE2;
 #endif
 
+namespace {
+
+struct CPUFeatures {
+    bool sse4_2 { false };
+    bool avx { false };
+    bool avx2 { false };
+    bool fma { false };
+};
+
+#if CPU(X86_64) && (COMPILER(GCC_OR_CLANG) || COMPILER(MSVC))
+void cpuid(unsigned leaf, unsigned subleaf, unsigned registers[4])
+{
+#if COMPILER(MSVC)
+    __cpuidex(reinterpret_cast<int*>(registers), leaf, subleaf);
+#else
+    asm volatile (
+        "cpuid"
+        : "=a" (registers[0]), "=b" (registers[1]), "=c" (registers[2]), "=d" (registers[3])
+        : "a" (leaf), "c" (subleaf));
+#endif
+}
+
+uint64_t extendedControlRegister0()
+{
+#if COMPILER(MSVC)
+    return _xgetbv(0);
+#else
+    unsigned low;
+    unsigned high;
+    asm volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+
+CPUFeatures collectCPUFeatures()
+{
+    CPUFeatures result;
+    unsigned registers[4];
+
+    cpuid(0, 0, registers);
+    unsigned maxLeaf = registers[0];
+    if (maxLeaf < 1)
+        return result;
+
+    cpuid(1, 0, registers);
+    unsigned ecx = registers[2];
+    result.sse4_2 = ecx & (1 << 20);
+
+    // AVX is only usable if the OS has enabled saving of the XMM and YMM state, which it
+    // advertises through OSXSAVE and the bits it set in XCR0.
+    static const unsigned osxsaveBit = 1 << 27;
+    static const unsigned avxBit = 1 << 28;
+    static const uint64_t xmmAndYMMState = 0x6;
+    if (!(ecx & osxsaveBit) || !(ecx & avxBit))
+        return result;
+    if ((extendedControlRegister0() & xmmAndYMMState) != xmmAndYMMState)
+        return result;
+
+    result.avx = true;
+    result.fma = ecx & (1 << 12);
+
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, registers);
+        result.avx2 = registers[1] & (1 << 5);
+    }
+    return result;
+}
+#else
+CPUFeatures collectCPUFeatures()
+{
+    return CPUFeatures();
+}
+#endif
+
+const CPUFeatures& cpuFeatures()
+{
+    static CPUFeatures features;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] { features = collectCPUFeatures(); });
+    return features;
+}
+
+} // anonymous namespace
+
+bool MacroAssemblerX86Common::supportsSSE4_2()
+{
+    return cpuFeatures().sse4_2;
+}
+
+bool MacroAssemblerX86Common::supportsAVX()
+{
+    return cpuFeatures().avx;
+}
+
+bool MacroAssemblerX86Common::supportsAVX2()
+{
+    return cpuFeatures().avx2;
+}
+
+bool MacroAssemblerX86Common::supportsFMA()
+{
+    return cpuFeatures().fma;
+}
+
 } // namespace JSC
 
 #endif // ENABLE(ASSEMBLER) && (CPU(X86) || CPU(X86_64))
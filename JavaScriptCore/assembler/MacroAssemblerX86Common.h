@@ -1636,11 +1636,30 @@ public:
         m_assembler.mfence();
     }
 
+    // Only valid when supportsAVX().
+    void zeroUpperVectorBits()
+    {
+        m_assembler.vzeroupper();
+    }
+
+    // Features of the host CPU beyond the SSE2 baseline. We don't generate code that needs them
+    // ourselves, but the FTL's LLVM backend does when it is allowed to. supportsAVX() also checks
+    // that the OS saves the YMM registers on context switches.
+    static bool supportsSSE4_2();
+    static bool supportsAVX();
+    static bool supportsAVX2();
+    static bool supportsFMA();
+
     static void replaceWithJump(CodeLocationLabel instructionStart, CodeLocationLabel destination)
     {
         X86Assembler::replaceWithJump(instructionStart.executableAddress(), destination.executableAddress());
     }
     
+    static void replaceWithCall(CodeLocationLabel instructionStart, CodeLocationLabel destination)
+    {
+        X86Assembler::replaceWithCall(instructionStart.executableAddress(), destination.executableAddress());
+    }
+    
     static ptrdiff_t maxJumpReplacementSize()
     {
         return X86Assembler::maxJumpReplacementSize();
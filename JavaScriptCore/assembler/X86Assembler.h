@@ -238,6 +238,7 @@ private:
         OP_MOV_EAXIv                    = 0xB8,
         OP_GROUP2_EvIb                  = 0xC1,
         OP_RET                          = 0xC3,
+        PRE_VEX_2BYTE                   = 0xC5,
         OP_GROUP11_EvIb                 = 0xC6,
         OP_GROUP11_EvIz                 = 0xC7,
         OP_INT3                         = 0xCC,
@@ -276,6 +277,7 @@ private:
         OP2_ANDNPD_VpdWpd   = 0x55,
         OP2_XORPD_VpdWpd    = 0x57,
         OP2_MOVD_VdEd       = 0x6E,
+        OP2_VZEROUPPER      = 0x77,
         OP2_MOVD_EdVd       = 0x7E,
         OP2_JCC_rel32       = 0x80,
         OP_SETCC            = 0x90,
@@ -296,6 +298,10 @@ private:
         OP3_MFENCE          = 0xF0,
     } ThreeByteOpcodeID;
 
+    typedef enum {
+        VEX_NO_OPERANDS     = 0xF8,
+    } VexPayload;
+
     
     TwoByteOpcodeID cmovcc(Condition cond)
     {
@@ -2160,6 +2166,14 @@ public:
         m_formatter.threeByteOp(OP3_MFENCE);
     }
 
+    // Clears the upper halves of the YMM registers, so that the SSE instructions we emit don't
+    // pay for a transition out of the AVX state left behind by LLVM generated code. Only valid
+    // when the CPU supports AVX.
+    void vzeroupper()
+    {
+        m_formatter.vexTwoByteOp(VEX_NO_OPERANDS, OP2_VZEROUPPER);
+    }
+
     // Assembler admin methods:
 
     size_t codeSize() const
@@ -2280,6 +2294,17 @@ public:
         *reinterpret_cast<int32_t*>(ptr + 1) = static_cast<int32_t>(distance);
     }
     
+    // Like replaceWithJump(), but leaves the address of the instruction after the call on the
+    // stack, so that the destination can tell which site it was reached from.
+    static void replaceWithCall(void* instructionStart, void* to)
+    {
+        uint8_t* ptr = reinterpret_cast<uint8_t*>(instructionStart);
+        uint8_t* dstPtr = reinterpret_cast<uint8_t*>(to);
+        intptr_t distance = (intptr_t)(dstPtr - (ptr + 5));
+        ptr[0] = static_cast<uint8_t>(OP_CALL_rel32);
+        *reinterpret_cast<int32_t*>(ptr + 1) = static_cast<int32_t>(distance);
+    }
+    
     static ptrdiff_t maxJumpReplacementSize()
     {
         return 5;
@@ -2592,6 +2617,18 @@ private:
         }
 #endif
 
+        // VEX prefixed instructions with a two byte VEX prefix, which implies the 0x0F opcode map.
+        // The payload holds the inverted REX.R bit, the inverted extra source register, the vector
+        // length and the implied SSE prefix.
+
+        void vexTwoByteOp(VexPayload payload, TwoByteOpcodeID opcode)
+        {
+            m_buffer.ensureSpace(maxInstructionSize);
+            m_buffer.putByteUnchecked(PRE_VEX_2BYTE);
+            m_buffer.putByteUnchecked(payload);
+            m_buffer.putByteUnchecked(opcode);
+        }
+
         void twoByteOp(TwoByteOpcodeID opcode)
         {
             m_buffer.ensureSpace(maxInstructionSize);
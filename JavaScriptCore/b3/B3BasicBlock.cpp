@@ -54,6 +54,12 @@ void BasicBlock::append(Value* value)
     m_values.append(value);
 }
 
+void BasicBlock::appendNonTerminal(Value* value)
+{
+    m_values.append(m_values.last());
+    m_values[m_values.size() - 2] = value;
+}
+
 void BasicBlock::removeLast(Procedure& proc)
 {
     ASSERT(!m_values.isEmpty());
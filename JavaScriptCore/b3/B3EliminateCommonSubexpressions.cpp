@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "B3EliminateCommonSubexpressions.h"
+
+#if ENABLE(B3_JIT)
+
+#include "B3BasicBlockInlines.h"
+#include "B3BlockWorklist.h"
+#include "B3CFG.h"
+#include "B3Dominators.h"
+#include "B3IndexMap.h"
+#include "B3MemoryValue.h"
+#include "B3PhaseScope.h"
+#include "B3ProcedureInlines.h"
+#include "B3ValueInlines.h"
+#include "B3ValueKeyInlines.h"
+#include <wtf/HashMap.h>
+
+namespace JSC { namespace B3 {
+
+namespace {
+
+const bool verbose = false;
+
+class CSE {
+public:
+    CSE(Procedure& proc)
+        : m_proc(proc)
+        , m_cfg(proc)
+        , m_dominators(m_cfg)
+        , m_blockWrites(proc.size())
+    {
+    }
+
+    bool run()
+    {
+        m_proc.resetValueOwners();
+
+        for (BasicBlock* block : m_proc) {
+            HeapRange writes;
+            for (Value* value : *block)
+                writes = writes.merge(value->effects().writes);
+            m_blockWrites[block] = writes;
+        }
+
+        // Pre-order guarantees that we see a block's dominators before we see the block.
+        for (BasicBlock* block : m_proc.blocksInPreOrder()) {
+            m_block = block;
+            for (m_index = 0; m_index < block->size(); ++m_index)
+                process();
+        }
+
+        return m_changed;
+    }
+
+private:
+    struct MemoryMatch {
+        MemoryValue* value;
+        unsigned index;
+    };
+
+    void process()
+    {
+        m_value = m_block->at(m_index);
+        m_value->performSubstitution();
+
+        if (m_value->opcode() == Identity || m_value->opcode() == Nop)
+            return;
+
+        if (ValueKey key = m_value->key()) {
+            processPure(key);
+            return;
+        }
+
+        if (MemoryValue* memory = m_value->as<MemoryValue>())
+            processMemory(memory);
+    }
+
+    void processPure(const ValueKey& key)
+    {
+        Vector<Value*>& matches = m_pureValues.add(key, Vector<Value*>()).iterator->value;
+        for (Value* match : matches) {
+            if (!m_dominators.dominates(match->owner, m_block))
+                continue;
+
+            if (verbose)
+                dataLog("Replacing ", *m_value, " with ", *match, "\n");
+
+            // A Check that is dominated by an identical Check can never exit.
+            if (m_value->type() == Void)
+                m_value->replaceWithNop();
+            else
+                m_value->replaceWithIdentity(match);
+            m_changed = true;
+            return;
+        }
+        matches.append(m_value);
+    }
+
+    void processMemory(MemoryValue* memory)
+    {
+        Value* pointer = memory->lastChild();
+        Vector<MemoryMatch>& matches = m_memoryValues.add(pointer, Vector<MemoryMatch>()).iterator->value;
+
+        if (isLoad(memory->opcode())) {
+            // Prefer the closest match.
+            for (unsigned i = matches.size(); i--;) {
+                MemoryMatch match = matches[i];
+                Value* replacement = valueForLoad(memory, match.value);
+                if (!replacement)
+                    continue;
+                if (!m_dominators.dominates(match.value->owner, m_block))
+                    continue;
+                if (isClobbered(match.value->owner, match.index, memory->range()))
+                    continue;
+
+                if (verbose)
+                    dataLog("Replacing ", *memory, " with ", *replacement, "\n");
+
+                memory->replaceWithIdentity(replacement);
+                m_changed = true;
+                return;
+            }
+        }
+
+        matches.append(MemoryMatch { memory, m_index });
+    }
+
+    static bool isLoad(Opcode opcode)
+    {
+        switch (opcode) {
+        case Load8Z:
+        case Load8S:
+        case Load16Z:
+        case Load16S:
+        case LoadFloat:
+        case Load:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Returns the value that 'load' would see if 'match' was the last thing to touch its address.
+    Value* valueForLoad(MemoryValue* load, MemoryValue* match)
+    {
+        if (load->offset() != match->offset())
+            return nullptr;
+
+        if (match->opcode() == load->opcode() && match->type() == load->type())
+            return match;
+
+        // Only forward stores that don't convert the value on the way to memory.
+        if (match->opcode() == Store && load->opcode() == Load
+            && match->child(0)->type() == load->type())
+            return match->child(0);
+
+        return nullptr;
+    }
+
+    // Tells if anything between 'fromBlock'[fromIndex] and the current value may write to 'range'.
+    // This assumes that 'fromBlock' dominates the current block.
+    bool isClobbered(BasicBlock* fromBlock, unsigned fromIndex, const HeapRange& range)
+    {
+        if (fromBlock == m_block)
+            return writes(m_block, fromIndex + 1, m_index, range);
+
+        if (writes(fromBlock, fromIndex + 1, fromBlock->size(), range))
+            return true;
+        if (writes(m_block, 0, m_index, range))
+            return true;
+
+        // Walk backwards from the current block. Since 'fromBlock' dominates us, we will stop there
+        // on every path. Passing through the start of 'fromBlock' again means re-executing the match,
+        // so we don't have to look at the rest of it.
+        BlockWorklist worklist;
+        for (BasicBlock* predecessor : m_block->predecessors())
+            worklist.push(predecessor);
+        while (BasicBlock* block = worklist.pop()) {
+            if (block == fromBlock)
+                continue;
+            if (m_blockWrites[block].overlaps(range))
+                return true;
+            for (BasicBlock* predecessor : block->predecessors())
+                worklist.push(predecessor);
+        }
+
+        return false;
+    }
+
+    bool writes(BasicBlock* block, unsigned begin, unsigned end, const HeapRange& range)
+    {
+        for (unsigned i = begin; i < end; ++i) {
+            if (block->at(i)->effects().writes.overlaps(range))
+                return true;
+        }
+        return false;
+    }
+
+    Procedure& m_proc;
+    CFG m_cfg;
+    Dominators m_dominators;
+    IndexMap<BasicBlock, HeapRange> m_blockWrites;
+
+    HashMap<ValueKey, Vector<Value*>> m_pureValues;
+    HashMap<Value*, Vector<MemoryMatch>> m_memoryValues;
+
+    BasicBlock* m_block { nullptr };
+    unsigned m_index { 0 };
+    Value* m_value { nullptr };
+    bool m_changed { false };
+};
+
+} // anonymous namespace
+
+bool eliminateCommonSubexpressions(Procedure& proc)
+{
+    PhaseScope phaseScope(proc, "eliminateCommonSubexpressions");
+    CSE cse(proc);
+    return cse.run();
+}
+
+} } // namespace JSC::B3
+
+#endif // ENABLE(B3_JIT)
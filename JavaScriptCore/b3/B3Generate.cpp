@@ -32,6 +32,8 @@
 #include "AirGenerate.h"
 #include "AirInstInlines.h"
 #include "B3Common.h"
+#include "B3EliminateCommonSubexpressions.h"
+#include "B3HoistLoopInvariantValues.h"
 #include "B3LowerMacros.h"
 #include "B3LowerToAir.h"
 #include "B3MoveConstants.h"
@@ -47,7 +49,7 @@ void prepareForGeneration(Procedure& procedure, unsigned optLevel)
     TimingScope timingScope("prepareForGeneration");
 
     generateToAir(procedure, optLevel);
-    Air::prepareForGeneration(procedure.code());
+    Air::prepareForGeneration(procedure.code(), optLevel);
 }
 
 void generate(Procedure& procedure, CCallHelpers& jit)
@@ -74,6 +76,12 @@ void generateToAir(Procedure& procedure, unsigned optLevel)
 
     if (optLevel >= 1) {
         reduceStrength(procedure);
+        if (eliminateCommonSubexpressions(procedure))
+            reduceStrength(procedure);
+        if (hoistLoopInvariantValues(procedure)) {
+            eliminateCommonSubexpressions(procedure);
+            reduceStrength(procedure);
+        }
         
         // FIXME: Add more optimizations here.
         // https://bugs.webkit.org/show_bug.cgi?id=150507
@@ -28,6 +28,7 @@
 
 #if ENABLE(B3_JIT)
 
+#include <algorithm>
 #include <limits.h>
 #include <wtf/MathExtras.h>
 #include <wtf/PrintStream.h>
@@ -84,6 +85,17 @@ public:
         return WTF::rangesOverlap(m_begin, m_end, other.m_begin, other.m_end);
     }
 
+    // Returns the smallest range that covers both ranges. This may cover more than their union,
+    // which is fine for conservatively summarizing the effects of many values.
+    HeapRange merge(const HeapRange& other) const
+    {
+        if (!*this)
+            return other;
+        if (!other)
+            return *this;
+        return HeapRange(std::min(m_begin, other.m_begin), std::max(m_end, other.m_end));
+    }
+
     void dump(PrintStream& out) const;
 
 private:
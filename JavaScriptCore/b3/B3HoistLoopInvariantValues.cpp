@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "B3HoistLoopInvariantValues.h"
+
+#if ENABLE(B3_JIT)
+
+#include "B3BasicBlockInlines.h"
+#include "B3BlockInsertionSet.h"
+#include "B3CFG.h"
+#include "B3ControlValue.h"
+#include "B3Dominators.h"
+#include "B3NaturalLoops.h"
+#include "B3PhaseScope.h"
+#include "B3ProcedureInlines.h"
+#include "B3ValueInlines.h"
+
+namespace JSC { namespace B3 {
+
+namespace {
+
+const bool verbose = false;
+
+class HoistLoopInvariantValues {
+public:
+    HoistLoopInvariantValues(Procedure& proc)
+        : m_proc(proc)
+    {
+    }
+
+    bool run()
+    {
+        bool changed = ensurePreHeaders();
+
+        m_proc.resetValueOwners();
+
+        CFG cfg(m_proc);
+        Dominators dominators(cfg);
+        NaturalLoops loops(m_proc, dominators);
+        if (!loops.numLoops())
+            return changed;
+
+        m_data.resize(loops.numLoops());
+        for (unsigned loopIndex = loops.numLoops(); loopIndex--;) {
+            const NaturalLoop& loop = loops.loop(loopIndex);
+            LoopData& data = m_data[loopIndex];
+
+            data.preHeader = preHeaderOf(loops, loop);
+
+            // The body of a loop includes the bodies of the loops nested in it, so this also
+            // accounts for their effects.
+            for (unsigned blockIndex = loop.size(); blockIndex--;) {
+                for (Value* value : *loop[blockIndex])
+                    data.writes = data.writes.merge(value->effects().writes);
+            }
+        }
+
+        // Pre-order ensures that we see a loop's pre-header, and everything hoisted into it, before
+        // we see the loop.
+        for (BasicBlock* block : m_proc.blocksInPreOrder()) {
+            Vector<const NaturalLoop*> blockLoops = loops.loopsOf(block);
+            if (blockLoops.isEmpty())
+                continue;
+
+            unsigned targetIndex = 0;
+            bool exitsBeforeValue = false;
+            for (unsigned sourceIndex = 0; sourceIndex < block->size(); ++sourceIndex) {
+                Value* value = block->at(sourceIndex);
+                if (BasicBlock* preHeader = hoistingTarget(dominators, block, value, blockLoops, exitsBeforeValue)) {
+                    if (verbose)
+                        dataLog("Hoisting ", *value, " from ", *block, " to ", *preHeader, "\n");
+                    preHeader->appendNonTerminal(value);
+                    value->owner = preHeader;
+                    changed = true;
+                    continue;
+                }
+                exitsBeforeValue |= value->effects().exitsSideways;
+                block->at(targetIndex++) = value;
+            }
+            block->values().resize(targetIndex);
+        }
+
+        return changed;
+    }
+
+private:
+    struct LoopData {
+        HeapRange writes;
+        BasicBlock* preHeader { nullptr };
+    };
+
+    // Gives each loop a block that jumps to its header and that all entries into the loop go
+    // through. Loops headed by the root block are left alone, since the root has no entries that we
+    // could redirect.
+    bool ensurePreHeaders()
+    {
+        CFG cfg(m_proc);
+        Dominators dominators(cfg);
+        NaturalLoops loops(m_proc, dominators);
+
+        BlockInsertionSet insertionSet(m_proc);
+        for (unsigned loopIndex = loops.numLoops(); loopIndex--;) {
+            const NaturalLoop& loop = loops.loop(loopIndex);
+            BasicBlock* header = loop.header();
+            if (header == m_proc[0] || preHeaderOf(loops, loop))
+                continue;
+
+            Vector<BasicBlock*, 4> outsidePredecessors;
+            double frequency = 0;
+            for (BasicBlock* predecessor : header->predecessors()) {
+                if (loops.belongsTo(predecessor, loop))
+                    continue;
+                outsidePredecessors.append(predecessor);
+                frequency += predecessor->frequency();
+            }
+
+            BasicBlock* preHeader = insertionSet.insertBefore(header, frequency);
+            preHeader->appendNew<ControlValue>(
+                m_proc, Jump, header->at(0)->origin(), FrequentedBlock(header));
+
+            for (BasicBlock* predecessor : outsidePredecessors) {
+                predecessor->replaceSuccessor(header, preHeader);
+                preHeader->addPredecessor(predecessor);
+                header->removePredecessor(predecessor);
+            }
+            header->addPredecessor(preHeader);
+        }
+
+        return insertionSet.execute();
+    }
+
+    // Returns the loop's only way in from the outside, if that block has no other successors.
+    static BasicBlock* preHeaderOf(const NaturalLoops& loops, const NaturalLoop& loop)
+    {
+        BasicBlock* result = nullptr;
+        for (BasicBlock* predecessor : loop.header()->predecessors()) {
+            if (loops.belongsTo(predecessor, loop))
+                continue;
+            if (result && result != predecessor)
+                return nullptr;
+            result = predecessor;
+        }
+        if (!result || result->numSuccessors() != 1)
+            return nullptr;
+        return result;
+    }
+
+    // Returns the pre-header of the outer-most loop that 'value' can be hoisted out of, or null.
+    // 'exitsBeforeValue' tells if anything before 'value' in its block may exit sideways.
+    BasicBlock* hoistingTarget(
+        Dominators& dominators, BasicBlock* block, Value* value,
+        const Vector<const NaturalLoop*>& blockLoops, bool exitsBeforeValue)
+    {
+        // Constants are free to materialize and moveConstants() would just put them back.
+        if (value->isConstant() || value->opcode() == Identity || value->opcode() == Nop)
+            return nullptr;
+
+        // We never hoist anything that writes, exits, or is part of SSA data flow.
+        Effects effects = value->effects();
+        if (effects.mustExecute() || effects.readsSSAState)
+            return nullptr;
+
+        for (unsigned i = blockLoops.size(); i--;) {
+            const NaturalLoop& loop = *blockLoops[i];
+            const LoopData& data = m_data[loop.index()];
+            BasicBlock* preHeader = data.preHeader;
+            if (!preHeader)
+                continue;
+
+            bool childrenAreInvariant = true;
+            for (Value* child : value->children()) {
+                if (!dominators.dominates(child->owner, preHeader)) {
+                    childrenAreInvariant = false;
+                    break;
+                }
+            }
+            if (!childrenAreInvariant)
+                continue;
+
+            // Things like loads and divisions may only run if the program would have run them
+            // anyway. The loop header runs whenever the pre-header does, and only the values
+            // before this one in the header run between the two.
+            if (effects.controlDependent && (block != loop.header() || exitsBeforeValue))
+                continue;
+
+            if (effects.reads.overlaps(data.writes))
+                continue;
+
+            return preHeader;
+        }
+
+        return nullptr;
+    }
+
+    Procedure& m_proc;
+    Vector<LoopData> m_data;
+};
+
+} // anonymous namespace
+
+bool hoistLoopInvariantValues(Procedure& proc)
+{
+    PhaseScope phaseScope(proc, "hoistLoopInvariantValues");
+    HoistLoopInvariantValues hoistLoopInvariantValues(proc);
+    return hoistLoopInvariantValues.run();
+}
+
+} } // namespace JSC::B3
+
+#endif // ENABLE(B3_JIT)
@@ -36,11 +36,14 @@
 #include "B3ArgumentRegValue.h"
 #include "B3BasicBlockInlines.h"
 #include "B3CCallValue.h"
+#include "B3CFG.h"
 #include "B3CheckSpecial.h"
 #include "B3Commutativity.h"
+#include "B3Dominators.h"
 #include "B3IndexMap.h"
 #include "B3IndexSet.h"
 #include "B3MemoryValue.h"
+#include "B3NaturalLoops.h"
 #include "B3PatchpointSpecial.h"
 #include "B3PatchpointValue.h"
 #include "B3PhaseScope.h"
@@ -74,6 +77,15 @@ public:
     {
         for (B3::BasicBlock* block : m_procedure)
             m_blockToBlock[block] = m_code.addBlock(block->frequency());
+
+        // Tell Air about loops, so that it can keep their bodies together.
+        {
+            CFG cfg(m_procedure);
+            Dominators dominators(cfg);
+            NaturalLoops loops(m_procedure, dominators);
+            for (B3::BasicBlock* block : m_procedure)
+                m_blockToBlock[block]->setLoopDepth(loops.loopDepth(block));
+        }
         for (Value* value : m_procedure.values()) {
             if (StackSlotValue* stackSlotValue = value->as<StackSlotValue>())
                 m_stackToStack.add(stackSlotValue, m_code.addStackSlot(stackSlotValue));
@@ -1289,6 +1301,35 @@ private:
         return result;
     }
 
+    // Lowers an integer Div or Mod. X86 division leaves the quotient in eax and the remainder in
+    // edx, so the caller picks which of the two is the result.
+    void lowerX86Div(X86Registers::RegisterID resultRegister)
+    {
+        Tmp eax = Tmp(X86Registers::eax);
+        Tmp edx = Tmp(X86Registers::edx);
+
+        Air::Opcode convertToDoubleWord;
+        Air::Opcode div;
+        switch (m_value->type()) {
+        case Int32:
+            convertToDoubleWord = X86ConvertToDoubleWord32;
+            div = X86Div32;
+            break;
+        case Int64:
+            convertToDoubleWord = X86ConvertToQuadWord64;
+            div = X86Div64;
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+            return;
+        }
+
+        append(Move, tmp(m_value->child(0)), eax);
+        append(convertToDoubleWord, eax, edx);
+        append(div, eax, edx, tmp(m_value->child(1)));
+        append(Move, Tmp(resultRegister), tmp(m_value));
+    }
+
     void lower()
     {
         switch (m_value->opcode()) {
@@ -1347,29 +1388,7 @@ private:
 
         case Div: {
             if (isInt(m_value->type())) {
-                Tmp eax = Tmp(X86Registers::eax);
-                Tmp edx = Tmp(X86Registers::edx);
-
-                Air::Opcode convertToDoubleWord;
-                Air::Opcode div;
-                switch (m_value->type()) {
-                case Int32:
-                    convertToDoubleWord = X86ConvertToDoubleWord32;
-                    div = X86Div32;
-                    break;
-                case Int64:
-                    convertToDoubleWord = X86ConvertToQuadWord64;
-                    div = X86Div64;
-                    break;
-                default:
-                    RELEASE_ASSERT_NOT_REACHED();
-                    return;
-                }
-                
-                append(Move, tmp(m_value->child(0)), eax);
-                append(convertToDoubleWord, eax, edx);
-                append(div, eax, edx, tmp(m_value->child(1)));
-                append(Move, eax, tmp(m_value));
+                lowerX86Div(X86Registers::eax);
                 return;
             }
             ASSERT(isFloat(m_value->type()));
@@ -1378,6 +1397,12 @@ private:
             return;
         }
 
+        case Mod: {
+            // The remainder of an x86 division lands in edx.
+            lowerX86Div(X86Registers::edx);
+            return;
+        }
+
         case BitAnd: {
             appendBinOp<And32, And64, Air::Oops, Commutative>(
                 m_value->child(0), m_value->child(1));
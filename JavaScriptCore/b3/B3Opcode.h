@@ -73,7 +73,7 @@ enum Opcode : int16_t {
 
     // Integer math.
     ChillDiv, // doesn't trap ever, behaves like JS (x/y)|0.
-    Mod,
+    Mod, // Like Div, this may trap for x%0.
     BitAnd,
     BitOr,
     BitXor,
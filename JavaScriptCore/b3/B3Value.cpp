@@ -318,7 +318,6 @@ Effects Value::effects() const
     case Sub:
     case Mul:
     case ChillDiv:
-    case Mod:
     case BitAnd:
     case BitOr:
     case BitXor:
@@ -347,6 +346,7 @@ Effects Value::effects() const
     case Select:
         break;
     case Div:
+    case Mod:
         result.controlDependent = true;
         break;
     case Load8Z:
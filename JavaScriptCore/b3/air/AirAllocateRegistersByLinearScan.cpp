@@ -0,0 +1,523 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "AirAllocateRegistersByLinearScan.h"
+
+#if ENABLE(B3_JIT)
+
+#include "AirCode.h"
+#include "AirInsertionSet.h"
+#include "AirInstInlines.h"
+#include "AirLiveness.h"
+#include "AirPhaseScope.h"
+#include "AirRegisterPriority.h"
+#include "B3IndexMap.h"
+#include "RegisterSet.h"
+#include <wtf/ListDump.h>
+
+namespace JSC { namespace B3 { namespace Air {
+
+namespace {
+
+const bool verbose = false;
+const bool reportStats = false;
+
+// Each instruction has two points. At the early point it reads its Use's. At the late point it writes
+// its Def's, reads its LateUse's and clobbers its extra clobbered registers. So a Tmp that dies at an
+// instruction may share a register with a Tmp that is born there.
+class Interval {
+public:
+    Interval()
+    {
+    }
+
+    Interval(unsigned begin, unsigned end)
+        : m_begin(begin)
+        , m_end(end)
+    {
+        ASSERT(begin <= end);
+    }
+
+    void add(unsigned point)
+    {
+        m_begin = std::min(m_begin, point);
+        m_end = std::max(m_end, point);
+    }
+
+    bool isEmpty() const { return m_begin > m_end; }
+
+    // Both ends are inclusive.
+    unsigned begin() const { return m_begin; }
+    unsigned end() const { return m_end; }
+
+    bool overlaps(const Interval& other) const
+    {
+        return m_begin <= other.m_end && other.m_begin <= m_end;
+    }
+
+    void dump(PrintStream& out) const
+    {
+        out.print("[", m_begin, ", ", m_end, "]");
+    }
+
+private:
+    unsigned m_begin { UINT_MAX };
+    unsigned m_end { 0 };
+};
+
+bool isUselessMove(const Inst& inst)
+{
+    return (inst.opcode == Move || inst.opcode == MoveDouble)
+        && inst.args.size() == 2
+        && inst.args[0].isTmp()
+        && inst.args[1].isTmp()
+        && inst.args[0].tmp() == inst.args[1].tmp();
+}
+
+class LinearScan {
+public:
+    LinearScan(Code& code)
+        : m_code(code)
+        , m_startPoint(code.size())
+    {
+        for (unsigned typeIndex = 0; typeIndex < Arg::numTypes; ++typeIndex) {
+            for (Reg reg : regsInPriorityOrder(static_cast<Arg::Type>(typeIndex)))
+                m_allocatableRegs.set(reg);
+        }
+    }
+
+    void run()
+    {
+        unsigned numIterations = 0;
+        for (;;) {
+            numIterations++;
+            buildIntervals();
+
+            bool spilled = false;
+            for (unsigned typeIndex = 0; typeIndex < Arg::numTypes; ++typeIndex)
+                spilled |= allocate(static_cast<Arg::Type>(typeIndex));
+            if (!spilled)
+                break;
+
+            addSpillAndFill();
+        }
+
+        assignRegisters();
+
+        if (reportStats)
+            dataLog("Num iterations = ", numIterations, "\n");
+    }
+
+private:
+    void buildIntervals()
+    {
+        unsigned point = 0;
+        for (BasicBlock* block : m_code) {
+            m_startPoint[block] = point;
+            point += block->size() * 2;
+        }
+
+        for (unsigned typeIndex = 0; typeIndex < Arg::numTypes; ++typeIndex) {
+            Arg::Type type = static_cast<Arg::Type>(typeIndex);
+            m_intervals[type].resize(0);
+            m_intervals[type].resize(m_code.numTmps(type));
+            m_hints[type].resize(0);
+            m_hints[type].resize(m_code.numTmps(type));
+        }
+
+        // Registers get precise live ranges, since they are often live for only a few instructions
+        // at a time, and they are often live in many disjoint places.
+        unsigned numRegs = Reg::last().index() + 1;
+        m_fixedRanges.resize(0);
+        m_fixedRanges.resize(numRegs);
+        Vector<unsigned> openRangeEnd(numRegs, UINT_MAX);
+        auto addFixedRange = [&] (Reg reg, unsigned begin, unsigned end) {
+            if (m_allocatableRegs.get(reg))
+                m_fixedRanges[reg.index()].append(Interval(begin, end));
+        };
+
+        Liveness<Tmp> liveness(m_code);
+        for (BasicBlock* block : m_code) {
+            unsigned blockStart = m_startPoint[block];
+            unsigned blockEnd = blockStart + block->size() * 2 - 1;
+
+            // Other Tmps only get their end points. Since they are live for the whole span between
+            // them, that's all we need.
+            for (Tmp tmp : liveness.liveAtTail(block)) {
+                if (tmp.isReg())
+                    openRangeEnd[tmp.reg().index()] = blockEnd;
+                else
+                    interval(tmp).add(blockEnd);
+            }
+            for (Tmp tmp : liveness.liveAtHead(block)) {
+                if (!tmp.isReg())
+                    interval(tmp).add(blockStart);
+            }
+
+            for (unsigned instIndex = block->size(); instIndex--;) {
+                Inst& inst = block->at(instIndex);
+                unsigned early = blockStart + instIndex * 2;
+                unsigned late = early + 1;
+
+                auto killReg = [&] (Reg reg) {
+                    unsigned& end = openRangeEnd[reg.index()];
+                    addFixedRange(reg, late, end == UINT_MAX ? late : end);
+                    end = UINT_MAX;
+                };
+
+                inst.forEachTmp(
+                    [&] (Tmp& tmp, Arg::Role role, Arg::Type) {
+                        if (tmp.isReg()) {
+                            if (Arg::isDef(role))
+                                killReg(tmp.reg());
+                            return;
+                        }
+                        if (Arg::isEarlyUse(role))
+                            interval(tmp).add(early);
+                        if (Arg::isDef(role) || Arg::isLateUse(role))
+                            interval(tmp).add(late);
+                    });
+
+                if (inst.hasSpecial())
+                    inst.extraClobberedRegs().forEach(killReg);
+
+                inst.forEachTmp(
+                    [&] (Tmp& tmp, Arg::Role role, Arg::Type) {
+                        if (!tmp.isReg())
+                            return;
+                        unsigned& end = openRangeEnd[tmp.reg().index()];
+                        if (end != UINT_MAX)
+                            return;
+                        if (Arg::isLateUse(role))
+                            end = late;
+                        else if (Arg::isEarlyUse(role))
+                            end = early;
+                    });
+
+                if (isMove(inst)) {
+                    Tmp from = inst.args[0].tmp();
+                    Tmp to = inst.args[1].tmp();
+                    addHint(from, to);
+                    addHint(to, from);
+                }
+            }
+
+            for (unsigned regIndex = 0; regIndex < numRegs; ++regIndex) {
+                unsigned& end = openRangeEnd[regIndex];
+                if (end == UINT_MAX)
+                    continue;
+                addFixedRange(Reg::fromIndex(regIndex), blockStart, end);
+                end = UINT_MAX;
+            }
+        }
+
+        // Make each register's ranges sorted and disjoint, so that we can binary search them.
+        for (Vector<Interval>& ranges : m_fixedRanges) {
+            if (ranges.isEmpty())
+                continue;
+            std::sort(
+                ranges.begin(), ranges.end(),
+                [] (const Interval& a, const Interval& b) {
+                    return a.begin() < b.begin();
+                });
+            unsigned targetIndex = 0;
+            for (unsigned sourceIndex = 1; sourceIndex < ranges.size(); ++sourceIndex) {
+                Interval& target = ranges[targetIndex];
+                const Interval& source = ranges[sourceIndex];
+                if (source.begin() <= target.end() + 1)
+                    target = Interval(target.begin(), std::max(target.end(), source.end()));
+                else
+                    ranges[++targetIndex] = source;
+            }
+            ranges.resize(targetIndex + 1);
+        }
+
+        if (verbose) {
+            for (unsigned typeIndex = 0; typeIndex < Arg::numTypes; ++typeIndex) {
+                Arg::Type type = static_cast<Arg::Type>(typeIndex);
+                for (unsigned tmpIndex = 0; tmpIndex < m_intervals[type].size(); ++tmpIndex) {
+                    if (!m_intervals[type][tmpIndex].isEmpty())
+                        dataLog(tmpForIndex(type, tmpIndex), ": ", m_intervals[type][tmpIndex], "\n");
+                }
+            }
+            for (unsigned regIndex = 0; regIndex < numRegs; ++regIndex) {
+                if (!m_fixedRanges[regIndex].isEmpty())
+                    dataLog(Reg::fromIndex(regIndex), ": ", listDump(m_fixedRanges[regIndex]), "\n");
+            }
+        }
+    }
+
+    // Returns true if anything got spilled.
+    bool allocate(Arg::Type type)
+    {
+        const Vector<Interval>& intervals = m_intervals[type];
+        Vector<Reg>& assignments = m_assignments[type];
+        assignments.resize(0);
+        assignments.resize(intervals.size());
+        m_spilledTmps[type].resize(0);
+
+        Vector<unsigned> order;
+        for (unsigned tmpIndex = 0; tmpIndex < intervals.size(); ++tmpIndex) {
+            if (!intervals[tmpIndex].isEmpty())
+                order.append(tmpIndex);
+        }
+        std::sort(
+            order.begin(), order.end(),
+            [&] (unsigned a, unsigned b) {
+                if (intervals[a].begin() != intervals[b].begin())
+                    return intervals[a].begin() < intervals[b].begin();
+                return a < b;
+            });
+
+        // The active list is bounded by the number of registers, so it's cheap to just scan it.
+        Vector<unsigned> active;
+        RegisterSet activeRegs;
+
+        for (unsigned tmpIndex : order) {
+            const Interval& interval = intervals[tmpIndex];
+
+            active.removeAllMatching(
+                [&] (unsigned activeIndex) -> bool {
+                    if (intervals[activeIndex].end() >= interval.begin())
+                        return false;
+                    activeRegs.clear(assignments[activeIndex]);
+                    return true;
+                });
+
+            auto isFree = [&] (Reg reg) -> bool {
+                return reg
+                    && m_allocatableRegs.get(reg)
+                    && reg.isGPR() == (type == Arg::GP)
+                    && !activeRegs.get(reg)
+                    && isFixedFree(reg, interval);
+            };
+
+            Reg reg;
+
+            // Prefer the register of the other side of a Move, so that the Move goes away.
+            if (Tmp hint = m_hints[type][tmpIndex]) {
+                Reg hintReg = hint.isReg() ? hint.reg() : assignments[hint.tmpIndex()];
+                if (isFree(hintReg))
+                    reg = hintReg;
+            }
+
+            if (!reg) {
+                for (Reg candidate : regsInPriorityOrder(type)) {
+                    if (isFree(candidate)) {
+                        reg = candidate;
+                        break;
+                    }
+                }
+            }
+
+            if (!reg) {
+                // Spill whichever of this Tmp and the active ones lives the longest, so long as
+                // that frees up a register that we can use for the rest of this Tmp's life.
+                bool spillCurrent = !isUnspillable(type, tmpIndex);
+                unsigned victimEnd = spillCurrent ? interval.end() : 0;
+                unsigned victimActiveIndex = UINT_MAX;
+                for (unsigned i = 0; i < active.size(); ++i) {
+                    unsigned activeTmpIndex = active[i];
+                    if (isUnspillable(type, activeTmpIndex))
+                        continue;
+                    if (victimActiveIndex != UINT_MAX || spillCurrent) {
+                        if (intervals[activeTmpIndex].end() <= victimEnd)
+                            continue;
+                    }
+                    if (!isFixedFree(assignments[activeTmpIndex], interval))
+                        continue;
+                    victimActiveIndex = i;
+                    victimEnd = intervals[activeTmpIndex].end();
+                }
+
+                if (victimActiveIndex == UINT_MAX) {
+                    RELEASE_ASSERT(spillCurrent);
+                    m_spilledTmps[type].append(tmpForIndex(type, tmpIndex));
+                    continue;
+                }
+
+                unsigned victimTmpIndex = active[victimActiveIndex];
+                reg = assignments[victimTmpIndex];
+                assignments[victimTmpIndex] = Reg();
+                active.remove(victimActiveIndex);
+                activeRegs.clear(reg);
+                m_spilledTmps[type].append(tmpForIndex(type, victimTmpIndex));
+            }
+
+            if (verbose)
+                dataLog("Assigning ", reg, " to ", tmpForIndex(type, tmpIndex), "\n");
+
+            assignments[tmpIndex] = reg;
+            active.append(tmpIndex);
+            activeRegs.set(reg);
+        }
+
+        return !m_spilledTmps[type].isEmpty();
+    }
+
+    void addSpillAndFill()
+    {
+        HashMap<Tmp, StackSlot*> stackSlots;
+        for (unsigned typeIndex = 0; typeIndex < Arg::numTypes; ++typeIndex) {
+            for (Tmp tmp : m_spilledTmps[typeIndex]) {
+                if (verbose)
+                    dataLog("Spilling ", tmp, "\n");
+
+                bool isNewTmp = stackSlots.add(tmp, m_code.addStackSlot(8, StackSlotKind::Anonymous)).isNewEntry;
+                ASSERT_UNUSED(isNewTmp, isNewTmp);
+            }
+        }
+
+        InsertionSet insertionSet(m_code);
+        for (BasicBlock* block : m_code) {
+            for (unsigned instIndex = 0; instIndex < block->size(); ++instIndex) {
+                Inst& inst = block->at(instIndex);
+
+                // Try to replace the register use by memory use when possible.
+                for (unsigned i = 0; i < inst.args.size(); ++i) {
+                    Arg& arg = inst.args[i];
+                    if (arg.isTmp() && !arg.isReg()) {
+                        auto stackSlotEntry = stackSlots.find(arg.tmp());
+                        if (stackSlotEntry != stackSlots.end() && inst.admitsStack(i))
+                            arg = Arg::stack(stackSlotEntry->value);
+                    }
+                }
+
+                // For every other case, add Load/Store as needed. Every Use and every Def gets a
+                // fresh Tmp that only lives for this instruction, so the spilled Tmp disappears
+                // from the code and we never need to spill these.
+                inst.forEachTmp(
+                    [&] (Tmp& tmp, Arg::Role role, Arg::Type type) {
+                        if (tmp.isReg())
+                            return;
+
+                        auto stackSlotEntry = stackSlots.find(tmp);
+                        if (stackSlotEntry == stackSlots.end())
+                            return;
+
+                        Arg arg = Arg::stack(stackSlotEntry->value);
+                        Opcode move = type == Arg::GP ? Move : MoveDouble;
+
+                        Tmp newTmp = m_code.newTmp(type);
+                        m_unspillableTmps.add(newTmp);
+                        if (Arg::isAnyUse(role))
+                            insertionSet.insert(instIndex, move, inst.origin, arg, newTmp);
+                        if (Arg::isDef(role))
+                            insertionSet.insert(instIndex + 1, move, inst.origin, newTmp, arg);
+                        tmp = newTmp;
+                    });
+            }
+            insertionSet.execute(block);
+        }
+    }
+
+    void assignRegisters()
+    {
+        for (BasicBlock* block : m_code) {
+            for (Inst& inst : *block) {
+                inst.forEachTmpFast(
+                    [&] (Tmp& tmp) {
+                        if (tmp.isReg())
+                            return;
+                        Reg reg = m_assignments[tmp.isGP() ? Arg::GP : Arg::FP][tmp.tmpIndex()];
+                        ASSERT(reg);
+                        tmp = Tmp(reg);
+                    });
+            }
+
+            // Remove all the moves that the hints turned into no-ops.
+            block->insts().removeAllMatching(isUselessMove);
+        }
+    }
+
+    bool isFixedFree(Reg reg, const Interval& interval) const
+    {
+        // The ranges are sorted and disjoint, so their ends are sorted, too.
+        const Vector<Interval>& ranges = m_fixedRanges[reg.index()];
+        auto iter = std::lower_bound(
+            ranges.begin(), ranges.end(), interval.begin(),
+            [] (const Interval& range, unsigned point) {
+                return range.end() < point;
+            });
+        return iter == ranges.end() || iter->begin() > interval.end();
+    }
+
+    static bool isMove(const Inst& inst)
+    {
+        return (inst.opcode == Move || inst.opcode == MoveDouble)
+            && inst.args.size() == 2
+            && inst.args[0].isTmp()
+            && inst.args[1].isTmp();
+    }
+
+    void addHint(Tmp tmp, Tmp hint)
+    {
+        if (tmp.isReg())
+            return;
+        Tmp& entry = m_hints[tmp.isGP() ? Arg::GP : Arg::FP][tmp.tmpIndex()];
+        if (!entry)
+            entry = hint;
+    }
+
+    Interval& interval(Tmp tmp)
+    {
+        ASSERT(!tmp.isReg());
+        return m_intervals[tmp.isGP() ? Arg::GP : Arg::FP][tmp.tmpIndex()];
+    }
+
+    static Tmp tmpForIndex(Arg::Type type, unsigned tmpIndex)
+    {
+        return type == Arg::GP ? Tmp::gpTmpForIndex(tmpIndex) : Tmp::fpTmpForIndex(tmpIndex);
+    }
+
+    bool isUnspillable(Arg::Type type, unsigned tmpIndex) const
+    {
+        return m_unspillableTmps.contains(tmpForIndex(type, tmpIndex));
+    }
+
+    Code& m_code;
+    RegisterSet m_allocatableRegs;
+    IndexMap<BasicBlock, unsigned> m_startPoint;
+    Vector<Interval> m_intervals[Arg::numTypes];
+    Vector<Tmp> m_hints[Arg::numTypes];
+    Vector<Reg> m_assignments[Arg::numTypes];
+    Vector<Tmp> m_spilledTmps[Arg::numTypes];
+    Vector<Vector<Interval>> m_fixedRanges;
+    HashSet<Tmp> m_unspillableTmps;
+};
+
+} // anonymous namespace
+
+void allocateRegistersByLinearScan(Code& code)
+{
+    PhaseScope phaseScope(code, "allocateRegistersByLinearScan");
+    LinearScan linearScan(code);
+    linearScan.run();
+}
+
+} } } // namespace JSC::B3::Air
+
+#endif // ENABLE(B3_JIT)
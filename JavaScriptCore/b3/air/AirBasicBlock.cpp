@@ -57,7 +57,10 @@ void BasicBlock::dump(PrintStream& out) const
 
 void BasicBlock::deepDump(PrintStream& out) const
 {
-    out.print("BB", *this, ": ; frequency = ", m_frequency, "\n");
+    out.print("BB", *this, ": ; frequency = ", m_frequency);
+    if (m_loopDepth)
+        out.print(", loop depth = ", m_loopDepth);
+    out.print("\n");
     if (predecessors().size())
         out.print("  Predecessors: ", pointerListDump(predecessors()), "\n");
     for (const Inst& inst : *this)
@@ -116,6 +116,11 @@ public:
 
     double frequency() const { return m_frequency; }
 
+    // This is how deeply nested in loops the B3 block that this came from was. It's zero for blocks
+    // that don't come from B3 blocks.
+    unsigned loopDepth() const { return m_loopDepth; }
+    void setLoopDepth(unsigned loopDepth) { m_loopDepth = loopDepth; }
+
     void dump(PrintStream&) const;
     void deepDump(PrintStream&) const;
 
@@ -130,6 +135,7 @@ private:
     SuccessorList m_successors;
     PredecessorList m_predecessors;
     double m_frequency;
+    unsigned m_loopDepth { 0 };
 };
 
 class DeepBasicBlockDump {
@@ -28,6 +28,7 @@
 
 #if ENABLE(B3_JIT)
 
+#include "AirAllocateRegistersByLinearScan.h"
 #include "AirAllocateStack.h"
 #include "AirCode.h"
 #include "AirEliminateDeadCode.h"
@@ -43,10 +44,11 @@
 #include "B3IndexMap.h"
 #include "B3TimingScope.h"
 #include "CCallHelpers.h"
+#include "Options.h"
 
 namespace JSC { namespace B3 { namespace Air {
 
-void prepareForGeneration(Code& code)
+void prepareForGeneration(Code& code, unsigned optLevel)
 {
     TimingScope timingScope("Air::prepareForGeneration");
     
@@ -71,9 +73,15 @@ void prepareForGeneration(Code& code)
     // Register allocation for all the Tmps that do not have a corresponding machine register.
     // After this phase, every Tmp has a reg.
     //
+    // Graph coloring gives the best code, but it's superlinear, so we use linear scan when we want
+    // to compile quickly or when the code is so big that graph coloring would take forever.
+    //
     // For debugging, you can use spillEverything() to put everything to the stack between each Inst.
     if (false)
         spillEverything(code);
+    else if (!optLevel
+        || code.numTmps(Arg::GP) + code.numTmps(Arg::FP) > Options::maximumTmpsForAirGraphColoring())
+        allocateRegistersByLinearScan(code);
     else
         iteratedRegisterCoalescing(code);
 
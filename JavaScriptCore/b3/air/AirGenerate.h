@@ -37,8 +37,9 @@ namespace B3 { namespace Air {
 class Code;
 
 // This takes an Air::Code that hasn't had any stack allocation and optionally hasn't had any
-// register allocation and does both of those things.
-void prepareForGeneration(Code&);
+// register allocation and does both of those things. At optLevel 0 it favors compile time over
+// code quality.
+void prepareForGeneration(Code&, unsigned optLevel = 1);
 
 // This generates the code using the given CCallHelpers instance. Note that this may call callbacks
 // in the supplied code as it is generating.
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "AirHelperPool.h"
+
+#if ENABLE(B3_JIT)
+
+#include "AirCode.h"
+#include "Options.h"
+#include <mutex>
+
+namespace JSC { namespace B3 { namespace Air {
+
+ParallelHelperPool& airHelperPool()
+{
+    static std::once_flag initializeHelperPoolOnceFlag;
+    static ParallelHelperPool* helperPool;
+    std::call_once(
+        initializeHelperPoolOnceFlag,
+        [] {
+            helperPool = new ParallelHelperPool();
+            helperPool->ensureThreads(Options::numberOfAirHelperThreads());
+        });
+    return *helperPool;
+}
+
+Vector<BlockRange> partitionBlocksForParallelism(Code& code)
+{
+    Vector<BlockRange> result;
+
+    unsigned numInsts = 0;
+    if (Options::useParallelAirRegisterAllocation()) {
+        for (BasicBlock* block : code)
+            numInsts += block->size();
+    }
+
+    if (!Options::useParallelAirRegisterAllocation()
+        || numInsts < Options::minimumInstsForParallelAirRegisterAllocation()
+        || !Options::numberOfAirHelperThreads()) {
+        result.append({ 0, code.size() });
+        return result;
+    }
+
+    // Ask for a few ranges per thread, so that a thread that got a cheap range can pick up another
+    // one while the others are busy.
+    unsigned numRanges = std::min(code.size(), (airHelperPool().numberOfThreads() + 1) * 4);
+    unsigned instsPerRange = (numInsts + numRanges - 1) / numRanges;
+
+    unsigned begin = 0;
+    unsigned instsInRange = 0;
+    for (unsigned blockIndex = 0; blockIndex < code.size(); ++blockIndex) {
+        if (BasicBlock* block = code.at(blockIndex))
+            instsInRange += block->size();
+        if (instsInRange >= instsPerRange) {
+            result.append({ begin, blockIndex + 1 });
+            begin = blockIndex + 1;
+            instsInRange = 0;
+        }
+    }
+    if (begin < code.size())
+        result.append({ begin, code.size() });
+
+    return result;
+}
+
+} } } // namespace JSC::B3::Air
+
+#endif // ENABLE(B3_JIT)
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef AirHelperPool_h
+#define AirHelperPool_h
+
+#if ENABLE(B3_JIT)
+
+#include <atomic>
+#include <wtf/ParallelHelperPool.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace B3 { namespace Air {
+
+class Code;
+
+ParallelHelperPool& airHelperPool();
+
+// A run of consecutive indices into the block list of a Code, not including end.
+struct BlockRange {
+    unsigned begin;
+    unsigned end;
+};
+
+// Splits the blocks of the code into runs that have roughly the same number of instructions, so
+// that a phase can process them on the helper threads. Code that is too small to be worth it, or
+// any code if useParallelAirRegisterAllocation is false, gets a single range with all of its
+// blocks.
+Vector<BlockRange> partitionBlocksForParallelism(Code&);
+
+// Calls functor(rangeIndex) once for every index below numRanges, on the helper threads as well as
+// on this one, and returns once all of the calls are done. The calls can come in any order and on
+// any thread, so anything that depends on the order has to merge the per-range results afterwards.
+template<typename Functor>
+void forEachRangeInParallel(unsigned numRanges, const Functor& functor)
+{
+    if (numRanges <= 1) {
+        if (numRanges)
+            functor(0);
+        return;
+    }
+
+    std::atomic<unsigned> nextRange { 0 };
+    ParallelHelperClient client(&airHelperPool());
+    client.runFunctionInParallel(
+        [&] () {
+            for (;;) {
+                unsigned index = nextRange++;
+                if (index >= numRanges)
+                    return;
+                functor(index);
+            }
+        });
+}
+
+} } } // namespace JSC::B3::Air
+
+#endif // ENABLE(B3_JIT)
+
+#endif // AirHelperPool_h
@@ -29,6 +29,7 @@
 #if ENABLE(B3_JIT)
 
 #include "AirCode.h"
+#include "AirHelperPool.h"
 #include "AirInsertionSet.h"
 #include "AirInstInlines.h"
 #include "AirLiveness.h"
@@ -145,7 +146,13 @@ public:
         m_isOnSelectStack.ensureSize(tmpArraySize);
     }
 
-    void build(Inst& inst, const Liveness<Tmp>::LocalCalc& localCalc)
+    class InterferenceLog;
+
+    // Adds the interference edges and coalescing candidates of the instruction to the recorder,
+    // which is either the allocator itself or an InterferenceLog that gets replayed into it later.
+    // This only reads the code, so it is safe to run on several blocks at once.
+    template<typename Recorder>
+    static void build(Inst& inst, const HashSet<Tmp>& live, Recorder& recorder)
     {
         inst.forEachDefAndExtraClobberedTmp(type, [&] (Tmp& arg) {
             // All the Def()s interfere with each other and with all the extra clobbered Tmps.
@@ -156,7 +163,7 @@ public:
                     return;
 
                 if (Arg::isDef(role))
-                    addEdge(arg, otherArg);
+                    recorder.addEdge(arg, otherArg);
             });
         });
 
@@ -176,29 +183,28 @@ public:
             });
             ASSERT(defTmp);
             ASSERT(useTmp);
+            ASSERT(inst.args[0].tmp() == useTmp);
+            ASSERT(inst.args[1].tmp() == defTmp);
 
-            unsigned nextMoveIndex = m_coalescingCandidates.size();
-            m_coalescingCandidates.append({ useTmp, defTmp });
-
-            unsigned newIndexInWorklist = m_worklistMoves.addMove();
-            ASSERT_UNUSED(newIndexInWorklist, newIndexInWorklist == nextMoveIndex);
-
-            ASSERT(nextMoveIndex <= m_activeMoves.size());
-            m_activeMoves.ensureSize(nextMoveIndex + 1);
-
-            for (const Arg& arg : inst.args) {
-                auto& list = m_moveList[AbsoluteTmpHelper<type>::absoluteIndex(arg.tmp())];
-                list.add(nextMoveIndex);
-            }
+            recorder.addMove(useTmp, defTmp);
 
-            for (const Tmp& liveTmp : localCalc.live()) {
+            for (const Tmp& liveTmp : live) {
                 if (liveTmp != useTmp && liveTmp.isGP() == (type == Arg::GP))
-                    addEdge(defTmp, liveTmp);
+                    recorder.addEdge(defTmp, liveTmp);
             }
-        } else
-            addEdges(inst, localCalc.live());
+        } else {
+            // All the Def()s interfere with everthing live.
+            inst.forEachDefAndExtraClobberedTmp(type, [&] (Tmp& arg) {
+                for (const Tmp& liveTmp : live) {
+                    if (liveTmp.isGP() == (type == Arg::GP))
+                        recorder.addEdge(arg, liveTmp);
+                }
+            });
+        }
     }
 
+    void replay(const InterferenceLog&);
+
     void allocate()
     {
         ASSERT_WITH_MESSAGE(m_activeMoves.size() >= m_coalescingCandidates.size(), "The activeMove set should be big enough for the quick operations of BitVector.");
@@ -296,17 +302,6 @@ private:
         bzero(m_degrees.data() + firstNonRegIndex, (tmpArraySize - firstNonRegIndex) * sizeof(unsigned));
     }
 
-    void addEdges(Inst& inst, const HashSet<Tmp>& liveTmp)
-    {
-        // All the Def()s interfere with everthing live.
-        inst.forEachDefAndExtraClobberedTmp(type, [&] (Tmp& arg) {
-            for (const Tmp& liveTmp : liveTmp) {
-                if (liveTmp.isGP() == (type == Arg::GP))
-                    addEdge(arg, liveTmp);
-            }
-        });
-    }
-
     void addEdge(const Tmp& a, const Tmp& b)
     {
         if (a == b)
@@ -327,6 +322,21 @@ private:
         }
     }
 
+    void addMove(const Tmp& useTmp, const Tmp& defTmp)
+    {
+        unsigned nextMoveIndex = m_coalescingCandidates.size();
+        m_coalescingCandidates.append({ useTmp, defTmp });
+
+        unsigned newIndexInWorklist = m_worklistMoves.addMove();
+        ASSERT_UNUSED(newIndexInWorklist, newIndexInWorklist == nextMoveIndex);
+
+        ASSERT(nextMoveIndex <= m_activeMoves.size());
+        m_activeMoves.ensureSize(nextMoveIndex + 1);
+
+        m_moveList[AbsoluteTmpHelper<type>::absoluteIndex(useTmp)].add(nextMoveIndex);
+        m_moveList[AbsoluteTmpHelper<type>::absoluteIndex(defTmp)].add(nextMoveIndex);
+    }
+
     void makeWorkList()
     {
         unsigned firstNonRegIndex = AbsoluteTmpHelper<type>::absoluteIndex(0);
@@ -909,6 +919,118 @@ private:
     Vector<Tmp, 0, UnsafeVectorOverflow> m_coalescedTmpsAtSpill;
 };
 
+// Records what build() would have done to the allocator, so that a helper thread can build the part
+// of the interference graph that comes from a range of blocks without touching the allocator.
+template<Arg::Type type>
+class IteratedRegisterCoalescingAllocator<type>::InterferenceLog {
+public:
+    struct Entry {
+        Tmp first;
+        Tmp second;
+        bool isMove;
+    };
+
+    void addEdge(const Tmp& a, const Tmp& b)
+    {
+        // The allocator ignores edges it has already seen, so dropping repeats here only makes the
+        // log smaller.
+        if (a == b)
+            return;
+        if (m_edges.add(InterferenceEdge(a, b)).isNewEntry)
+            m_entries.append({ a, b, false });
+    }
+
+    void addMove(const Tmp& useTmp, const Tmp& defTmp)
+    {
+        m_entries.append({ useTmp, defTmp, true });
+    }
+
+    const Vector<Entry>& entries() const { return m_entries; }
+
+private:
+    HashSet<InterferenceEdge, InterferenceEdgeHash, InterferenceEdgeHashTraits> m_edges;
+    Vector<Entry> m_entries;
+};
+
+template<Arg::Type type>
+void IteratedRegisterCoalescingAllocator<type>::replay(const InterferenceLog& log)
+{
+    for (const typename InterferenceLog::Entry& entry : log.entries()) {
+        if (entry.isMove)
+            addMove(entry.first, entry.second);
+        else
+            addEdge(entry.first, entry.second);
+    }
+}
+
+template<typename GPRecorder, typename FPRecorder>
+static void buildBlock(Liveness<Tmp>& liveness, BasicBlock* block, GPRecorder* gpRecorder, FPRecorder* fpRecorder)
+{
+    Liveness<Tmp>::LocalCalc localCalc(liveness, block);
+    for (unsigned instIndex = block->size(); instIndex--;) {
+        Inst& inst = block->at(instIndex);
+
+        if (gpRecorder)
+            IteratedRegisterCoalescingAllocator<Arg::GP>::build(inst, localCalc.live(), *gpRecorder);
+        if (fpRecorder)
+            IteratedRegisterCoalescingAllocator<Arg::FP>::build(inst, localCalc.live(), *fpRecorder);
+
+        localCalc.execute(instIndex);
+    }
+}
+
+// Builds the interference graphs of the allocators that are not null from one liveness computation.
+// For big code, each range of blocks gets built into its own logs on the helper threads, and then we
+// replay the logs in block order. That gives the allocators the same edges and moves in the same
+// order as building everything on this thread would, so the allocation doesn't depend on the number
+// of threads.
+static void buildInterferenceGraphs(Code& code, IteratedRegisterCoalescingAllocator<Arg::GP>* gpAllocator, IteratedRegisterCoalescingAllocator<Arg::FP>* fpAllocator)
+{
+    typedef IteratedRegisterCoalescingAllocator<Arg::GP>::InterferenceLog GPLog;
+    typedef IteratedRegisterCoalescingAllocator<Arg::FP>::InterferenceLog FPLog;
+
+    // Liveness Analysis can be prohibitively expensive. It is shared
+    // between the two allocators to avoid doing it twice.
+    Liveness<Tmp> liveness(code);
+
+    Vector<BlockRange> ranges = partitionBlocksForParallelism(code);
+    if (ranges.size() == 1) {
+        for (BasicBlock* block : code)
+            buildBlock(liveness, block, gpAllocator, fpAllocator);
+        return;
+    }
+
+    Vector<GPLog> gpLogs(ranges.size());
+    Vector<FPLog> fpLogs(ranges.size());
+    forEachRangeInParallel(
+        ranges.size(),
+        [&] (unsigned rangeIndex) {
+            GPLog* gpLog = gpAllocator ? &gpLogs[rangeIndex] : nullptr;
+            FPLog* fpLog = fpAllocator ? &fpLogs[rangeIndex] : nullptr;
+            for (unsigned blockIndex = ranges[rangeIndex].begin; blockIndex < ranges[rangeIndex].end; ++blockIndex) {
+                if (BasicBlock* block = code.at(blockIndex))
+                    buildBlock(liveness, block, gpLog, fpLog);
+            }
+        });
+
+    for (unsigned rangeIndex = 0; rangeIndex < ranges.size(); ++rangeIndex) {
+        if (gpAllocator)
+            gpAllocator->replay(gpLogs[rangeIndex]);
+        if (fpAllocator)
+            fpAllocator->replay(fpLogs[rangeIndex]);
+    }
+}
+
+static void buildInterferenceGraph(Code& code, IteratedRegisterCoalescingAllocator<Arg::GP>& allocator)
+{
+    buildInterferenceGraphs(code, &allocator, nullptr);
+}
+
+static void buildInterferenceGraph(Code& code, IteratedRegisterCoalescingAllocator<Arg::FP>& allocator)
+{
+    buildInterferenceGraphs(code, nullptr, &allocator);
+}
+
 template<Arg::Type type>
 static bool isUselessMoveInst(const Inst& inst)
 {
@@ -1021,15 +1143,7 @@ static void iteratedRegisterCoalescingOnType(Code& code, HashSet<Tmp>& unspillab
     while (true) {
         numIterations++;
         IteratedRegisterCoalescingAllocator<type> allocator(code, unspillableTmps);
-        Liveness<Tmp> liveness(code);
-        for (BasicBlock* block : code) {
-            Liveness<Tmp>::LocalCalc localCalc(liveness, block);
-            for (unsigned instIndex = block->size(); instIndex--;) {
-                Inst& inst = block->at(instIndex);
-                allocator.build(inst, localCalc);
-                localCalc.execute(instIndex);
-            }
-        }
+        buildInterferenceGraph(code, allocator);
 
         allocator.allocate();
         if (allocator.spilledTmp().isEmpty()) {
@@ -1057,20 +1171,7 @@ void iteratedRegisterCoalescing(Code& code)
         IteratedRegisterCoalescingAllocator<Arg::GP> gpAllocator(code, unspillableGPs);
         IteratedRegisterCoalescingAllocator<Arg::FP> fpAllocator(code, unspillableFPs);
 
-        // Liveness Analysis can be prohibitively expensive. It is shared
-        // between the two allocators to avoid doing it twice.
-        Liveness<Tmp> liveness(code);
-        for (BasicBlock* block : code) {
-            Liveness<Tmp>::LocalCalc localCalc(liveness, block);
-            for (unsigned instIndex = block->size(); instIndex--;) {
-                Inst& inst = block->at(instIndex);
-
-                gpAllocator.build(inst, localCalc);
-                fpAllocator.build(inst, localCalc);
-
-                localCalc.execute(instIndex);
-            }
-        }
+        buildInterferenceGraphs(code, &gpAllocator, &fpAllocator);
 
         gpAllocator.allocate();
         fpAllocator.allocate();
@@ -29,6 +29,7 @@
 #if ENABLE(B3_JIT)
 
 #include "AirBasicBlock.h"
+#include "AirHelperPool.h"
 #include "B3IndexMap.h"
 #include "B3IndexSet.h"
 
@@ -49,15 +50,22 @@ public:
         m_liveAtHead.resize(code.size());
         m_liveAtTail.resize(code.size());
 
-        // The liveAtTail of each block automatically contains the LateUse's of the terminal.
-        for (BasicBlock* block : code) {
-            HashSet<Thing>& live = m_liveAtTail[block];
-            block->last().forEach<Thing>(
-                [&] (Thing& thing, Arg::Role role, Arg::Type) {
-                    if (Arg::isLateUse(role))
-                        live.add(thing);
-                });
-        }
+        // Summarize each block as the set of things it uses before defining them and the set of
+        // things it defines, so that the fixpoint below doesn't have to walk instructions. Blocks
+        // don't depend on each other here, so big code does this on the helper threads. Each block's
+        // sets are built the same way no matter which thread gets it, so the result doesn't depend
+        // on how the blocks were split up.
+        IndexMap<BasicBlock, HashSet<Thing>> gen(code.size());
+        IndexMap<BasicBlock, HashSet<Thing>> kill(code.size());
+        Vector<BlockRange> ranges = partitionBlocksForParallelism(code);
+        forEachRangeInParallel(
+            ranges.size(),
+            [&] (unsigned rangeIndex) {
+                for (unsigned blockIndex = ranges[rangeIndex].begin; blockIndex < ranges[rangeIndex].end; ++blockIndex) {
+                    if (BasicBlock* block = code.at(blockIndex))
+                        computeLocalSets(block, gen[block], kill[block], m_liveAtTail[block]);
+                }
+            });
 
         IndexSet<BasicBlock> seen;
 
@@ -69,18 +77,18 @@ public:
                 BasicBlock* block = code.at(blockIndex);
                 if (!block)
                     continue;
-                LocalCalc localCalc(*this, block);
-                for (size_t instIndex = block->size(); instIndex--;)
-                    localCalc.execute(instIndex);
+                HashSet<Thing> live = gen[block];
+                for (const Thing& thing : m_liveAtTail[block]) {
+                    if (!kill[block].contains(thing))
+                        live.add(thing);
+                }
                 bool firstTime = seen.add(block);
-                if (!firstTime && localCalc.live() == m_liveAtHead[block])
+                if (!firstTime && live == m_liveAtHead[block])
                     continue;
                 changed = true;
-                for (BasicBlock* predecessor : block->predecessors()) {
-                    m_liveAtTail[predecessor].add(
-                        localCalc.live().begin(), localCalc.live().end());
-                }
-                m_liveAtHead[block] = localCalc.takeLive();
+                for (BasicBlock* predecessor : block->predecessors())
+                    m_liveAtTail[predecessor].add(live.begin(), live.end());
+                m_liveAtHead[block] = WTF::move(live);
             }
         }
     }
@@ -149,6 +157,50 @@ public:
     };
 
 private:
+    // Walks the block backwards the same way LocalCalc does, but instead of tracking what is live it
+    // tracks what is live at the head regardless of the tail (gen) and what the block defines
+    // (kill). Also seeds the tail with the LateUse's of the terminal, which are always live there.
+    static void computeLocalSets(BasicBlock* block, HashSet<Thing>& gen, HashSet<Thing>& kill, HashSet<Thing>& liveAtTail)
+    {
+        block->last().forEach<Thing>(
+            [&] (Thing& thing, Arg::Role role, Arg::Type) {
+                if (Arg::isLateUse(role))
+                    liveAtTail.add(thing);
+            });
+
+        for (unsigned instIndex = block->size(); instIndex--;) {
+            Inst& inst = block->at(instIndex);
+
+            inst.forEach<Thing>(
+                [&] (Thing& arg, Arg::Role role, Arg::Type) {
+                    if (!isAlive(arg))
+                        return;
+                    if (Arg::isDef(role)) {
+                        gen.remove(arg);
+                        kill.add(arg);
+                    }
+                });
+
+            inst.forEach<Thing>(
+                [&] (Thing& arg, Arg::Role role, Arg::Type) {
+                    if (!isAlive(arg))
+                        return;
+                    if (Arg::isEarlyUse(role))
+                        gen.add(arg);
+                });
+
+            if (instIndex) {
+                block->at(instIndex - 1).forEach<Thing>(
+                    [&] (Thing& arg, Arg::Role role, Arg::Type) {
+                        if (!Arg::isLateUse(role))
+                            return;
+                        if (isAlive(arg))
+                            gen.add(arg);
+                    });
+            }
+        }
+    }
+
     IndexMap<BasicBlock, HashSet<Thing>> m_liveAtHead;
     IndexMap<BasicBlock, HashSet<Thing>> m_liveAtTail;
 };
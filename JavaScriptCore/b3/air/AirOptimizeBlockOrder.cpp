@@ -38,6 +38,21 @@ namespace JSC { namespace B3 { namespace Air {
 
 namespace {
 
+// Frequencies within this factor of each other don't tell the successors apart well enough to
+// overrule their loop depths.
+const double similarFrequencyRatio = 2;
+
+bool haveSimilarFrequencies(BasicBlock* left, BasicBlock* right)
+{
+    double low = std::min(left->frequency(), right->frequency());
+    double high = std::max(left->frequency(), right->frequency());
+    // Loop depth says nothing useful about blocks that we don't expect to run. This is also false
+    // for NaN.
+    if (!(low > 0))
+        return false;
+    return high <= low * similarFrequencyRatio;
+}
+
 class SortedSuccessors {
 public:
     SortedSuccessors()
@@ -56,11 +71,15 @@ public:
         bubbleSort(
             m_successors.begin(), m_successors.end(),
             [] (BasicBlock* left, BasicBlock* right) {
+                if (left->loopDepth() != right->loopDepth() && haveSimilarFrequencies(left, right))
+                    return left->loopDepth() < right->loopDepth();
                 return left->frequency() < right->frequency();
             });
 
-        // Pushing the successors in ascending order of frequency ensures that the very next block we visit
-        // is our highest-frequency successor (unless that successor has already been visited).
+        // Pushing the successors in ascending order of frequency ensures that the very next block we
+        // visit is our highest frequency successor (unless that successor has already been visited).
+        // Between successors of similar frequency, we visit the most deeply nested one first, so that
+        // we lay out the rest of a loop's body before we lay out its exits.
         for (unsigned i = 0; i < m_successors.size(); ++i)
             worklist.push(m_successors[i]);
         
@@ -32,6 +32,8 @@
 #include "B3Const32Value.h"
 #include "B3ConstPtrValue.h"
 #include "B3ControlValue.h"
+#include "B3EliminateCommonSubexpressions.h"
+#include "B3HoistLoopInvariantValues.h"
 #include "B3MemoryValue.h"
 #include "B3Procedure.h"
 #include "B3StackSlotValue.h"
@@ -2628,6 +2630,206 @@ void testSpillFP()
     compileAndRun<double>(proc, 1.1, 2.5);
 }
 
+void testSpillGPAtOptLevel(unsigned optLevel)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    Vector<Value*> sources;
+    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
+    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+
+    Vector<int64_t> expectedSources;
+    expectedSources.append(1);
+    expectedSources.append(2);
+
+    for (unsigned i = 0; i < 30; ++i) {
+        sources.append(
+            root->appendNew<Value>(proc, Add, Origin(), sources[sources.size() - 1], sources[sources.size() - 2])
+        );
+        expectedSources.append(expectedSources[expectedSources.size() - 1] + expectedSources[expectedSources.size() - 2]);
+    }
+
+    Value* total = root->appendNew<Const64Value>(proc, Origin(), 0);
+    int64_t expected = 0;
+    for (unsigned i = 0; i < sources.size(); ++i) {
+        total = root->appendNew<Value>(proc, Add, Origin(), total, sources[i]);
+        expected += expectedSources[i];
+    }
+
+    root->appendNew<ControlValue>(proc, Return, Origin(), total);
+
+    auto code = compile(proc, optLevel);
+    CHECK(invoke<int64_t>(*code, static_cast<int64_t>(1), static_cast<int64_t>(2)) == expected);
+}
+
+void testSpillFPAtOptLevel(unsigned optLevel)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    Vector<Value*> sources;
+    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), FPRInfo::argumentFPR0));
+    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), FPRInfo::argumentFPR1));
+
+    Vector<double> expectedSources;
+    expectedSources.append(1.5);
+    expectedSources.append(2.5);
+
+    for (unsigned i = 0; i < 30; ++i) {
+        sources.append(
+            root->appendNew<Value>(proc, Add, Origin(), sources[sources.size() - 1], sources[sources.size() - 2])
+        );
+        expectedSources.append(expectedSources[expectedSources.size() - 1] + expectedSources[expectedSources.size() - 2]);
+    }
+
+    Value* total = root->appendNew<ConstDoubleValue>(proc, Origin(), 0.);
+    double expected = 0;
+    for (unsigned i = 0; i < sources.size(); ++i) {
+        total = root->appendNew<Value>(proc, Add, Origin(), total, sources[i]);
+        expected += expectedSources[i];
+    }
+
+    root->appendNew<ControlValue>(proc, Return, Origin(), total);
+
+    auto code = compile(proc, optLevel);
+    CHECK(invoke<double>(*code, 1.5, 2.5) == expected);
+}
+
+void testSpillAcrossLoopBackEdge(unsigned optLevel)
+{
+    // More values are live around the loop than there are registers, so some of them stay spilled
+    // across the back edge, and the loop-carried ones get stored to their slots on every iteration.
+    const unsigned numValues = 30;
+
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* loop = proc.addBlock();
+    BasicBlock* loopReentry = proc.addBlock();
+    BasicBlock* loopExit = proc.addBlock();
+
+    Value* arg = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Vector<Value*> invariants;
+    Vector<UpsilonValue*> startValues;
+    for (unsigned i = 0; i < numValues; ++i) {
+        invariants.append(
+            root->appendNew<Value>(
+                proc, Add, Origin(), arg, root->appendNew<Const64Value>(proc, Origin(), i)));
+        startValues.append(
+            root->appendNew<UpsilonValue>(
+                proc, Origin(), root->appendNew<Const64Value>(proc, Origin(), i)));
+    }
+    UpsilonValue* startIndex = root->appendNew<UpsilonValue>(
+        proc, Origin(),
+        root->appendNew<Value>(
+            proc, Trunc, Origin(),
+            root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1)));
+    root->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    Value* index = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    startIndex->setPhi(index);
+    Vector<Value*> phis;
+    for (unsigned i = 0; i < numValues; ++i) {
+        phis.append(loop->appendNew<Value>(proc, Phi, Int64, Origin()));
+        startValues[i]->setPhi(phis[i]);
+    }
+    Vector<Value*> newValues;
+    for (unsigned i = 0; i < numValues; ++i) {
+        newValues.append(
+            loop->appendNew<Value>(proc, Add, Origin(), phis[i], invariants[(i + 1) % numValues]));
+    }
+    Value* newIndex = loop->appendNew<Value>(
+        proc, Sub, Origin(), index, loop->appendNew<Const32Value>(proc, Origin(), 1));
+    loop->appendNew<ControlValue>(
+        proc, Branch, Origin(), newIndex,
+        FrequentedBlock(loopReentry), FrequentedBlock(loopExit));
+
+    loopReentry->appendNew<UpsilonValue>(proc, Origin(), newIndex, index);
+    for (unsigned i = 0; i < numValues; ++i)
+        loopReentry->appendNew<UpsilonValue>(proc, Origin(), newValues[i], phis[i]);
+    loopReentry->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    Value* total = loopExit->appendNew<Const64Value>(proc, Origin(), 0);
+    for (unsigned i = 0; i < numValues; ++i) {
+        total = loopExit->appendNew<Value>(proc, Add, Origin(), total, newValues[i]);
+        total = loopExit->appendNew<Value>(proc, Add, Origin(), total, invariants[i]);
+    }
+    loopExit->appendNew<ControlValue>(proc, Return, Origin(), total);
+
+    int64_t input = 3;
+    int64_t count = 10;
+    int64_t expected = 0;
+    for (unsigned i = 0; i < numValues; ++i) {
+        expected += i + count * (input + (i + 1) % numValues);
+        expected += input + i;
+    }
+
+    auto code = compile(proc, optLevel);
+    CHECK(invoke<int64_t>(*code, input, count) == expected);
+}
+
+void testRegisterAllocationOfLargeCode(unsigned numDiamonds)
+{
+    // Enough instructions spread over enough blocks that the liveness and the interference graph get
+    // built on the helper threads, but few enough Tmps that we still use graph coloring.
+    const unsigned numLiveValues = 20;
+
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    int64_t thenSlot = 0;
+    int64_t elseSlot = 0;
+    Value* thenSlotPtr = root->appendNew<ConstPtrValue>(proc, Origin(), &thenSlot);
+    Value* elseSlotPtr = root->appendNew<ConstPtrValue>(proc, Origin(), &elseSlot);
+    Value* arg = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Value* predicate = root->appendNew<Value>(proc, Trunc, Origin(), arg);
+
+    Vector<Value*> liveValues;
+    for (unsigned i = 0; i < numLiveValues; ++i) {
+        liveValues.append(
+            root->appendNew<Value>(
+                proc, Add, Origin(), arg, root->appendNew<Const64Value>(proc, Origin(), i)));
+    }
+
+    Value* chain = arg;
+    BasicBlock* current = root;
+    for (unsigned i = 0; i < numDiamonds; ++i) {
+        BasicBlock* thenCase = proc.addBlock();
+        BasicBlock* elseCase = proc.addBlock();
+        BasicBlock* continuation = proc.addBlock();
+
+        current->appendNew<ControlValue>(
+            proc, Branch, Origin(), predicate,
+            FrequentedBlock(thenCase), FrequentedBlock(elseCase));
+
+        thenCase->appendNew<MemoryValue>(proc, Store, Origin(), liveValues[i % numLiveValues], thenSlotPtr);
+        thenCase->appendNew<MemoryValue>(proc, Store, Origin(), chain, elseSlotPtr);
+        thenCase->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(continuation));
+
+        elseCase->appendNew<MemoryValue>(proc, Store, Origin(), liveValues[(i + 1) % numLiveValues], elseSlotPtr);
+        elseCase->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(continuation));
+
+        chain = continuation->appendNew<Value>(proc, Add, Origin(), chain, liveValues[i % numLiveValues]);
+        current = continuation;
+    }
+
+    Value* total = chain;
+    for (Value* value : liveValues)
+        total = current->appendNew<Value>(proc, Add, Origin(), total, value);
+    current->appendNew<ControlValue>(proc, Return, Origin(), total);
+
+    int64_t input = 3;
+    int64_t expected = input;
+    for (unsigned i = 0; i < numDiamonds; ++i)
+        expected += input + i % numLiveValues;
+    for (unsigned i = 0; i < numLiveValues; ++i)
+        expected += input + i;
+
+    CHECK(compileAndRun<int64_t>(proc, input) == expected);
+    CHECK(thenSlot == input + (numDiamonds - 1) % numLiveValues);
+    CHECK(elseSlot == expected - input - (numDiamonds - 1) % numLiveValues - numLiveValues * input - numLiveValues * (numLiveValues - 1) / 2);
+}
+
 void testBranch()
 {
     Procedure proc;
@@ -4664,6 +4866,215 @@ void testChillDivTwice(int num1, int den1, int num2, int den2, int res)
     CHECK(compileAndRun<int>(proc, num1, den1, num2, den2) == res);
 }
 
+void testModArgs(int num, int den, int res)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    root->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        root->appendNew<Value>(
+            proc, Mod, Origin(),
+            root->appendNew<Value>(
+                proc, Trunc, Origin(),
+                root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0)),
+            root->appendNew<Value>(
+                proc, Trunc, Origin(),
+                root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1))));
+
+    CHECK(compileAndRun<int>(proc, num, den) == res);
+}
+
+void testModArgs64(int64_t num, int64_t den, int64_t res)
+{
+    if (!is64Bit())
+        return;
+
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    root->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        root->appendNew<Value>(
+            proc, Mod, Origin(),
+            root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0),
+            root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1)));
+
+    CHECK(compileAndRun<int64_t>(proc, num, den) == res);
+}
+
+void testCSELoadAcrossBlocks(bool clobber)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* thenCase = proc.addBlock();
+    BasicBlock* elseCase = proc.addBlock();
+    BasicBlock* join = proc.addBlock();
+
+    int slot = 37;
+    ConstPtrValue* slotPtr = root->appendNew<ConstPtrValue>(proc, Origin(), &slot);
+    MemoryValue* load = root->appendNew<MemoryValue>(proc, Load, Int32, Origin(), slotPtr);
+    root->appendNew<ControlValue>(
+        proc, Branch, Origin(),
+        root->appendNew<Value>(
+            proc, Trunc, Origin(),
+            root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0)),
+        FrequentedBlock(thenCase), FrequentedBlock(elseCase));
+
+    // This may alias the slot, so if it's there, the load in the join block can't be eliminated.
+    if (clobber) {
+        thenCase->appendNew<MemoryValue>(
+            proc, Store, Origin(),
+            thenCase->appendNew<Const32Value>(proc, Origin(), 666),
+            thenCase->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+    }
+    thenCase->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(join));
+
+    elseCase->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(join));
+
+    join->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        join->appendNew<Value>(
+            proc, Add, Origin(),
+            load,
+            join->appendNew<MemoryValue>(proc, Load, Int32, Origin(), slotPtr)));
+
+    proc.resetReachability();
+    eliminateCommonSubexpressions(proc);
+    unsigned loadsInJoin = 0;
+    for (Value* value : *join) {
+        if (value->opcode() == Load)
+            loadsInJoin++;
+    }
+    CHECK(loadsInJoin == (clobber ? 1u : 0u));
+
+    int other = 0;
+    CHECK(compileAndRun<int>(proc, 1, &slot) == (clobber ? 37 + 666 : 37 + 37));
+    slot = 37;
+    CHECK(compileAndRun<int>(proc, 0, &slot) == 37 + 37);
+    CHECK(compileAndRun<int>(proc, 1, &other) == 37 + 37);
+}
+
+void testLICMLoad(int count, bool storeInLoop)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* loop = proc.addBlock();
+    BasicBlock* loopReentry = proc.addBlock();
+    BasicBlock* loopExit = proc.addBlock();
+
+    int slot = 42;
+    Value* slotPtr = root->appendNew<ConstPtrValue>(proc, Origin(), &slot);
+    UpsilonValue* startIndex = root->appendNew<UpsilonValue>(
+        proc, Origin(),
+        root->appendNew<Value>(
+            proc, Trunc, Origin(),
+            root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0)));
+    UpsilonValue* startSum = root->appendNew<UpsilonValue>(
+        proc, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0));
+    root->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    // The load is loop-invariant unless we also store to the slot in the loop.
+    Value* index = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    startIndex->setPhi(index);
+    Value* sum = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    startSum->setPhi(sum);
+    Value* newSum = loop->appendNew<Value>(
+        proc, Add, Origin(),
+        sum, loop->appendNew<MemoryValue>(proc, Load, Int32, Origin(), slotPtr));
+    if (storeInLoop)
+        loop->appendNew<MemoryValue>(proc, Store, Origin(), index, slotPtr);
+    Value* newIndex = loop->appendNew<Value>(
+        proc, Sub, Origin(), index, loop->appendNew<Const32Value>(proc, Origin(), 1));
+    loop->appendNew<ControlValue>(
+        proc, Branch, Origin(), newIndex,
+        FrequentedBlock(loopReentry), FrequentedBlock(loopExit));
+
+    loopReentry->appendNew<UpsilonValue>(proc, Origin(), newIndex, index);
+    loopReentry->appendNew<UpsilonValue>(proc, Origin(), newSum, sum);
+    loopReentry->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    loopExit->appendNew<ControlValue>(proc, Return, Origin(), newSum);
+
+    int expected = 42;
+    for (int i = count; i > 1; --i)
+        expected += storeInLoop ? i : 42;
+
+    CHECK(compileAndRun<int>(proc, count) == expected);
+}
+
+void testLICMLoadAndCheck(bool checkBeforeLoad)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* loop = proc.addBlock();
+    BasicBlock* loopReentry = proc.addBlock();
+    BasicBlock* loopExit = proc.addBlock();
+
+    int slot = 42;
+    Value* slotPtr = root->appendNew<ConstPtrValue>(proc, Origin(), &slot);
+    Value* limit = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+    UpsilonValue* startIndex = root->appendNew<UpsilonValue>(
+        proc, Origin(),
+        root->appendNew<Value>(
+            proc, Trunc, Origin(),
+            root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0)));
+    UpsilonValue* startSum = root->appendNew<UpsilonValue>(
+        proc, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0));
+    root->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    // The load can only be hoisted to the pre-header if the check doesn't come before it in the
+    // loop header, since the check could exit before the load ever runs.
+    Value* index = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    startIndex->setPhi(index);
+    Value* sum = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    startSum->setPhi(sum);
+    auto appendCheck = [&] () {
+        CheckValue* check = loop->appendNew<CheckValue>(
+            proc, Check, Origin(),
+            loop->appendNew<Value>(proc, GreaterThan, Origin(), index, limit));
+        check->setGenerator(
+            [&] (CCallHelpers& jit, const StackmapGenerationParams&) {
+                jit.move(CCallHelpers::TrustedImm32(-1), GPRInfo::returnValueGPR);
+                jit.emitFunctionEpilogue();
+                jit.ret();
+            });
+    };
+    if (checkBeforeLoad)
+        appendCheck();
+    Value* newSum = loop->appendNew<Value>(
+        proc, Add, Origin(),
+        sum, loop->appendNew<MemoryValue>(proc, Load, Int32, Origin(), slotPtr));
+    if (!checkBeforeLoad)
+        appendCheck();
+    Value* newIndex = loop->appendNew<Value>(
+        proc, Sub, Origin(), index, loop->appendNew<Const32Value>(proc, Origin(), 1));
+    loop->appendNew<ControlValue>(
+        proc, Branch, Origin(), newIndex,
+        FrequentedBlock(loopReentry), FrequentedBlock(loopExit));
+
+    loopReentry->appendNew<UpsilonValue>(proc, Origin(), newIndex, index);
+    loopReentry->appendNew<UpsilonValue>(proc, Origin(), newSum, sum);
+    loopReentry->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    loopExit->appendNew<ControlValue>(proc, Return, Origin(), newSum);
+
+    proc.resetReachability();
+    hoistLoopInvariantValues(proc);
+    unsigned loadsInLoop = 0;
+    for (Value* value : *loop) {
+        if (value->opcode() == Load)
+            loadsInLoop++;
+    }
+    CHECK(loadsInLoop == (checkBeforeLoad ? 1u : 0u));
+
+    auto code = compile(proc);
+    CHECK(invoke<int>(*code, 10, 10) == 42 * 10);
+    CHECK(invoke<int>(*code, 10, 5) == -1);
+}
+
 void testChillDiv64(int64_t num, int64_t den, int64_t res)
 {
     if (!is64Bit())
@@ -5776,6 +6187,14 @@ void run(const char* filter)
 
     RUN(testSpillGP());
     RUN(testSpillFP());
+    RUN(testSpillGPAtOptLevel(0));
+    RUN(testSpillGPAtOptLevel(1));
+    RUN(testSpillFPAtOptLevel(0));
+    RUN(testSpillFPAtOptLevel(1));
+    RUN(testSpillAcrossLoopBackEdge(0));
+    RUN(testSpillAcrossLoopBackEdge(1));
+    RUN(testRegisterAllocationOfLargeCode(10));
+    RUN(testRegisterAllocationOfLargeCode(3000));
 
     RUN(testCallSimple(1, 2));
     RUN(testCallFunctionWithHellaArguments());
@@ -5806,6 +6225,20 @@ void run(const char* filter)
     RUN(testChillDivTwice(4, 2, 6, 2, 5));
     RUN(testChillDivTwice(4, 0, 6, 2, 3));
     RUN(testChillDivTwice(4, 2, 6, 0, 2));
+    RUN(testModArgs(7, 3, 1));
+    RUN(testModArgs(-7, 3, -1));
+    RUN(testModArgs(7, -3, 1));
+    RUN(testModArgs(0, 5, 0));
+    RUN(testModArgs64(7, 3, 1));
+    RUN(testModArgs64(-7, 3, -1));
+    RUN(testModArgs64(10000000000ll, 3, 1));
+    RUN(testCSELoadAcrossBlocks(false));
+    RUN(testCSELoadAcrossBlocks(true));
+    RUN(testLICMLoad(1, false));
+    RUN(testLICMLoad(10, false));
+    RUN(testLICMLoad(10, true));
+    RUN(testLICMLoadAndCheck(false));
+    RUN(testLICMLoadAndCheck(true));
 
     RUN(testSwitch(0, 1));
     RUN(testSwitch(1, 1));
@@ -62,6 +62,8 @@ const char* exitKindToString(ExitKind kind)
         return "LoadFromHole";
     case OutOfBounds:
         return "OutOfBounds";
+    case ArrayAliasing:
+        return "ArrayAliasing";
     case InadequateCoverage:
         return "InadequateCoverage";
     case ArgumentsEscaped:
@@ -2320,6 +2320,9 @@ bool AbstractInterpreter<AbstractStateType>::executeEffects(unsigned clobberLimi
         }
         break;
     }
+
+    case CheckNoHolesInRange:
+        break;
         
     case PutById:
     case PutByIdFlush:
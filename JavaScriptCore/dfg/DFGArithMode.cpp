@@ -42,6 +42,9 @@ void printInternal(PrintStream& out, JSC::DFG::Arith::Mode mode)
     case JSC::DFG::Arith::Unchecked:
         out.print("Unchecked");
         return;
+    case JSC::DFG::Arith::ProvedNoOverflow:
+        out.print("ProvedNoOverflow");
+        return;
     case JSC::DFG::Arith::CheckOverflow:
         out.print("CheckOverflow");
         return;
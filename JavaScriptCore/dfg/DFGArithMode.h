@@ -36,6 +36,7 @@ namespace Arith {
 enum Mode {
     NotSet, // Arithmetic mode is either not relevant because we're using doubles anyway or we are at a phase in compilation where we don't know what we're doing, yet. Should never see this after FixupPhase except for nodes that take doubles as inputs already.
     Unchecked, // Don't check anything and just do the direct hardware operation.
+    ProvedNoOverflow, // Like Unchecked, but we proved that the operation cannot overflow, so the backend may assume that it doesn't.
     CheckOverflow, // Check for overflow but don't bother with negative zero.
     CheckOverflowAndNegativeZero, // Check for both overflow and negative zero.
     DoOverflow // Up-convert to the smallest type that soundly represents all possible results after input type speculation.
@@ -59,6 +60,7 @@ inline bool doesOverflow(Arith::Mode mode)
         FALLTHROUGH;
 #endif
     case Arith::Unchecked:
+    case Arith::ProvedNoOverflow:
     case Arith::CheckOverflow:
     case Arith::CheckOverflowAndNegativeZero:
         return false;
@@ -79,6 +81,7 @@ inline bool shouldCheckOverflow(Arith::Mode mode)
         ASSERT_NOT_REACHED();
         return true;
     case Arith::Unchecked:
+    case Arith::ProvedNoOverflow:
         return false;
     case Arith::CheckOverflow:
     case Arith::CheckOverflowAndNegativeZero:
@@ -96,6 +99,7 @@ inline bool shouldCheckNegativeZero(Arith::Mode mode)
         ASSERT_NOT_REACHED();
         return true;
     case Arith::Unchecked:
+    case Arith::ProvedNoOverflow:
     case Arith::CheckOverflow:
         return false;
     case Arith::CheckOverflowAndNegativeZero:
@@ -111,6 +115,7 @@ inline bool subsumes(Arith::Mode earlier, Arith::Mode later)
     case Arith::CheckOverflow:
         switch (later) {
         case Arith::Unchecked:
+        case Arith::ProvedNoOverflow:
         case Arith::CheckOverflow:
             return true;
         default:
@@ -119,6 +124,7 @@ inline bool subsumes(Arith::Mode earlier, Arith::Mode later)
     case Arith::CheckOverflowAndNegativeZero:
         switch (later) {
         case Arith::Unchecked:
+        case Arith::ProvedNoOverflow:
         case Arith::CheckOverflow:
         case Arith::CheckOverflowAndNegativeZero:
             return true;
@@ -130,6 +136,20 @@ inline bool subsumes(Arith::Mode earlier, Arith::Mode later)
     }
 }
 
+// Returns true if the integer result of an operation in this mode is always the mathematical
+// one: either it gets checked, or it was proved not to overflow.
+inline bool cannotWrap(Arith::Mode mode)
+{
+    switch (mode) {
+    case Arith::ProvedNoOverflow:
+    case Arith::CheckOverflow:
+    case Arith::CheckOverflowAndNegativeZero:
+        return true;
+    default:
+        return false;
+    }
+}
+
 inline bool producesInteger(Arith::RoundingMode mode)
 {
     return mode == Arith::RoundingMode::Int32WithNegativeZeroCheck || mode == Arith::RoundingMode::Int32;
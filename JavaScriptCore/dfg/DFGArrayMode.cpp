@@ -584,6 +584,8 @@ const char* arraySpeculationToString(Array::Speculation speculation)
         return "SaneChain";
     case Array::InBounds:
         return "InBounds";
+    case Array::HoleFree:
+        return "HoleFree";
     case Array::ToHole:
         return "ToHole";
     case Array::OutOfBounds:
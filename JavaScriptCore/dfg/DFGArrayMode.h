@@ -93,6 +93,7 @@ enum Speculation {
     SaneChain, // In bounds and the array prototype chain is still intact, i.e. loading a hole doesn't require special treatment.
     
     InBounds, // In bounds and not loading a hole.
+    HoleFree, // In bounds, and a check before the loop proved that there are no holes where we load from.
     ToHole, // Potentially storing to a hole.
     OutOfBounds // Out-of-bounds access and anything can happen.
 };
@@ -271,12 +272,18 @@ public:
         switch (speculation()) {
         case Array::SaneChain:
         case Array::InBounds:
+        case Array::HoleFree:
             return true;
         default:
             return false;
         }
     }
     
+    bool isHoleFree() const
+    {
+        return speculation() == Array::HoleFree;
+    }
+    
     bool mayStoreToHole() const
     {
         return !isInBounds();
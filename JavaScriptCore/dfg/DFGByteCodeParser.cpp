@@ -4975,6 +4975,11 @@ bool ByteCodeParser::parse()
         dataLog("Parsing ", *m_codeBlock, "\n");
     
     m_dfgCodeBlock = m_graph.m_plan.profiledDFGCodeBlock;
+    // JSCPOLLY COMMENT
+    // Polly tier-up compiles are profiled by an FTL code block, whose inline caches we
+    // don't know how to use for polyvariant devirtualization.
+    if (m_dfgCodeBlock && m_dfgCodeBlock->jitType() != JITCode::DFGJIT)
+        m_dfgCodeBlock = nullptr;
     if (isFTL(m_graph.m_plan.mode) && m_dfgCodeBlock
         && Options::usePolyvariantDevirtualization()) {
         if (Options::usePolyvariantCallInlining())
@@ -589,6 +589,23 @@ void clobberize(Graph& graph, Node* node, const ReadFunctor& read, const WriteFu
         RELEASE_ASSERT_NOT_REACHED();
         return;
     }
+
+    case CheckNoHolesInRange:
+        read(Butterfly_publicLength);
+        switch (node->arrayMode().type()) {
+        case Array::Int32:
+            read(IndexedInt32Properties);
+            return;
+        case Array::Double:
+            read(IndexedDoubleProperties);
+            return;
+        case Array::Contiguous:
+            read(IndexedContiguousProperties);
+            return;
+        default:
+            DFG_CRASH(graph, node, "impossible array mode for hole check");
+            return;
+        }
         
     case GetMyArgumentByVal: {
         read(Stack);
@@ -36,9 +36,12 @@
 namespace JSC { namespace DFG {
 
 // We are in the middle of an experimental transition from LLVM to B3 as the backend for the FTL. We don't
-// yet know how it will turn out. For now, this flag will control whether FTL uses B3. Remember to set this
-// to 0 before committing!
+// yet know how it will turn out. For now, this flag will control whether FTL uses B3; a build can try B3 by
+// passing -DFTL_USES_B3=1. It can't be a runtime option, since the FTL's IR types come from the backend.
+// Remember to leave the default at 0 before committing!
+#ifndef FTL_USES_B3
 #define FTL_USES_B3 0
+#endif
 
 struct Node;
 
@@ -49,6 +49,9 @@ void printInternal(PrintStream& out, CompilationMode mode)
     case FTLForOSREntryMode:
         out.print("FTLForOSREntryMode");
         return;
+    case FTLForPollyMode:
+        out.print("FTLForPollyMode");
+        return;
     }
     RELEASE_ASSERT_NOT_REACHED();
 }
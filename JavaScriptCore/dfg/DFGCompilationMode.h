@@ -34,7 +34,8 @@ enum CompilationMode {
     InvalidCompilationMode,
     DFGMode,
     FTLMode,
-    FTLForOSREntryMode
+    FTLForOSREntryMode,
+    FTLForPollyMode // JSCPOLLY: background recompile of plain FTL code with polly.
 };
 
 inline bool isFTL(CompilationMode mode)
@@ -42,6 +43,7 @@ inline bool isFTL(CompilationMode mode)
     switch (mode) {
     case FTLMode:
     case FTLForOSREntryMode:
+    case FTLForPollyMode:
         return true;
     default:
         return false;
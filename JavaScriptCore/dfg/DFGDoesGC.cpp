@@ -178,6 +178,7 @@ bool doesGC(Graph& graph, Node* node)
     case InvalidationPoint:
     case NotifyWrite:
     case CheckInBounds:
+    case CheckNoHolesInRange:
     case ConstantStoragePointer:
     case Check:
     case MultiGetByOffset:
@@ -72,7 +72,9 @@ static CompilationResult compileImpl(
     ASSERT(codeBlock);
     ASSERT(codeBlock->alternative());
     ASSERT(codeBlock->alternative()->jitType() == JITCode::BaselineJIT);
-    ASSERT(!profiledDFGCodeBlock || profiledDFGCodeBlock->jitType() == JITCode::DFGJIT);
+    ASSERT(!profiledDFGCodeBlock
+        || profiledDFGCodeBlock->jitType() == JITCode::DFGJIT
+        || (mode == FTLForPollyMode && profiledDFGCodeBlock->jitType() == JITCode::FTLJIT));
     
     if (logCompilationChanges(mode))
         dataLog("DFG(Driver) compiling ", *codeBlock, " with ", mode, ", number of instructions = ", codeBlock->instructionCount(), "\n");
@@ -1205,6 +1205,7 @@ private:
         case InvalidationPoint:
         case CheckArray:
         case CheckInBounds:
+        case CheckNoHolesInRange:
         case ConstantStoragePointer:
         case DoubleAsInt32:
         case ValueToInt32:
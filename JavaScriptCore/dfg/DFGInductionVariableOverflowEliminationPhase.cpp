@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "DFGInductionVariableOverflowEliminationPhase.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGGraph.h"
+#include "DFGInductionVariables.h"
+#include "DFGNaturalLoops.h"
+#include "DFGPhase.h"
+#include "JSCInlines.h"
+
+namespace JSC { namespace DFG {
+
+namespace {
+
+bool verbose = false;
+
+} // anonymous namespace
+
+class InductionVariableOverflowEliminationPhase : public Phase {
+public:
+    InductionVariableOverflowEliminationPhase(Graph& graph)
+        : Phase(graph, "induction variable overflow elimination")
+    {
+    }
+
+    bool run()
+    {
+        ASSERT(m_graph.m_form == SSA);
+
+        m_graph.ensureNaturalLoops();
+        InductionVariables variables(m_graph);
+
+        bool changed = false;
+        for (unsigned i = 0; i < variables.size(); ++i) {
+            const InductionVariable& variable = variables[i];
+            if (!shouldCheckOverflow(variable.increment->arithMode()))
+                continue;
+            if (!incrementCannotOverflow(variable))
+                continue;
+
+            if (verbose)
+                dataLog("Proved that ", variable.increment, " in ", variable, " cannot overflow.\n");
+            variable.increment->setArithMode(Arith::ProvedNoOverflow);
+            changed = true;
+        }
+
+        return changed;
+    }
+
+private:
+    // The increment computes phi + 1, so it overflows only if phi can be INT_MAX. The phi is
+    // either the initial value, or the previous increment, which the latch only feeds back
+    // when it is less than the limit (or no greater than it, if the limit is inclusive).
+    bool incrementCannotOverflow(const InductionVariable& variable)
+    {
+        const int32_t max = std::numeric_limits<int32_t>::max();
+
+        if (!variable.initialValue->isInt32Constant() || variable.initialValue->asInt32() == max)
+            return false;
+
+        if (!variable.limitIsInclusive)
+            return true;
+
+        return variable.limit->isInt32Constant() && variable.limit->asInt32() < max;
+    }
+};
+
+bool performInductionVariableOverflowElimination(Graph& graph)
+{
+    SamplingRegion samplingRegion("DFG Induction Variable Overflow Elimination Phase");
+    return runPhase<InductionVariableOverflowEliminationPhase>(graph);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "DFGInductionVariables.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGGraph.h"
+#include "DFGNaturalLoops.h"
+#include "JSCInlines.h"
+#include <wtf/CommaPrinter.h>
+
+namespace JSC { namespace DFG {
+
+namespace {
+
+bool verbose = false;
+
+const unsigned maxDecompositionDepth = 8;
+
+bool isInt32(int64_t value)
+{
+    return value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+}
+
+bool isNonWrappingInt32Add(Node* node)
+{
+    return node->op() == ArithAdd
+        && node->isBinaryUseKind(Int32Use)
+        && cannotWrap(node->arithMode());
+}
+
+} // anonymous namespace
+
+void InductionVariable::dump(PrintStream& out) const
+{
+    out.print(
+        "[", *loop, " phi = ", phi, ", increment = ", increment, ", from ", initialValue,
+        limitIsInclusive ? " to " : " below ", limit, "]");
+}
+
+void AffineIndex::dump(PrintStream& out) const
+{
+    out.print(scale, " * ", variable->phi);
+    if (invariant)
+        out.print(" + ", invariant);
+    out.print(" + ", offset);
+}
+
+InductionVariables::InductionVariables(Graph& graph)
+    : m_graph(graph)
+{
+    ASSERT(m_graph.m_form == SSA);
+    ASSERT(m_graph.m_naturalLoops);
+
+    m_nodesInLoop.resize(m_graph.m_naturalLoops->numLoops());
+    for (unsigned loopIndex = m_graph.m_naturalLoops->numLoops(); loopIndex--;)
+        tryAdd(m_graph.m_naturalLoops->loop(loopIndex));
+
+    if (verbose)
+        dataLog("Induction variables: ", *this, "\n");
+}
+
+const InductionVariable* InductionVariables::forPhi(Node* phi) const
+{
+    auto iter = m_phiToVariable.find(phi);
+    if (iter == m_phiToVariable.end())
+        return nullptr;
+    return &m_variables[iter->value];
+}
+
+bool InductionVariables::decompose(Node* node, AffineIndex& result) const
+{
+    return decompose(node, result, 0);
+}
+
+bool InductionVariables::decompose(Node* node, AffineIndex& result, unsigned depth) const
+{
+    if (const InductionVariable* variable = forPhi(node)) {
+        result = AffineIndex();
+        result.variable = variable;
+        return true;
+    }
+
+    // Index expressions are short. This keeps us from walking shared subexpressions an
+    // exponential number of times.
+    if (depth >= maxDecompositionDepth)
+        return false;
+
+    switch (node->op()) {
+    case ArithAdd:
+    case ArithSub:
+    case ArithMul: {
+        if (!node->isBinaryUseKind(Int32Use) || !cannotWrap(node->arithMode()))
+            return false;
+
+        for (unsigned variableChild = 0; variableChild < 2; ++variableChild) {
+            if (variableChild && node->op() == ArithSub)
+                break;
+
+            AffineIndex index;
+            if (!decompose(node->children.child(variableChild).node(), index, depth + 1))
+                continue;
+
+            Node* other = node->children.child(!variableChild).node();
+            int64_t scale = index.scale;
+            int64_t offset = index.offset;
+            switch (node->op()) {
+            case ArithAdd:
+                if (other->isInt32Constant())
+                    offset += other->asInt32();
+                else if (!index.invariant && isLoopInvariant(*index.variable, other))
+                    index.invariant = other;
+                else
+                    continue;
+                break;
+            case ArithSub:
+                if (!other->isInt32Constant())
+                    continue;
+                offset -= other->asInt32();
+                break;
+            case ArithMul:
+                if (!other->isInt32Constant() || other->asInt32() <= 0 || index.invariant)
+                    continue;
+                scale *= other->asInt32();
+                offset *= other->asInt32();
+                break;
+            default:
+                RELEASE_ASSERT_NOT_REACHED();
+                break;
+            }
+
+            if (!isInt32(scale) || !isInt32(offset))
+                continue;
+            index.scale = static_cast<int32_t>(scale);
+            index.offset = static_cast<int32_t>(offset);
+            result = index;
+            return true;
+        }
+        return false;
+    }
+
+    default:
+        return false;
+    }
+}
+
+bool InductionVariables::isLoopInvariant(const InductionVariable& variable, Node* node) const
+{
+    if (node->isConstant())
+        return true;
+    return !m_nodesInLoop[variable.loop->index()].contains(node);
+}
+
+void InductionVariables::dump(PrintStream& out) const
+{
+    CommaPrinter comma;
+    out.print("{");
+    for (const InductionVariable& variable : m_variables)
+        out.print(comma, variable);
+    out.print("}");
+}
+
+void InductionVariables::tryAdd(const NaturalLoop& loop)
+{
+    BasicBlock* header = loop.header();
+
+    // We want exactly one edge from outside the loop and one back edge. Anything else is either a
+    // loop whose pre-header got destroyed or a loop with "continue" statements, which we don't
+    // bother with.
+    if (header->predecessors.size() != 2)
+        return;
+
+    BasicBlock* preHeader = nullptr;
+    BasicBlock* latch = nullptr;
+    for (BasicBlock* predecessor : header->predecessors) {
+        if (m_graph.m_dominators->dominates(header, predecessor))
+            latch = predecessor;
+        else
+            preHeader = predecessor;
+    }
+    if (!preHeader || !latch)
+        return;
+
+    // Same rules as LICM: the pre-header has to be a place where we can exit.
+    Node* preHeaderTerminal = preHeader->terminal();
+    if (preHeaderTerminal->op() != Jump || !preHeaderTerminal->origin.exitOK)
+        return;
+
+    Node* branch = latch->terminal();
+    if (branch->op() != Branch)
+        return;
+    if (branch->successorForCondition(true) != header)
+        return;
+    if (loop.contains(branch->successorForCondition(false)))
+        return;
+
+    Node* compare = branch->child1().node();
+    bool limitIsInclusive;
+    switch (compare->op()) {
+    case CompareLess:
+        limitIsInclusive = false;
+        break;
+    case CompareLessEq:
+        limitIsInclusive = true;
+        break;
+    default:
+        return;
+    }
+    if (!compare->isBinaryUseKind(Int32Use))
+        return;
+
+    Node* increment = compare->child1().node();
+    if (!isNonWrappingInt32Add(increment))
+        return;
+
+    Node* phi;
+    if (increment->child2()->isInt32Constant() && increment->child2()->asInt32() == 1)
+        phi = increment->child1().node();
+    else if (increment->child1()->isInt32Constant() && increment->child1()->asInt32() == 1)
+        phi = increment->child2().node();
+    else
+        return;
+    if (phi->op() != Phi || !phi->hasInt32Result())
+        return;
+
+    Node* initialValue = nullptr;
+    bool incrementFlowsIntoPhi = false;
+    for (BasicBlock* predecessor : header->predecessors) {
+        for (Node* node : *predecessor) {
+            if (node->op() != Upsilon || node->phi() != phi)
+                continue;
+            if (predecessor == preHeader)
+                initialValue = node->child1().node();
+            else if (node->child1().node() == increment)
+                incrementFlowsIntoPhi = true;
+        }
+    }
+    if (!initialValue || !incrementFlowsIntoPhi)
+        return;
+
+    HashSet<Node*>& nodesInLoop = m_nodesInLoop[loop.index()];
+    for (unsigned blockIndex = loop.size(); blockIndex--;) {
+        BasicBlock* block = loop.at(blockIndex);
+        for (unsigned nodeIndex = block->numNodes(); nodeIndex--;)
+            nodesInLoop.add(block->node(nodeIndex));
+    }
+
+    Node* limit = compare->child2().node();
+    if (!limit->isConstant() && nodesInLoop.contains(limit))
+        return;
+
+    InductionVariable variable;
+    variable.loop = &loop;
+    variable.preHeader = preHeader;
+    variable.latch = latch;
+    variable.phi = phi;
+    variable.increment = increment;
+    variable.initialValue = initialValue;
+    variable.limit = limit;
+    variable.limitIsInclusive = limitIsInclusive;
+
+    m_phiToVariable.add(phi, m_variables.size());
+    m_variables.append(variable);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
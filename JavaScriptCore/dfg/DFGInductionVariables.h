@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef DFGInductionVariables_h
+#define DFGInductionVariables_h
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGCommon.h"
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/PrintStream.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace DFG {
+
+class BasicBlock;
+class Graph;
+class NaturalLoop;
+struct Node;
+
+// A counted loop of the shape the bytecode generator emits for "for (i = a; i < b; i++)":
+//
+//     preHeader:
+//         Upsilon(@initialValue, ^phi)
+//         Jump(header)
+//     header:
+//         phi: Phi()
+//         ...
+//     latch:
+//         increment: ArithAdd(@phi, 1, CheckOverflow)
+//         Upsilon(@increment, ^phi)
+//         Branch(CompareLess(@increment, @limit), T:header, F:<outside the loop>)
+//
+// The limit must be loop invariant and the increment must not wrap around (it either checks
+// overflow or was proved not to overflow), so on every iteration
+// we know that initialValue <= phi <= max(initialValue, limit - 1). For CompareLessEq the upper
+// bound is max(initialValue, limit) instead.
+struct InductionVariable {
+    void dump(PrintStream&) const;
+
+    const NaturalLoop* loop { nullptr };
+    BasicBlock* preHeader { nullptr };
+    BasicBlock* latch { nullptr };
+    Node* phi { nullptr };
+    Node* increment { nullptr };
+    Node* initialValue { nullptr };
+    Node* limit { nullptr };
+    bool limitIsInclusive { false };
+};
+
+// An index computed as scale * variable.phi + invariant + offset, where the scale is positive
+// and the invariant, if there is one, is computed outside of the variable's loop.
+struct AffineIndex {
+    void dump(PrintStream&) const;
+
+    const InductionVariable* variable { nullptr };
+    int32_t scale { 1 };
+    Node* invariant { nullptr };
+    int32_t offset { 0 };
+};
+
+class InductionVariables {
+public:
+    InductionVariables(Graph&);
+
+    unsigned size() const { return m_variables.size(); }
+    const InductionVariable& at(unsigned i) const { return m_variables[i]; }
+    const InductionVariable& operator[](unsigned i) const { return at(i); }
+
+    const InductionVariable* forPhi(Node*) const;
+
+    // Tells if the node computes an affine function of an induction variable, with every step
+    // of the computation either checking for overflow or proved not to overflow.
+    bool decompose(Node*, AffineIndex&) const;
+
+    // Tells if the node is computed outside of the loop, so its value at the pre-header is the
+    // value it has on every iteration.
+    bool isLoopInvariant(const InductionVariable&, Node*) const;
+
+    void dump(PrintStream&) const;
+
+private:
+    void tryAdd(const NaturalLoop&);
+    bool decompose(Node*, AffineIndex&, unsigned depth) const;
+
+    Graph& m_graph;
+    Vector<InductionVariable> m_variables;
+    HashMap<Node*, unsigned> m_phiToVariable;
+    Vector<HashSet<Node*>> m_nodesInLoop;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGInductionVariables_h
+
@@ -1227,7 +1227,7 @@ public:
                         break;
                     
                     executeNode(block->at(nodeIndex));
-                    node->setArithMode(Arith::Unchecked);
+                    node->setArithMode(Arith::ProvedNoOverflow);
                     changed = true;
                     break;
                 }
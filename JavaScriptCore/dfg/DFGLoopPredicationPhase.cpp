@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "DFGLoopPredicationPhase.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGClobberSet.h"
+#include "DFGDominators.h"
+#include "DFGGraph.h"
+#include "DFGInductionVariables.h"
+#include "DFGInsertionSet.h"
+#include "DFGNaturalLoops.h"
+#include "DFGPhase.h"
+#include "JSCInlines.h"
+
+namespace JSC { namespace DFG {
+
+namespace {
+
+bool verbose = false;
+
+// All of the hoisted checks of one loop that have the same base and the same index, except for
+// the constant offset. The base is the length for bounds checks and the storage for hole checks.
+struct HoistedRange {
+    Node* base;
+    ArrayMode arrayMode;
+    int32_t scale;
+    Node* invariant;
+    int32_t minOffset;
+    int32_t maxOffset;
+};
+
+struct LoopGuard {
+    Vector<HoistedRange> ranges;
+    Vector<Node*> checks;
+    Vector<HoistedRange> holeFreeRanges;
+    Vector<Node*> loads;
+};
+
+} // anonymous namespace
+
+class LoopPredicationPhase : public Phase {
+public:
+    LoopPredicationPhase(Graph& graph)
+        : Phase(graph, "loop predication")
+        , m_insertionSet(graph)
+    {
+    }
+
+    bool run()
+    {
+        ASSERT(m_graph.m_form == SSA);
+
+        m_graph.ensureDominators();
+        m_graph.ensureNaturalLoops();
+        m_graph.initializeNodeOwners();
+
+        InductionVariables variables(m_graph);
+        if (!variables.size())
+            return false;
+
+        HashMap<const InductionVariable*, LoopGuard> guards;
+        for (BasicBlock* block : m_graph.blocksInNaturalOrder()) {
+            for (Node* node : *block) {
+                switch (node->op()) {
+                case CheckInBounds: {
+                    AffineIndex index;
+                    if (!findIndex(variables, block, node->child1().node(), index))
+                        break;
+                    const InductionVariable& variable = *index.variable;
+
+                    Node* length = node->child2().node();
+                    if (!variables.isLoopInvariant(variable, length))
+                        break;
+                    if (!canHoistTo(variable))
+                        break;
+                    if (!isAvailableAt(variable, length) || !isAvailableAt(variable, index.invariant))
+                        break;
+
+                    LoopGuard& guard = guards.add(&variable, LoopGuard()).iterator->value;
+                    guard.checks.append(node);
+                    addToRange(guard.ranges, length, ArrayMode(), index);
+                    break;
+                }
+
+                case GetByVal: {
+                    if (!isHoleCheckedLoad(node))
+                        break;
+
+                    AffineIndex index;
+                    if (!findIndex(variables, block, node->child2().node(), index))
+                        break;
+                    const InductionVariable& variable = *index.variable;
+
+                    Node* storage = node->child3().node();
+                    if (!variables.isLoopInvariant(variable, storage))
+                        break;
+                    if (!canScanHolesAt(variable))
+                        break;
+                    if (!isAvailableAt(variable, storage) || !isAvailableAt(variable, index.invariant))
+                        break;
+
+                    LoopGuard& guard = guards.add(&variable, LoopGuard()).iterator->value;
+                    guard.loads.append(node);
+                    addToRange(guard.holeFreeRanges, storage, node->arrayMode(), index);
+                    break;
+                }
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        if (guards.isEmpty())
+            return false;
+
+        for (unsigned i = 0; i < variables.size(); ++i) {
+            auto iter = guards.find(&variables[i]);
+            if (iter == guards.end())
+                continue;
+            hoist(variables[i], iter->value);
+        }
+
+        return true;
+    }
+
+private:
+    // Checks that don't run on every iteration could fail before the loop even though the loop
+    // would never have run them.
+    bool findIndex(const InductionVariables& variables, BasicBlock* block, Node* node, AffineIndex& index)
+    {
+        if (!variables.decompose(node, index))
+            return false;
+        const InductionVariable& variable = *index.variable;
+        return variable.loop->contains(block)
+            && m_graph.m_dominators->dominates(block, variable.latch);
+    }
+
+    bool canHoistTo(const InductionVariable& variable)
+    {
+        // If the range check at the pre-header itself keeps failing, just check every access
+        // like we normally would.
+        CodeOrigin origin = variable.preHeader->terminal()->origin.semantic;
+        if (m_graph.hasExitSite(origin, OutOfBounds) || m_graph.hasExitSite(origin, Overflow))
+            return false;
+
+        return isAvailableAt(variable, variable.limit);
+    }
+
+    bool canScanHolesAt(const InductionVariable& variable)
+    {
+        if (!canHoistTo(variable))
+            return false;
+        if (m_graph.hasExitSite(variable.preHeader->terminal()->origin.semantic, LoadFromHole))
+            return false;
+        return exitsOnlyFromLatch(variable) && !mayCreateHoles(*variable.loop);
+    }
+
+    // Nodes computed outside of the loop are available at the pre-header, but be sure.
+    bool isAvailableAt(const InductionVariable& variable, Node* node)
+    {
+        if (!node || node->isConstant())
+            return true;
+        return m_graph.m_dominators->dominates(node->owner, variable.preHeader);
+    }
+
+    // Sane chain loads don't exit on holes, so there's nothing to gain for them.
+    static bool isHoleCheckedLoad(Node* node)
+    {
+        ArrayMode mode = node->arrayMode();
+        if (mode.speculation() != Array::InBounds)
+            return false;
+        switch (mode.type()) {
+        case Array::Int32:
+        case Array::Double:
+        case Array::Contiguous:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // A loop that breaks out early might load much less than its full range, so scanning the
+    // whole range before it could cost more than the hole checks it saves.
+    bool exitsOnlyFromLatch(const InductionVariable& variable)
+    {
+        const NaturalLoop& loop = *variable.loop;
+        for (unsigned i = loop.size(); i--;) {
+            BasicBlock* block = loop[i];
+            if (block == variable.latch)
+                continue;
+            for (BasicBlock* successor : block->successors()) {
+                if (!loop.contains(successor))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Storing a value never makes a hole, and neither does pushing. Anything else that writes to
+    // an array's elements or length might.
+    bool mayCreateHoles(const NaturalLoop& loop)
+    {
+        auto iter = m_mayCreateHoles.find(&loop);
+        if (iter != m_mayCreateHoles.end())
+            return iter->value;
+
+        bool result = computeMayCreateHoles(loop);
+        m_mayCreateHoles.add(&loop, result);
+        return result;
+    }
+
+    bool computeMayCreateHoles(const NaturalLoop& loop)
+    {
+        ClobberSet writes;
+        for (unsigned i = loop.size(); i--;) {
+            for (Node* node : *loop[i]) {
+                writes.clear();
+                addWrites(m_graph, node, writes);
+                if (!writes.overlaps(IndexedInt32Properties)
+                    && !writes.overlaps(IndexedDoubleProperties)
+                    && !writes.overlaps(IndexedContiguousProperties)
+                    && !writes.overlaps(Butterfly_publicLength))
+                    continue;
+                if (storesWithoutHoles(node))
+                    continue;
+                if (verbose)
+                    dataLog(node, " may create holes in ", loop, "\n");
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool storesWithoutHoles(Node* node)
+    {
+        switch (node->op()) {
+        case PutByVal:
+        case PutByValDirect:
+        case PutByValAlias:
+            // Storing to a hole past the public length leaves holes behind it, but only at
+            // indices that the scan before the loop already found to be out of bounds.
+            if (node->arrayMode().isOutOfBounds())
+                return false;
+            break;
+        case ArrayPush:
+            break;
+        default:
+            return false;
+        }
+        switch (node->arrayMode().type()) {
+        case Array::Int32:
+        case Array::Double:
+        case Array::Contiguous:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void addToRange(Vector<HoistedRange>& ranges, Node* base, ArrayMode arrayMode, const AffineIndex& index)
+    {
+        for (HoistedRange& range : ranges) {
+            if (range.base != base || range.scale != index.scale || range.invariant != index.invariant)
+                continue;
+            if (range.arrayMode.type() != arrayMode.type())
+                continue;
+            range.minOffset = std::min(range.minOffset, index.offset);
+            range.maxOffset = std::max(range.maxOffset, index.offset);
+            return;
+        }
+        ranges.append(HoistedRange { base, arrayMode, index.scale, index.invariant, index.offset, index.offset });
+    }
+
+    // The induction variable goes from the initial value to max(initialValue, limit - 1), and
+    // the index grows with it. So we only need to check the index at both ends. All of the math
+    // checks for overflow, so the checks can't pass by wrapping around. The loops we handle are
+    // tested at the bottom and entered by a jump from the pre-header, so once we get here the body
+    // runs at least once with the initial value, even when that is already past the limit.
+    void hoist(const InductionVariable& variable, const LoopGuard& guard)
+    {
+        if (verbose) {
+            dataLog(
+                "Hoisting ", guard.checks.size(), " bounds checks and ", guard.loads.size(),
+                " hole checks of ", variable, " to ", *variable.preHeader, "\n");
+        }
+
+        BasicBlock* preHeader = variable.preHeader;
+        unsigned nodeIndex = preHeader->size() - 1;
+        NodeOrigin origin = preHeader->terminal()->origin;
+
+        Node* low = variable.initialValue;
+        Node* high = variable.limit;
+        if (!variable.limitIsInclusive)
+            high = insertArith(nodeIndex, origin, ArithSub, high, constant(nodeIndex, origin, 1));
+        high = m_insertionSet.insertNode(
+            nodeIndex, SpecInt32, NodeResultInt32, ArithMax, origin,
+            Edge(low, Int32Use), Edge(high, Int32Use));
+
+        for (const HoistedRange& range : guard.ranges) {
+            Node* lowIndex = affineIndex(nodeIndex, origin, low, range, range.minOffset);
+            Node* highIndex = affineIndex(nodeIndex, origin, high, range, range.maxOffset);
+            m_insertionSet.insertNode(
+                nodeIndex, SpecNone, CheckInBounds, origin,
+                Edge(lowIndex, Int32Use), Edge(range.base, Int32Use));
+            m_insertionSet.insertNode(
+                nodeIndex, SpecNone, CheckInBounds, origin,
+                Edge(highIndex, Int32Use), Edge(range.base, Int32Use));
+        }
+
+        for (const HoistedRange& range : guard.holeFreeRanges) {
+            Node* lowIndex = affineIndex(nodeIndex, origin, low, range, range.minOffset);
+            Node* highIndex = affineIndex(nodeIndex, origin, high, range, range.maxOffset);
+            m_insertionSet.insertNode(
+                nodeIndex, SpecNone, CheckNoHolesInRange, origin,
+                OpInfo(range.arrayMode.withSpeculation(Array::HoleFree).asWord()),
+                Edge(range.base), Edge(lowIndex, Int32Use), Edge(highIndex, Int32Use));
+        }
+        m_insertionSet.execute(preHeader);
+
+        for (Node* check : guard.checks)
+            check->remove();
+        for (Node* load : guard.loads)
+            load->setArrayMode(load->arrayMode().withSpeculation(Array::HoleFree));
+    }
+
+    Node* affineIndex(unsigned nodeIndex, NodeOrigin origin, Node* value, const HoistedRange& range, int32_t offset)
+    {
+        if (range.scale != 1)
+            value = insertArith(nodeIndex, origin, ArithMul, value, constant(nodeIndex, origin, range.scale));
+        if (range.invariant)
+            value = insertArith(nodeIndex, origin, ArithAdd, value, range.invariant);
+        if (offset)
+            value = insertArith(nodeIndex, origin, ArithAdd, value, constant(nodeIndex, origin, offset));
+        return value;
+    }
+
+    Node* insertArith(unsigned nodeIndex, NodeOrigin origin, NodeType op, Node* left, Node* right)
+    {
+        return m_insertionSet.insertNode(
+            nodeIndex, SpecInt32, NodeResultInt32, op, origin, OpInfo(Arith::CheckOverflow),
+            Edge(left, Int32Use), Edge(right, Int32Use));
+    }
+
+    Node* constant(unsigned nodeIndex, NodeOrigin origin, int32_t value)
+    {
+        return m_insertionSet.insertConstant(nodeIndex, origin, jsNumber(value));
+    }
+
+    InsertionSet m_insertionSet;
+    HashMap<const NaturalLoop*, bool> m_mayCreateHoles;
+};
+
+bool performLoopPredication(Graph& graph)
+{
+    SamplingRegion samplingRegion("DFG Loop Predication Phase");
+    return runPhase<LoopPredicationPhase>(graph);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
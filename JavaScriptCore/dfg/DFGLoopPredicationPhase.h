@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef DFGLoopPredicationPhase_h
+#define DFGLoopPredicationPhase_h
+
+#if ENABLE(DFG_JIT)
+
+namespace JSC { namespace DFG {
+
+class Graph;
+
+// Replaces the bounds checks of counted loops with range checks at the loop pre-header. A
+// CheckInBounds qualifies if it runs on every iteration, its length is loop invariant, and its
+// index is an affine function of the induction variable, such as
+//
+// for (var i = 0; i < n; ++i)
+//     result += a[2 * i] + a[2 * i + 1];
+//
+// Then the smallest and largest index the loop can use are checked once, before the loop. If
+// that check fails we exit before entering the loop; if it keeps failing, we stop doing this
+// for that loop.
+//
+// Loads from Int32, Double and Contiguous arrays get the same treatment for holes. If the loop
+// can't create holes and the storage is loop invariant, a CheckNoHolesInRange before the loop
+// scans the range the loop loads from, and the loads become Array::HoleFree. This is only done
+// for loops that exit from their latch, so that the scan never reads more than the loop would.
+//
+// The loop body is left without bounds check and hole check exits, which is what lets LLVM
+// vectorize it and Polly model it.
+
+bool performLoopPredication(Graph&);
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGLoopPredicationPhase_h
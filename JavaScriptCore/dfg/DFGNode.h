@@ -1613,6 +1613,7 @@ struct Node {
         case ArrayPush:
         case ArrayPop:
         case HasIndexedProperty:
+        case CheckNoHolesInRange:
             return true;
         default:
             return false;
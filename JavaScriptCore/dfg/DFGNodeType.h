@@ -221,6 +221,7 @@ namespace JSC { namespace DFG {
     macro(CheckNotEmpty, NodeMustGenerate) \
     macro(CheckBadCell, NodeMustGenerate) \
     macro(CheckInBounds, NodeMustGenerate) \
+    macro(CheckNoHolesInRange, NodeMustGenerate) \
     macro(CheckIdent, NodeMustGenerate) \
     \
     /* Optimizations for array mutation. */\
@@ -39,7 +39,11 @@ namespace JSC { namespace DFG {
 void handleExitCounts(CCallHelpers& jit, const OSRExitBase& exit)
 {
     jit.add32(AssemblyHelpers::TrustedImm32(1), AssemblyHelpers::AbsoluteAddress(&exit.m_count));
-    
+    handleExitCountsOfCountedExit(jit, exit);
+}
+
+void handleExitCountsOfCountedExit(CCallHelpers& jit, const OSRExitBase& exit)
+{
     jit.move(AssemblyHelpers::TrustedImmPtr(jit.codeBlock()), GPRInfo::regT0);
     
     AssemblyHelpers::Jump tooFewFails;
@@ -34,6 +34,9 @@
 namespace JSC { namespace DFG {
 
 void handleExitCounts(CCallHelpers&, const OSRExitBase&);
+// Like handleExitCounts(), for exit code that has already counted the exit in exit.m_count. The
+// exit that is passed in only needs to have the right code origin.
+void handleExitCountsOfCountedExit(CCallHelpers&, const OSRExitBase&);
 void reifyInlinedCallFrames(CCallHelpers&, const OSRExitBase&);
 void adjustAndJumpToTarget(CCallHelpers&, const OSRExitBase&, bool isExitingToOpCatch);
 
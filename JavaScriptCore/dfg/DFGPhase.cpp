@@ -46,16 +46,21 @@ void Phase::beginPhase()
         m_graphDumpBeforePhase = out.toCString();
     }
     
-    if (!shouldDumpGraphAtEachPhase())
-        return;
-    
-    dataLog("Beginning DFG phase ", m_name, ".\n");
-    dataLog("Before ", m_name, ":\n");
-    m_graph.dump();
+    if (shouldDumpGraphAtEachPhase()) {
+        dataLog("Beginning DFG phase ", m_name, ".\n");
+        dataLog("Before ", m_name, ":\n");
+        m_graph.dump();
+    }
+
+    if (m_graph.m_plan.phaseTimes())
+        m_timeBeforePhase = monotonicallyIncreasingTimeMS();
 }
 
 void Phase::endPhase()
 {
+    if (PhaseTimes* phaseTimes = m_graph.m_plan.phaseTimes())
+        phaseTimes->add(m_name, monotonicallyIncreasingTimeMS() - m_timeBeforePhase);
+
     if (!Options::validateGraphAtEachPhase())
         return;
     validate();
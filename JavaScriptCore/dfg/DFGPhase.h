@@ -72,6 +72,7 @@ private:
     void endPhase();
     
     CString m_graphDumpBeforePhase;
+    double m_timeBeforePhase { 0 };
 };
 
 template<typename PhaseType>
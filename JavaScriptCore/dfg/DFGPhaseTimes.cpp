@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "DFGPhaseTimes.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "Options.h"
+#include <wtf/Deque.h>
+#include <wtf/Lock.h>
+#include <wtf/MathExtras.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/StringPrintStream.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC { namespace DFG {
+
+void PhaseTimes::add(const CString& name, double milliseconds)
+{
+    for (Entry& entry : m_entries) {
+        if (entry.name == name) {
+            entry.milliseconds += milliseconds;
+            return;
+        }
+    }
+    m_entries.append(Entry { name, milliseconds });
+}
+
+namespace {
+
+// Bucket i counts the compiles that took less than 2^(i - 2) ms, and the last bucket counts
+// everything slower than that.
+const unsigned numHistogramBuckets = 20;
+
+double histogramBucketLimit(unsigned bucket)
+{
+    return ldexp(1, static_cast<int>(bucket) - 2);
+}
+
+struct CompileRecord {
+    CString codeBlockName;
+    CompilationMode mode;
+    const char* pathName;
+    double milliseconds;
+    PhaseTimes phases;
+};
+
+struct CompileTimes {
+    Lock lock;
+    Deque<CompileRecord> recentCompiles;
+    unsigned histograms[2][numHistogramBuckets] { };
+    PhaseTimes phaseTotals;
+};
+
+CompileTimes& compileTimes()
+{
+    static NeverDestroyed<CompileTimes> compileTimes;
+    return compileTimes;
+}
+
+void appendQuoted(StringBuilder& builder, const CString& string)
+{
+    builder.appendQuotedJSONString(String::fromUTF8(string.data()));
+}
+
+void appendPhases(StringBuilder& builder, const PhaseTimes& phases)
+{
+    builder.append('{');
+    bool first = true;
+    for (const PhaseTimes::Entry& entry : phases.entries()) {
+        if (!first)
+            builder.append(',');
+        first = false;
+        appendQuoted(builder, entry.name);
+        builder.append(':');
+        builder.appendNumber(entry.milliseconds);
+    }
+    builder.append('}');
+}
+
+} // anonymous namespace
+
+void recordCompileTimes(
+    const CString& codeBlockName, CompilationMode mode, const char* pathName, double milliseconds,
+    const PhaseTimes& phases)
+{
+    CompileTimes& times = compileTimes();
+    LockHolder locker(times.lock);
+
+    if (Options::maximumRecordedCompileTimes()) {
+        while (times.recentCompiles.size() >= Options::maximumRecordedCompileTimes())
+            times.recentCompiles.removeFirst();
+        times.recentCompiles.append(CompileRecord { codeBlockName, mode, pathName, milliseconds, phases });
+    }
+
+    unsigned bucket = 0;
+    while (bucket < numHistogramBuckets - 1 && milliseconds >= histogramBucketLimit(bucket))
+        bucket++;
+    times.histograms[isFTL(mode)][bucket]++;
+
+    for (const PhaseTimes::Entry& entry : phases.entries())
+        times.phaseTotals.add(entry.name, entry.milliseconds);
+}
+
+String compileTimesJSON()
+{
+    CompileTimes& times = compileTimes();
+    LockHolder locker(times.lock);
+
+    StringBuilder builder;
+    builder.appendLiteral("{\"compiles\":[");
+    bool first = true;
+    for (const CompileRecord& record : times.recentCompiles) {
+        if (!first)
+            builder.append(',');
+        first = false;
+        builder.appendLiteral("{\"codeBlock\":");
+        appendQuoted(builder, record.codeBlockName);
+        builder.appendLiteral(",\"mode\":");
+        appendQuoted(builder, toCString(record.mode));
+        builder.appendLiteral(",\"path\":");
+        appendQuoted(builder, record.pathName);
+        builder.appendLiteral(",\"milliseconds\":");
+        builder.appendNumber(record.milliseconds);
+        builder.appendLiteral(",\"phases\":");
+        appendPhases(builder, record.phases);
+        builder.append('}');
+    }
+
+    builder.appendLiteral("],\"histograms\":{");
+    for (unsigned tier = 0; tier < 2; ++tier) {
+        if (tier)
+            builder.appendLiteral(",\"FTL\":[");
+        else
+            builder.appendLiteral("\"DFG\":[");
+        for (unsigned bucket = 0; bucket < numHistogramBuckets; ++bucket) {
+            if (bucket)
+                builder.append(',');
+            builder.appendLiteral("{\"upToMilliseconds\":");
+            if (bucket == numHistogramBuckets - 1)
+                builder.appendLiteral("null");
+            else
+                builder.appendNumber(histogramBucketLimit(bucket));
+            builder.appendLiteral(",\"count\":");
+            builder.appendNumber(times.histograms[tier][bucket]);
+            builder.append('}');
+        }
+        builder.append(']');
+    }
+
+    builder.appendLiteral("},\"phaseTotals\":");
+    appendPhases(builder, times.phaseTotals);
+    builder.append('}');
+    return builder.toString();
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef DFGPhaseTimes_h
+#define DFGPhaseTimes_h
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGCompilationMode.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC { namespace DFG {
+
+// How long one DFG or FTL compile spent in each of its phases: every DFG phase, FTL lowering,
+// every LLVM pass, Polly, machine code generation, stackmap processing and linking. Phases
+// that run more than once are added up, and are listed in the order in which they first ran.
+class PhaseTimes {
+public:
+    struct Entry {
+        CString name;
+        double milliseconds;
+    };
+
+    void add(const CString& name, double milliseconds);
+
+    const Vector<Entry>& entries() const { return m_entries; }
+
+private:
+    Vector<Entry> m_entries;
+};
+
+// Adds the time spent in its scope to a PhaseTimes, if it was given one.
+class PhaseTimer {
+public:
+    PhaseTimer(PhaseTimes* times, const char* name)
+        : m_times(times)
+        , m_name(name)
+        , m_before(times ? monotonicallyIncreasingTimeMS() : 0)
+    {
+    }
+
+    ~PhaseTimer()
+    {
+        if (m_times)
+            m_times->add(m_name, monotonicallyIncreasingTimeMS() - m_before);
+    }
+
+private:
+    PhaseTimes* m_times;
+    const char* m_name;
+    double m_before;
+};
+
+// Keeps the phase times of recent compiles, and per-tier histograms of how long compiles took
+// and totals for every phase over the life of the process. Thread safe.
+void recordCompileTimes(
+    const CString& codeBlockName, CompilationMode, const char* pathName, double milliseconds,
+    const PhaseTimes&);
+
+// {"compiles": [{"codeBlock", "mode", "path", "milliseconds", "phases": {name: milliseconds}}],
+//  "histograms": {"DFG" or "FTL": [{"upToMilliseconds", "count"}]},
+//  "phaseTotals": {name: milliseconds}}
+JS_EXPORT_PRIVATE String compileTimesJSON();
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGPhaseTimes_h
@@ -47,6 +47,7 @@
 #include "DFGFixupPhase.h"
 #include "DFGGraphSafepoint.h"
 #include "DFGIntegerCheckCombiningPhase.h"
+#include "DFGInductionVariableOverflowEliminationPhase.h"
 #include "DFGIntegerRangeOptimizationPhase.h"
 #include "DFGInvalidationPointInjectionPhase.h"
 #include "DFGJITCompiler.h"
@@ -54,12 +55,14 @@
 #include "DFGLiveCatchVariablePreservationPhase.h"
 #include "DFGLivenessAnalysisPhase.h"
 #include "DFGLoopPreHeaderCreationPhase.h"
+#include "DFGLoopPredicationPhase.h"
 #include "DFGMaximalFlushInsertionPhase.h"
 #include "DFGMovHintRemovalPhase.h"
 #include "DFGOSRAvailabilityAnalysisPhase.h"
 #include "DFGOSREntrypointCreationPhase.h"
 #include "DFGObjectAllocationSinkingPhase.h"
 #include "DFGPhantomInsertionPhase.h"
+#include "DFGPhaseTimes.h"
 #include "DFGPredictionInjectionPhase.h"
 #include "DFGPredictionPropagationPhase.h"
 #include "DFGPutStackSinkingPhase.h"
@@ -90,6 +93,9 @@
 #include "FTLFail.h"
 #include "FTLLink.h"
 #include "FTLLowerDFGToLLVM.h"
+#include "FTLPollyCache.h"
+#include "FTLPollyFunctionOverrides.h"
+#include "FTLPollyPolicy.h"
 #include "FTLState.h"
 #include "InitializeLLVM.h"
 #endif
@@ -132,6 +138,8 @@ Profiler::CompilationKind profilerCompilationKindForMode(CompilationMode mode)
         return Profiler::FTL;
     case FTLForOSREntryMode:
         return Profiler::FTLForOSREntry;
+    case FTLForPollyMode:
+        return Profiler::FTLForPolly;
     }
     RELEASE_ASSERT_NOT_REACHED();
     return Profiler::DFG;
@@ -153,8 +161,14 @@ Plan::Plan(CodeBlock* passedCodeBlock, CodeBlock* profiledDFGCodeBlock,
     , identifiers(codeBlock)
     , weakReferences(codeBlock)
     , willTryToTierUp(false)
+    , pollyOverride(nullptr)
     , stage(Preparing)
+    , m_withPolly(false)
 {
+#if ENABLE(FTL_JIT)
+    if (isFTL(mode))
+        pollyOverride = FTL::PollyFunctionOverrides::ensureGlobalOverrides().find(codeBlock);
+#endif
 }
 
 Plan::~Plan()
@@ -164,7 +178,8 @@ Plan::~Plan()
 bool Plan::computeCompileTimes() const
 {
     return reportCompileTimes()
-        || Options::reportTotalCompileTimes();
+        || Options::reportTotalCompileTimes()
+        || Options::recordCompileTimes();
 }
 
 bool Plan::reportCompileTimes() const
@@ -173,6 +188,29 @@ bool Plan::reportCompileTimes() const
         || (Options::reportFTLCompileTimes() && isFTL(mode));
 }
 
+PhaseTimes* Plan::phaseTimes()
+{
+    if (!Options::recordCompileTimes())
+        return nullptr;
+    return &m_phaseTimes;
+}
+
+const char* Plan::pathName(CompilationPath path)
+{
+    switch (path) {
+    case FailPath:
+        return "N/A (fail)";
+    case DFGPath:
+        return "DFG";
+    case FTLPath:
+        return "FTL";
+    case CancelPath:
+        return "Cancelled";
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return "";
+}
+
 void Plan::compileInThread(LongLivedState& longLivedState, ThreadData* threadData)
 {
     this->threadData = threadData;
@@ -181,7 +219,7 @@ void Plan::compileInThread(LongLivedState& longLivedState, ThreadData* threadDat
     CString codeBlockName;
     if (computeCompileTimes())
         before = monotonicallyIncreasingTimeMS();
-    if (reportCompileTimes())
+    if (reportCompileTimes() || Options::recordCompileTimes())
         codeBlockName = toCString(*codeBlock);
     
     SamplingRegion samplingRegion("DFG Compilation (Plan)");
@@ -202,15 +240,15 @@ void Plan::compileInThread(LongLivedState& longLivedState, ThreadData* threadDat
     if (Options::reportTotalCompileTimes()) {
         if (isFTL(mode)) {
             totalFTLCompileTime += after - before;
-            totalFTLDFGCompileTime += m_timeBeforeFTL - before;
 
             // JSCPOLLY BEGIN
-            if (Options::jscpolly()) {
-            	totalFTLLLVMCompileTime += m_timeBeforeLoweringFTLPolly - m_timeBeforeFTL;
-                totalFTLDFGPollyCompileTime += m_timeBeforeFTLPolly - m_timeBeforeLoweringFTLPolly;
-            	totalFTLLLVMPollyCompileTime += after - m_timeBeforeFTLPolly;
+            // Compiles that the polly policy selected are accounted separately.
+            if (m_withPolly) {
+                totalFTLDFGPollyCompileTime += m_timeBeforeFTL - before;
+                totalFTLLLVMPollyCompileTime += after - m_timeBeforeFTL;
             } else {
-            	totalFTLLLVMCompileTime += after - m_timeBeforeFTL;
+                totalFTLDFGCompileTime += m_timeBeforeFTL - before;
+                totalFTLLLVMCompileTime += after - m_timeBeforeFTL;
             }
             // JSCPOLLY END
 
@@ -218,29 +256,11 @@ void Plan::compileInThread(LongLivedState& longLivedState, ThreadData* threadDat
             totalDFGCompileTime += after - before;
     }
     
+    if (Options::recordCompileTimes())
+        recordCompileTimes(codeBlockName, mode, pathName(path), after - before, m_phaseTimes);
+
     if (reportCompileTimes()) {
-        const char* pathName;
-        switch (path) {
-        case FailPath:
-            pathName = "N/A (fail)";
-            break;
-        case DFGPath:
-            pathName = "DFG";
-            break;
-        case FTLPath:
-            pathName = "FTL";
-            break;
-        case CancelPath:
-            pathName = "Cancelled";
-            break;
-        default:
-            RELEASE_ASSERT_NOT_REACHED();
-#if COMPILER_QUIRK(CONSIDERS_UNREACHABLE_CODE)
-            pathName = "";
-#endif
-            break;
-        }
-        dataLog("Optimized ", codeBlockName, " using ", mode, " with ", pathName, " into ", finalizer ? finalizer->codeSize() : 0, " bytes in ", after - before, " ms");
+        dataLog("Optimized ", codeBlockName, " using ", mode, " with ", pathName(path), " into ", finalizer ? finalizer->codeSize() : 0, " bytes in ", after - before, " ms");
         if (path == FTLPath)
             dataLog(" (DFG: ", m_timeBeforeFTL - before, ", LLVM: ", after - m_timeBeforeFTL, ")");
         dataLog(".\n");
@@ -384,6 +404,7 @@ Plan::CompilationPath Plan::compileInThreadImpl(LongLivedState& longLivedState)
         performWatchpointCollection(dfg);
         dumpAndVerifyGraph(dfg, "Graph after optimization:");
         
+        PhaseTimer backendTimer(phaseTimes(), "DFG backend");
         JITCompiler dataFlowJIT(dfg);
         if (codeBlock->codeType() == FunctionCode)
             dataFlowJIT.compileFunction();
@@ -394,7 +415,8 @@ Plan::CompilationPath Plan::compileInThreadImpl(LongLivedState& longLivedState)
     }
     
     case FTLMode:
-    case FTLForOSREntryMode: {
+    case FTLForOSREntryMode:
+    case FTLForPollyMode: {
 #if ENABLE(FTL_JIT)
         if (FTL::canCompile(dfg) == FTL::CannotCompile) {
             finalizer = std::make_unique<FailedFinalizer>(*this);
@@ -418,6 +440,10 @@ Plan::CompilationPath Plan::compileInThreadImpl(LongLivedState& longLivedState)
         performGlobalCSE(dfg);
         performLivenessAnalysis(dfg);
         performIntegerRangeOptimization(dfg);
+        if (Options::useInductionVariableOverflowElimination())
+            performInductionVariableOverflowElimination(dfg);
+        if (Options::useLoopPredication())
+            performLoopPredication(dfg);
         performLivenessAnalysis(dfg);
         performCFA(dfg);
         performConstantFolding(dfg);
@@ -493,8 +519,54 @@ Plan::CompilationPath Plan::compileInThreadImpl(LongLivedState& longLivedState)
         // JSCPOLLY COMMENT
         // FTL compilation really starts here
 
-        FTL::State state(Options::jscpolly(), Options::jscpollyNo(), dfg);
-        FTL::lowerDFGToLLVM(state);
+        // With the background polly tier, functions the policy selects first get plain FTL
+        // code that counts loop iterations, and are recompiled with polly in FTLForPollyMode
+        // once they have looped long enough. Polly is an LLVM pass, so B3 never wants it.
+#if FTL_USES_B3
+        bool wantsPolly = false;
+#else
+        bool wantsPolly = mode == FTLForPollyMode || FTL::shouldCompileWithPolly(dfg);
+#endif
+        bool pollyKnownToOptimize = false;
+#if !FTL_USES_B3
+        // Don't pay for Polly again on a function it could do nothing for in an earlier run. A
+        // function it did optimize skips the background tier instead: there is no point in
+        // compiling it without Polly first and waiting for its loops to get hot.
+        CString pollyCacheKey;
+        if (wantsPolly && !Options::jscpollyNo()) {
+            pollyCacheKey = FTL::pollyCacheKey(dfg);
+            switch (FTL::cachedPollyOutcome(pollyCacheKey)) {
+            case FTL::PollyOutcome::Unknown:
+                break;
+            case FTL::PollyOutcome::NothingOptimized:
+                wantsPolly = false;
+                break;
+            case FTL::PollyOutcome::Optimized:
+                pollyKnownToOptimize = true;
+                break;
+            }
+        }
+#endif
+        m_withPolly = wantsPolly
+            && (mode == FTLForPollyMode || !Options::jscpollyBackgroundTier() || pollyKnownToOptimize);
+        FTL::State state(m_withPolly, Options::jscpollyNo(), dfg);
+#if !FTL_USES_B3
+        if (m_withPolly)
+            state.pollyCacheKey = pollyCacheKey;
+#endif
+        if (wantsPolly && !m_withPolly)
+            state.jitCode->initializePollyTierUpCounter();
+        {
+            PhaseTimer loweringTimer(phaseTimes(), "FTL lowering");
+            FTL::lowerDFGToLLVM(state);
+        }
+
+#if FTL_USES_B3
+        if (state.loweringFailed) {
+            FTL::fail(state);
+            return FTLPath;
+        }
+#endif
         
         if (computeCompileTimes())
             m_timeBeforeFTL = monotonicallyIncreasingTimeMS();
@@ -525,60 +597,16 @@ Plan::CompilationPath Plan::compileInThreadImpl(LongLivedState& longLivedState)
         }
 #endif
 
-        FTL::link(state);
+        {
+            PhaseTimer linkTimer(phaseTimes(), "FTL link");
+            FTL::link(state);
+        }
         
         if (state.allocationFailed) {
             FTL::fail(state);
             return FTLPath;
         }
         
-//        // JSCPOLLY BEGIN
-//        // The following compile another version with polly
-//        if (Options::jscpolly()) {
-//
-//			if (computeCompileTimes())
-//				m_timeBeforeLoweringFTLPolly = monotonicallyIncreasingTimeMS();
-//
-//			FTL::State statePolly(true, dfg);
-//			FTL::lowerDFGToLLVM(statePolly);
-//
-//			if (computeCompileTimes())
-//				m_timeBeforeFTLPolly = monotonicallyIncreasingTimeMS();
-//
-//			if (Options::llvmAlwaysFailsBeforeCompile()) {
-//				FTL::fail(statePolly);
-//				return FTLPath;
-//			}
-//
-//			FTL::compile(statePolly, safepointResult);
-//			if (safepointResult.didGetCancelled())
-//				return CancelPath;
-//
-//			if (Options::llvmAlwaysFailsBeforeLink()) {
-//				FTL::fail(statePolly);
-//				return FTLPath;
-//			}
-//
-//			if (statePolly.allocationFailed) {
-//				FTL::fail(statePolly);
-//				return FTLPath;
-//			}
-//
-//#if !FTL_USES_B3
-//			if (statePolly.jitCode->stackmaps.stackSize() > Options::llvmMaxStackSize()) {
-//				FTL::fail(statePolly);
-//				return FTLPath;
-//			}
-//#endif
-//
-//			FTL::link(statePolly);
-//
-//			if (statePolly.allocationFailed) {
-//				FTL::fail(statePolly);
-//				return FTLPath;
-//			}
-//        }
-//        // JSCPOLLY END
 
         return FTLPath;
 #else
@@ -34,6 +34,7 @@
 #include "DFGDesiredWatchpoints.h"
 #include "DFGDesiredWeakReferences.h"
 #include "DFGFinalizer.h"
+#include "DFGPhaseTimes.h"
 #include "DeferredCompilationCallback.h"
 #include "Operands.h"
 #include "ProfilerCompilation.h"
@@ -46,6 +47,10 @@ namespace JSC {
 class CodeBlock;
 class SlotVisitor;
 
+namespace FTL {
+struct PollyFunctionOverride;
+}
+
 namespace DFG {
 
 class LongLivedState;
@@ -100,6 +105,11 @@ struct Plan : public ThreadSafeRefCounted<Plan> {
     
     bool willTryToTierUp;
 
+    // JSCPOLLY COMMENT
+    // The jscpollyFunctionOverrides settings of the function being compiled, if it has any.
+    // They are looked up when the plan is created, on the main thread.
+    const FTL::PollyFunctionOverride* pollyOverride;
+
     enum Stage { Preparing, Compiling, Compiled, Ready, Cancelled };
     Stage stage;
 
@@ -107,27 +117,30 @@ struct Plan : public ThreadSafeRefCounted<Plan> {
 
     JS_EXPORT_PRIVATE static HashMap<CString, double> compileTimeStats();
 
+    // Where the phases of this compile should add their times, or null if compile times are
+    // not being recorded.
+    PhaseTimes* phaseTimes();
+
 private:
     bool computeCompileTimes() const;
     bool reportCompileTimes() const;
     
     enum CompilationPath { FailPath, DFGPath, FTLPath, CancelPath };
+    static const char* pathName(CompilationPath);
     CompilationPath compileInThreadImpl(LongLivedState&);
     
     bool isStillValid();
     void reallyAdd(CommonData*);
 
     // JSCPOLLY COMMENT
-    // time before compiling LLVM IR but after lowering DFG to FTL
-    double m_timeBeforeFTL;
+    // whether the polly policy selected this FTL compile to run the polly passes
+    bool m_withPolly;
 
     // JSCPOLLY COMMENT
-    // time before compiling lowering LLVM IR with polly but after compiling without polly
-    double m_timeBeforeLoweringFTLPolly;
+    // time before compiling LLVM IR but after lowering DFG to FTL
+    double m_timeBeforeFTL;
 
-    // JSCPOLLY COMMENT
-    // time before compiling LLVM IR with polly
-    double m_timeBeforeFTLPolly;
+    PhaseTimes m_phaseTimes;
 };
 
 #else // ENABLE(DFG_JIT)
@@ -546,6 +546,7 @@ private:
         case CheckTierUpWithNestedTriggerAndOSREnter:
         case InvalidationPoint:
         case CheckInBounds:
+        case CheckNoHolesInRange:
         case ValueToInt32:
         case DoubleRep:
         case ValueRep:
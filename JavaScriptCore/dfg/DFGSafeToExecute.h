@@ -330,6 +330,10 @@ bool safeToExecute(AbstractStateType& state, Graph& graph, Node* node)
         // compiling this node.
         return false;
 
+    case CheckNoHolesInRange:
+        // This reads through the storage without knowing what kind of butterfly it points to.
+        return false;
+
     case GetByVal:
     case GetIndexedPropertyStorage:
     case GetArrayLength:
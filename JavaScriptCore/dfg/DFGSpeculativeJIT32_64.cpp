@@ -4832,6 +4832,7 @@ void SpeculativeJIT::compile(Node* node)
     case FiatInt52:
     case Int52Constant:
     case CheckInBounds:
+    case CheckNoHolesInRange:
     case ArithIMul:
     case MultiGetByOffset:
     case MultiPutByOffset:
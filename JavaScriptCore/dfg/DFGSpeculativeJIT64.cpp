@@ -4881,6 +4881,7 @@ void SpeculativeJIT::compile(Node* node)
     case Upsilon:
     case ExtractOSREntryLocal:
     case CheckInBounds:
+    case CheckNoHolesInRange:
     case ArithIMul:
     case MultiGetByOffset:
     case MultiPutByOffset:
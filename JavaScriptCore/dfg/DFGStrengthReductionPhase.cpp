@@ -132,7 +132,7 @@ private:
                 case Int32Use:
                     // For integers, we can only convert compatible modes.
                     // ArithAdd does handle do negative zero check for example.
-                    if (m_node->arithMode() == Arith::CheckOverflow || m_node->arithMode() == Arith::Unchecked) {
+                    if (m_node->arithMode() == Arith::CheckOverflow || m_node->arithMode() == Arith::Unchecked || m_node->arithMode() == Arith::ProvedNoOverflow) {
                         m_node->setOp(ArithAdd);
                         child2.setNode(m_node->child1().node());
                         m_changed = true;
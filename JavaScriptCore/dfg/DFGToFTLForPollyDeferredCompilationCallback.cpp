@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "DFGToFTLForPollyDeferredCompilationCallback.h"
+
+#if ENABLE(FTL_JIT)
+
+#include "CodeBlock.h"
+#include "Executable.h"
+#include "FTLJITCode.h"
+#include "JSCInlines.h"
+
+namespace JSC { namespace DFG {
+
+ToFTLForPollyDeferredCompilationCallback::ToFTLForPollyDeferredCompilationCallback(CodeBlock* replacedFTLCodeBlock)
+    : m_replacedFTLCodeBlock(replacedFTLCodeBlock)
+{
+}
+
+ToFTLForPollyDeferredCompilationCallback::~ToFTLForPollyDeferredCompilationCallback() { }
+
+Ref<ToFTLForPollyDeferredCompilationCallback> ToFTLForPollyDeferredCompilationCallback::create(CodeBlock* replacedFTLCodeBlock)
+{
+    return adoptRef(*new ToFTLForPollyDeferredCompilationCallback(replacedFTLCodeBlock));
+}
+
+void ToFTLForPollyDeferredCompilationCallback::compilationDidBecomeReadyAsynchronously(
+    CodeBlock* codeBlock, CodeBlock* profiledFTLCodeBlock)
+{
+    if (Options::verboseOSR()) {
+        dataLog(
+            "Polly compilation of ", *codeBlock, " (for ", *profiledFTLCodeBlock,
+            ") did become ready.\n");
+    }
+    
+    profiledFTLCodeBlock->jitCode()->ftl()->forcePollyTierUpSlowPathConcurrently();
+}
+
+void ToFTLForPollyDeferredCompilationCallback::compilationDidComplete(
+    CodeBlock* codeBlock, CodeBlock* profiledFTLCodeBlock, CompilationResult result)
+{
+    if (Options::verboseOSR()) {
+        dataLog(
+            "Polly compilation of ", *codeBlock, " (for ", *profiledFTLCodeBlock,
+            ") result: ", result, "\n");
+    }
+    
+    // The FTL code block we were going to replace may have been jettisoned, and maybe replaced
+    // by newer FTL code. We only compare pointers, since it may also be dead by now. That FTL
+    // code block was marked as having triggered the tier-up, and newer ones aren't marked while
+    // this compile is pending, so an FTL code block that reuses its address doesn't match.
+    CodeBlock* currentReplacement = codeBlock->baselineVersion()->replacement();
+    if (currentReplacement != m_replacedFTLCodeBlock
+        || currentReplacement->jitType() != JSC::JITCode::FTLJIT
+        || !currentReplacement->jitCode()->ftl()->didTriggerPollyTierUp) {
+        if (Options::verboseOSR()) {
+            dataLog(
+                "Dropping polly code block ", *codeBlock, " on the floor because the "
+                "FTL code block it was for, which ", *profiledFTLCodeBlock, " profiled, was "
+                "jettisoned.\n");
+        }
+        return;
+    }
+    
+    if (result == CompilationSuccessful)
+        codeBlock->ownerScriptExecutable()->installCode(codeBlock);
+
+    DeferredCompilationCallback::compilationDidComplete(codeBlock, profiledFTLCodeBlock, result);
+}
+
+} } // JSC::DFG
+
+#endif // ENABLE(FTL_JIT)
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef DFGToFTLForPollyDeferredCompilationCallback_h
+#define DFGToFTLForPollyDeferredCompilationCallback_h
+
+#if ENABLE(FTL_JIT)
+
+#include "DeferredCompilationCallback.h"
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
+
+namespace JSC {
+
+class ScriptExecutable;
+
+namespace DFG {
+
+// JSCPOLLY COMMENT
+// Installs the result of an FTLForPollyMode compile, whose profiled code block is the
+// plain FTL code block that triggered it. That may be an FTL OSR entry code block, in which
+// case the polly code replaces the FTL code block that was the replacement when it triggered.
+// Either way, the polly code is only installed if that FTL code block is still the
+// replacement, so that it never replaces newer FTL code with code built from older profiling.
+class ToFTLForPollyDeferredCompilationCallback : public DeferredCompilationCallback {
+protected:
+    ToFTLForPollyDeferredCompilationCallback(CodeBlock* replacedFTLCodeBlock);
+
+public:
+    virtual ~ToFTLForPollyDeferredCompilationCallback();
+
+    static Ref<ToFTLForPollyDeferredCompilationCallback> create(CodeBlock* replacedFTLCodeBlock);
+    
+    virtual void compilationDidBecomeReadyAsynchronously(CodeBlock*, CodeBlock* profiledFTLCodeBlock);
+    virtual void compilationDidComplete(CodeBlock*, CodeBlock* profiledFTLCodeBlock, CompilationResult);
+
+private:
+    CodeBlock* m_replacedFTLCodeBlock;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(FTL_JIT)
+
+#endif // DFGToFTLForPollyDeferredCompilationCallback_h
@@ -453,6 +453,7 @@ private:
                 case Phi:
                 case Upsilon:
                 case CheckInBounds:
+                case CheckNoHolesInRange:
                 case PhantomNewObject:
                 case PhantomNewFunction:
                 case PhantomCreateActivation:
@@ -96,7 +96,10 @@ void Worklist::enqueue(PassRefPtr<Plan> passedPlan)
     }
     ASSERT(m_plans.find(plan->key()) == m_plans.end());
     m_plans.add(plan->key(), plan);
-    m_queue.append(plan);
+    if (plan->mode == FTLForPollyMode)
+        m_lowPriorityQueue.append(plan);
+    else
+        m_queue.append(plan);
     m_planEnqueued.notifyOne();
 }
 
@@ -281,6 +284,13 @@ void Worklist::removeDeadPlans(VM& vm)
                     newQueue.append(plan);
             }
             m_queue.swap(newQueue);
+            Deque<RefPtr<Plan>> newLowPriorityQueue;
+            while (!m_lowPriorityQueue.isEmpty()) {
+                RefPtr<Plan> plan = m_lowPriorityQueue.takeFirst();
+                if (plan->stage != Plan::Cancelled)
+                    newLowPriorityQueue.append(plan);
+            }
+            m_lowPriorityQueue.swap(newLowPriorityQueue);
             for (unsigned i = 0; i < m_readyPlans.size(); ++i) {
                 if (m_readyPlans[i]->stage != Plan::Cancelled)
                     continue;
@@ -307,7 +317,7 @@ void Worklist::removeDeadPlans(VM& vm)
 size_t Worklist::queueLength()
 {
     LockHolder locker(m_lock);
-    return m_queue.size();
+    return m_queue.size() + m_lowPriorityQueue.size();
 }
 
 void Worklist::dump(PrintStream& out) const
@@ -320,6 +330,7 @@ void Worklist::dump(const LockHolder&, PrintStream& out) const
 {
     out.print(
         "Worklist(", RawPointer(this), ")[Queue Length = ", m_queue.size(),
+        ", Low Priority Queue Length = ", m_lowPriorityQueue.size(),
         ", Map Size = ", m_plans.size(), ", Num Ready = ", m_readyPlans.size(),
         ", Num Active Threads = ", m_numberOfActiveThreads, "/", m_threads.size(), "]");
 }
@@ -337,10 +348,13 @@ void Worklist::runThread(ThreadData* data)
         RefPtr<Plan> plan;
         {
             LockHolder locker(m_lock);
-            while (m_queue.isEmpty())
+            while (m_queue.isEmpty() && m_lowPriorityQueue.isEmpty())
                 m_planEnqueued.wait(m_lock);
             
-            plan = m_queue.takeFirst();
+            if (!m_queue.isEmpty())
+                plan = m_queue.takeFirst();
+            else
+                plan = m_lowPriorityQueue.takeFirst();
             if (plan)
                 m_numberOfActiveThreads++;
         }
@@ -453,6 +467,7 @@ Worklist* ensureGlobalWorklistFor(CompilationMode mode)
         return ensureGlobalDFGWorklist();
     case FTLMode:
     case FTLForOSREntryMode:
+    case FTLForPollyMode:
         return ensureGlobalFTLWorklist();
     }
     RELEASE_ASSERT_NOT_REACHED();
@@ -93,6 +93,11 @@ private:
     
     // Used to inform the thread about what work there is left to do.
     Deque<RefPtr<Plan>> m_queue;
+
+    // JSCPOLLY COMMENT
+    // Background polly recompiles. Threads only take work from here when m_queue is
+    // empty, so that they never delay getting first FTL code for something else.
+    Deque<RefPtr<Plan>> m_lowPriorityQueue;
     
     // Used to answer questions about the current state of a code block. This
     // is particularly great for the cti_optimize OSR slow path, which wants
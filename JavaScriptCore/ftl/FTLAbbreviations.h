@@ -214,7 +214,10 @@ static inline LValue buildPhi(
 static inline LValue buildAlloca(LBuilder builder, LType type) { return llvm->BuildAlloca(builder, type, ""); }
 static inline LValue buildAdd(LBuilder builder, LValue left, LValue right) { return llvm->BuildAdd(builder, left, right, ""); }
 static inline LValue buildSub(LBuilder builder, LValue left, LValue right) { return llvm->BuildSub(builder, left, right, ""); }
+static inline LValue buildNSWAdd(LBuilder builder, LValue left, LValue right) { return llvm->BuildNSWAdd(builder, left, right, ""); }
+static inline LValue buildNSWSub(LBuilder builder, LValue left, LValue right) { return llvm->BuildNSWSub(builder, left, right, ""); }
 static inline LValue buildMul(LBuilder builder, LValue left, LValue right) { return llvm->BuildMul(builder, left, right, ""); }
+static inline LValue buildNSWMul(LBuilder builder, LValue left, LValue right) { return llvm->BuildNSWMul(builder, left, right, ""); }
 static inline LValue buildDiv(LBuilder builder, LValue left, LValue right) { return llvm->BuildSDiv(builder, left, right, ""); }
 static inline LValue buildRem(LBuilder builder, LValue left, LValue right) { return llvm->BuildSRem(builder, left, right, ""); }
 static inline LValue buildNeg(LBuilder builder, LValue value) { return llvm->BuildNeg(builder, value, ""); }
@@ -251,6 +254,7 @@ static inline LValue buildInsertElement(LBuilder builder, LValue vector, LValue
 // JSCPOLLY BEGIN
 // Generate a GetElementPtr to access an array
 static inline LValue buildGEP(LBuilder builder, LValue Pointer, LValue *Indices, unsigned NumIndices) { return llvm->BuildGEP(builder, Pointer, Indices, NumIndices, ""); }
+static inline LValue buildInBoundsGEP(LBuilder builder, LValue Pointer, LValue *Indices, unsigned NumIndices) { return llvm->BuildInBoundsGEP(builder, Pointer, Indices, NumIndices, ""); }
 // JSCPOLLY END
 
 static inline LValue buildFence(LBuilder builder, LAtomicOrdering ordering, SynchronizationScope scope = CrossThread)
@@ -153,15 +153,6 @@ TypedPointer IndexedAbstractHeap::baseIndex(Output& out, LValue base, LValue ind
     return TypedPointer(atAnyIndex(), out.addPtr(result, m_offset + offset));
 }
 
-// Get a pointer to the base of the array
-TypedPointer IndexedAbstractHeap::baseArray(Output& out, LValue base, LValue index, JSValue indexAsConstant)
-{
-	// The size is not checked by LLVM here
-	LValue result = out.intToPtr(base, pointerType(arrayType(out.int64, 10000000)));
-
-	return TypedPointer(atAnyIndex(), result);
-}
-
 const AbstractField& IndexedAbstractHeap::atSlow(ptrdiff_t index)
 {
     ASSERT(static_cast<size_t>(index) >= m_smallIndices.size());
@@ -29,6 +29,12 @@
 #if ENABLE(FTL_JIT)
 #if FTL_USES_B3
 
+#include "B3PatchpointValue.h"
+#include "CCallHelpers.h"
+#include "JSCJSValue.h"
+#include "MathCommon.h"
+#include <cmath>
+
 namespace JSC { namespace FTL {
 
 Output::Output(State& state)
@@ -136,7 +142,58 @@ LValue Output::baseIndex(LValue base, LValue index, Scale scale, ptrdiff_t offse
     return add(base, accumulatedOffset);
 }
 
-void Output::branch(LValue condition, LBasicBlock taken, Weight takenWeight, LBasicBlock notTaken, Weight notTakenWeight)
+LValue Output::signExt(LValue value, LType type)
+{
+    ASSERT_UNUSED(type, type == B3::Int64 && value->type() == B3::Int32);
+    return m_block->appendNew<B3::Value>(m_proc, B3::SExt32, origin(), value);
+}
+
+LValue Output::intCast(LValue value, LType type)
+{
+    if (value->type() == type)
+        return value;
+    if (type == B3::Int32)
+        return castToInt32(value);
+    return signExt(value, type);
+}
+
+static int32_t countLeadingZeros32(int32_t value)
+{
+    return clz32(value);
+}
+
+LValue Output::ctlz32(LValue xOperand, LValue yOperand)
+{
+    // The count is defined for zero, so whether zero is undefined doesn't matter.
+    UNUSED_PARAM(yOperand);
+    B3::CCallValue* result = m_block->appendNew<B3::CCallValue>(
+        m_proc, B3::Int32, origin(), operation(countLeadingZeros32), xOperand);
+    result->effects = B3::Effects();
+    return result;
+}
+
+LValue Output::fpToInt32(LValue value)
+{
+    // Callers only rely on the result when the double is in int32 range, where toInt32() is the
+    // truncating conversion they expect.
+    return call(B3::Int32, operation(static_cast<int32_t (*)(double)>(toInt32)), value);
+}
+
+LValue Output::fpToUInt32(LValue value)
+{
+    return call(B3::Int32, operation(static_cast<uint32_t (*)(double)>(toUInt32)), value);
+}
+
+void Output::trap()
+{
+    B3::PatchpointValue* patchpoint = m_block->appendNew<B3::PatchpointValue>(m_proc, B3::Void, origin());
+    patchpoint->setGenerator(
+        [=] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+            jit.breakpoint();
+        });
+}
+
+, Weight takenWeight, LBasicBlock notTaken, Weight notTakenWeight)
 {
     m_block->appendNew<B3::ControlValue>(
         m_proc, B3::Branch, origin(), condition,
@@ -144,6 +201,34 @@ void Output::branch(LValue condition, LBasicBlock taken, Weight takenWeight, LBa
         B3::FrequentedBlock(notTaken, notTakenWeight.frequencyClass()));
 }
 
+void Output::check(LValue condition, WeightedTarget taken, Weight notTakenWeight)
+{
+    LBasicBlock continuation = FTL_NEW_BLOCK(*this, ("Output::check continuation"));
+    branch(condition, taken, WeightedTarget(continuation, notTakenWeight));
+    appendTo(continuation);
+}
+
+void Output::check(LValue condition, WeightedTarget taken)
+{
+    check(condition, taken, taken.weight().inverse());
+}
+
+LValue Output::callDoubleMath(double (*function)(double), LValue value)
+{
+    B3::CCallValue* result = m_block->appendNew<B3::CCallValue>(
+        m_proc, B3::Double, origin(), operation(function), value);
+    result->effects = B3::Effects();
+    return result;
+}
+
+LValue Output::callDoubleMath(double (*function)(double, double), LValue left, LValue right)
+{
+    B3::CCallValue* result = m_block->appendNew<B3::CCallValue>(
+        m_proc, B3::Double, origin(), operation(function), left, right);
+    result->effects = B3::Effects();
+    return result;
+}
+
 } } // namespace JSC::FTL
 
 #endif // FTL_USES_B3
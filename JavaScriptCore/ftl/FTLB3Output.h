@@ -121,8 +121,8 @@ public:
     LValue add(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Add, origin(), left, right); }
     LValue sub(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Sub, origin(), left, right); }
     LValue mul(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Mul, origin(), left, right); }
-    LValue div(LValue left, LValue right) { CRASH(); }
-    LValue rem(LValue left, LValue right) { CRASH(); }
+    LValue div(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Div, origin(), left, right); }
+    LValue rem(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Mod, origin(), left, right); }
     LValue neg(LValue value)
     {
         LValue zero = m_block->appendIntConstant(m_proc, origin(), value->type(), 0);
@@ -133,7 +133,7 @@ public:
     LValue doubleSub(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Sub, origin(), left, right); }
     LValue doubleMul(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Mul, origin(), left, right); }
     LValue doubleDiv(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::Div, origin(), left, right); }
-    LValue doubleRem(LValue left, LValue right) { CRASH(); }
+    LValue doubleRem(LValue left, LValue right) { return callDoubleMath(fmod, left, right); }
     LValue doubleNeg(LValue value)
     {
         return sub(doubleZero, value);
@@ -149,53 +149,63 @@ public:
 
     LValue insertElement(LValue vector, LValue element, LValue index) { CRASH(); }
 
-    LValue ceil64(LValue operand) { CRASH(); }
-    LValue ctlz32(LValue xOperand, LValue yOperand) { CRASH(); }
+    LValue ceil64(LValue operand) { return callDoubleMath(ceil, operand); }
+    LValue ctlz32(LValue xOperand, LValue yOperand);
     LValue addWithOverflow32(LValue left, LValue right) { CRASH(); }
     LValue subWithOverflow32(LValue left, LValue right) { CRASH(); }
     LValue mulWithOverflow32(LValue left, LValue right) { CRASH(); }
     LValue addWithOverflow64(LValue left, LValue right) { CRASH(); }
     LValue subWithOverflow64(LValue left, LValue right) { CRASH(); }
     LValue mulWithOverflow64(LValue left, LValue right) { CRASH(); }
-    LValue doubleAbs(LValue value) { CRASH(); }
+    LValue doubleAbs(LValue value) { return callDoubleMath(fabs, value); }
 
-    LValue doubleSin(LValue value) { CRASH(); }
-    LValue doubleCos(LValue value) { CRASH(); }
+    LValue doubleSin(LValue value) { return callDoubleMath(sin, value); }
+    LValue doubleCos(LValue value) { return callDoubleMath(cos, value); }
 
-    LValue doublePow(LValue xOperand, LValue yOperand) { CRASH(); }
+    LValue doublePow(LValue xOperand, LValue yOperand) { return callDoubleMath(pow, xOperand, yOperand); }
 
-    LValue doublePowi(LValue xOperand, LValue yOperand) { CRASH(); }
+    LValue doublePowi(LValue xOperand, LValue yOperand) { return doublePow(xOperand, intToDouble(yOperand)); }
 
-    LValue doubleSqrt(LValue value) { CRASH(); }
+    LValue doubleSqrt(LValue value) { return callDoubleMath(sqrt, value); }
 
-    LValue doubleLog(LValue value) { CRASH(); }
+    LValue doubleLog(LValue value) { return callDoubleMath(log, value); }
 
-    static bool hasSensibleDoubleToInt() { CRASH(); }
+    // Air has no double-to-int instruction yet, so fpToInt32() is a call and there is nothing to
+    // gain from the cvttsd2si-style fast path.
+    static bool hasSensibleDoubleToInt() { return false; }
     LValue sensibleDoubleToInt(LValue) { CRASH(); }
 
-    LValue signExt(LValue value, LType type) { CRASH(); }
+    LValue signExt(LValue value, LType type);
     LValue zeroExt(LValue value, LType type) { return m_block->appendNew<B3::Value>(m_proc, B3::ZExt32, type, origin(), value); }
     LValue zeroExtPtr(LValue value) { return zeroExt(value, B3::Int64); }
     LValue fpToInt(LValue value, LType type) { CRASH(); }
     LValue fpToUInt(LValue value, LType type) { CRASH(); }
-    LValue fpToInt32(LValue value) { CRASH(); }
-    LValue fpToUInt32(LValue value) { CRASH(); }
+    LValue fpToInt32(LValue value);
+    LValue fpToUInt32(LValue value);
     LValue intToFP(LValue value, LType type) { CRASH(); }
     LValue intToDouble(LValue value) { return m_block->appendNew<B3::Value>(m_proc, B3::IToD, origin(), value); }
-    LValue unsignedToFP(LValue value, LType type) { CRASH(); }
-    LValue unsignedToDouble(LValue value) { CRASH(); }
-    LValue intCast(LValue value, LType type) { CRASH(); }
+    LValue unsignedToFP(LValue value, LType type)
+    {
+        ASSERT_UNUSED(type, type == B3::Double);
+        return unsignedToDouble(value);
+    }
+    LValue unsignedToDouble(LValue value) { return intToDouble(zeroExt(value, B3::Int64)); }
+    LValue intCast(LValue value, LType type);
     LValue castToInt32(LValue value)
     {
         return value->type() == B3::Int32 ? value :
             m_block->appendNew<B3::Value>(m_proc, B3::Trunc, origin(), value);
     }
-    LValue fpCast(LValue value, LType type) { CRASH(); }
+    LValue fpCast(LValue value, LType type)
+    {
+        ASSERT_UNUSED(type, type == B3::Double && value->type() == B3::Double);
+        return value;
+    }
     LValue intToPtr(LValue value, LType type) { CRASH(); }
     LValue ptrToInt(LValue value, LType type) { CRASH(); }
     LValue bitCast(LValue, LType);
 
-    LValue fround(LValue doubleValue) { CRASH(); }
+    LValue fround(LValue doubleValue) { return callDoubleMath(roundToFloat, doubleValue); }
 
     // Hilariously, the #define machinery in the stdlib means that this method is actually called
     // __builtin_alloca. So far this appears benign. :-|
@@ -303,8 +313,17 @@ public:
     LValue doubleLessThanOrEqual(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::LessEqual, origin(), left, right); }
     LValue doubleGreaterThan(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::GreaterThan, origin(), left, right); }
     LValue doubleGreaterThanOrEqual(LValue left, LValue right) { return m_block->appendNew<B3::Value>(m_proc, B3::GreaterEqual, origin(), left, right); }
-    LValue doubleEqualOrUnordered(LValue left, LValue right) { CRASH(); }
-    LValue doubleNotEqual(LValue left, LValue right) { CRASH(); }
+    LValue doubleEqualOrUnordered(LValue left, LValue right)
+    {
+        return m_block->appendNew<B3::Value>(
+            m_proc, B3::Equal, origin(),
+            bitOr(doubleLessThan(left, right), doubleGreaterThan(left, right)),
+            int32Zero);
+    }
+    LValue doubleNotEqual(LValue left, LValue right)
+    {
+        return bitOr(doubleLessThan(left, right), doubleGreaterThan(left, right));
+    }
     LValue doubleLessThanOrUnordered(LValue left, LValue right)
     {
         return m_block->appendNew<B3::Value>(
@@ -354,12 +373,19 @@ public:
     LValue fence(LAtomicOrdering ordering = LLVMAtomicOrderingSequentiallyConsistent, SynchronizationScope scope = CrossThread) { CRASH(); }
     LValue fenceAcqRel() { CRASH(); }
 
+    // The callee is the first child of a CCall.
     template<typename VectorType>
-    LValue call(LType type, LValue function, const VectorType& vector) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), B3::Value::AdjacencyList(vector)); }
-    LValue call(LType type, LValue function) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin()); }
-    LValue call(LType type, LValue function, LValue arg1) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), arg1); }
+    LValue call(LType type, LValue function, const VectorType& vector)
+    {
+        B3::Value::AdjacencyList children;
+        children.append(function);
+        children.appendVector(vector);
+        return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), WTF::move(children));
+    }
+    LValue call(LType type, LValue function) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), function); }
+    LValue call(LType type, LValue function, LValue arg1) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), function, arg1); }
     template<typename... Args>
-    LValue call(LType type, LValue function, LValue arg1, Args... args) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), arg1, args...); }
+    LValue call(LType type, LValue function, LValue arg1, Args... args) { return m_block->appendNew<B3::CCallValue>(m_proc, type, origin(), function, arg1, args...); }
 
     template<typename FunctionType>
     LValue operation(FunctionType function) { return constIntPtr(bitwise_cast<void*>(function)); }
@@ -373,13 +399,23 @@ public:
 
     // Branches to an already-created handler if true, "falls through" if false. Fall-through is
     // simulated by creating a continuation for you.
-    void check(LValue condition, WeightedTarget taken, Weight notTakenWeight) { CRASH(); }
+    void check(LValue condition, WeightedTarget taken, Weight notTakenWeight);
 
     // Same as check(), but uses Weight::inverse() to compute the notTakenWeight.
-    void check(LValue condition, WeightedTarget taken) { CRASH(); }
+    void check(LValue condition, WeightedTarget taken);
 
     template<typename VectorType>
-    void switchInstruction(LValue value, const VectorType& cases, LBasicBlock fallThrough, Weight fallThroughWeight) { CRASH(); }
+    void switchInstruction(LValue value, const VectorType& cases, LBasicBlock fallThrough, Weight fallThroughWeight)
+    {
+        B3::SwitchValue* switchValue = m_block->appendNew<B3::SwitchValue>(
+            m_proc, origin(), value, B3::FrequentedBlock(fallThrough, fallThroughWeight.frequencyClass()));
+        for (const SwitchCase& switchCase : cases) {
+            switchValue->appendCase(
+                B3::SwitchCase(
+                    switchCase.value()->asInt(),
+                    B3::FrequentedBlock(switchCase.target(), switchCase.weight().frequencyClass())));
+        }
+    }
 
     void ret(LValue value) { m_block->appendNew<B3::ControlValue>(m_proc, B3::Return, origin(), value); }
 
@@ -425,7 +461,7 @@ public:
         return m_block->appendNew<B3::PatchpointValue>(m_proc, type, origin());
     }
 
-    void trap() { CRASH(); }
+    void trap();
 
     ValueFromBlock anchor(LValue value)
     {
@@ -440,6 +476,14 @@ public:
     LValue patchpointInt64Intrinsic() { CRASH(); }
     LValue patchpointVoidIntrinsic() { CRASH(); }
 
+#pragma mark - Math calls
+
+    // Air has no instructions for these yet, so we call into libm. The calls have no effects, which
+    // leaves B3 free to move or kill them.
+    LValue callDoubleMath(double (*)(double), LValue);
+    LValue callDoubleMath(double (*)(double, double), LValue, LValue);
+    static double roundToFloat(double value) { return static_cast<float>(value); }
+
 #pragma mark - States
     B3::Procedure& m_proc;
 
@@ -147,6 +147,7 @@ inline CapabilityLevel canCompile(Node* node)
     case Branch:
     case LogicalNot:
     case CheckInBounds:
+    case CheckNoHolesInRange:
     case ConstantStoragePointer:
     case Check:
     case CountExecution:
@@ -35,21 +35,24 @@
 #include "DFGCommon.h"
 #include "DFGGraphSafepoint.h"
 #include "DFGOperations.h"
-#include "DataView.h"
 #include "Disassembler.h"
 #include "FTLExceptionHandlerManager.h"
 #include "FTLExitThunkGenerator.h"
 #include "FTLInlineCacheSize.h"
 #include "FTLJITCode.h"
+#include "FTLParallelCodeGeneration.h"
+#include "FTLParallelLoops.h"
+#include "FTLPassPipeline.h"
+#include "FTLPollyCache.h"
+#include "FTLPollyOptions.h"
+#include "FTLPollyReport.h"
 #include "FTLThunks.h"
 #include "FTLUnwindInfo.h"
 #include "JITSubGenerator.h"
 #include "LLVMAPI.h"
 #include "LinkBuffer.h"
 #include "ScratchRegisterAllocator.h"
-
-#include <iostream>
-#include <sys/time.h>
+#include <wtf/CurrentTime.h>
 
 namespace JSC { namespace FTL {
 
@@ -149,17 +152,16 @@ static void dumpDataSection(DataSection* section, const char* prefix)
  * Get the offset of the stackmap region identified by stackmapID
  * in the stackmaps section
  */
-static int offsetOfStackRegion(StackMaps::RecordMap& recordMap, uint32_t stackmapID)
+static int offsetOfStackRegion(const StackMaps::RecordMap& recordMap, uint32_t stackmapID)
 {
     if (stackmapID == UINT_MAX)
         return 0;
 
-    StackMaps::RecordMap::iterator iter = recordMap.find(stackmapID);
-    RELEASE_ASSERT(iter != recordMap.end());
-    RELEASE_ASSERT(iter->value.size() == 1);
-    RELEASE_ASSERT(iter->value[0].record.locations.size() == 1);
+    StackMaps::RecordMap::Records records = recordMap.find(stackmapID);
+    RELEASE_ASSERT(records.size() == 1);
+    RELEASE_ASSERT(records[0].record.locations.size() == 1);
     Location capturedLocation =
-        Location::forStackmaps(nullptr, iter->value[0].record.locations[0]);
+        Location::forStackmaps(nullptr, records[0].record.locations[0]);
     RELEASE_ASSERT(capturedLocation.kind() == Location::Register);
     RELEASE_ASSERT(capturedLocation.gpr() == GPRInfo::callFrameRegister);
     RELEASE_ASSERT(!(capturedLocation.addend() % sizeof(Register)));
@@ -221,18 +223,16 @@ static void generateInlineIfPossibleOutOfLineIfNot(State& state, VM& vm, CodeBlo
 template<typename DescriptorType>
 void generateICFastPath(
     State& state, CodeBlock* codeBlock, GeneratedFunction generatedFunction,
-    StackMaps::RecordMap& recordMap, DescriptorType& ic, size_t sizeOfIC)
+    const StackMaps::RecordMap& recordMap, DescriptorType& ic, size_t sizeOfIC)
 {
     VM& vm = state.graph.m_vm;
 
-    StackMaps::RecordMap::iterator iter = recordMap.find(ic.stackmapID());
-    if (iter == recordMap.end()) {
+    StackMaps::RecordMap::Records records = recordMap.find(ic.stackmapID());
+    if (records.isEmpty()) {
         // It was optimized out.
         return;
     }
 
-    Vector<StackMaps::RecordAndIndex>& records = iter->value;
-
     RELEASE_ASSERT(records.size() == ic.m_generators.size());
 
     for (unsigned i = records.size(); i--;) {
@@ -259,18 +259,16 @@ void generateICFastPath(
 
 static void generateCheckInICFastPath(
     State& state, CodeBlock* codeBlock, GeneratedFunction generatedFunction,
-    StackMaps::RecordMap& recordMap, CheckInDescriptor& ic, size_t sizeOfIC)
+    const StackMaps::RecordMap& recordMap, CheckInDescriptor& ic, size_t sizeOfIC)
 {
     VM& vm = state.graph.m_vm;
 
-    StackMaps::RecordMap::iterator iter = recordMap.find(ic.stackmapID());
-    if (iter == recordMap.end()) {
+    StackMaps::RecordMap::Records records = recordMap.find(ic.stackmapID());
+    if (records.isEmpty()) {
         // It was optimized out.
         return;
     }
 
-    Vector<StackMaps::RecordAndIndex>& records = iter->value;
-
     RELEASE_ASSERT(records.size() == ic.m_generators.size());
 
     for (unsigned i = records.size(); i--;) {
@@ -429,17 +427,15 @@ private:
 
 static void generateArithSubICFastPath(
     State& state, CodeBlock* codeBlock, GeneratedFunction generatedFunction,
-    StackMaps::RecordMap& recordMap, ArithSubDescriptor& ic)
+    const StackMaps::RecordMap& recordMap, ArithSubDescriptor& ic)
 {
     VM& vm = state.graph.m_vm;
     size_t sizeOfIC = sizeOfArithSub();
 
-    StackMaps::RecordMap::iterator iter = recordMap.find(ic.stackmapID());
-    if (iter == recordMap.end())
+    StackMaps::RecordMap::Records records = recordMap.find(ic.stackmapID());
+    if (records.isEmpty())
         return; // It was optimized out.
 
-    Vector<StackMaps::RecordAndIndex>& records = iter->value;
-
     RELEASE_ASSERT(records.size() == ic.m_slowPathStarts.size());
 
     for (unsigned i = records.size(); i--;) {
@@ -496,17 +492,16 @@ static void generateArithSubICFastPath(
 
 static void generateProbe(
     State& state, CodeBlock* codeBlock, GeneratedFunction generatedFunction,
-    StackMaps::RecordMap& recordMap, ProbeDescriptor& ic)
+    const StackMaps::RecordMap& recordMap, ProbeDescriptor& ic)
 {
     VM& vm = state.graph.m_vm;
     size_t sizeOfIC = sizeOfProbe();
 
-    StackMaps::RecordMap::iterator iter = recordMap.find(ic.stackmapID());
-    if (iter == recordMap.end())
+    StackMaps::RecordMap::Records records = recordMap.find(ic.stackmapID());
+    if (records.isEmpty())
         return; // It was optimized out.
 
     CCallHelpers fastPathJIT(&vm, codeBlock);
-    Vector<StackMaps::RecordAndIndex>& records = iter->value;
     for (unsigned i = records.size(); i--;) {
         StackMaps::Record& record = records[i].record;
 
@@ -530,7 +525,7 @@ static RegisterSet usedRegistersFor(const StackMaps::Record& record)
 }
 
 template<typename CallType>
-void adjustCallICsForStackmaps(Vector<CallType>& calls, StackMaps::RecordMap& recordMap, ExceptionHandlerManager& exceptionHandlerManager)
+void adjustCallICsForStackmaps(Vector<CallType>& calls, const StackMaps::RecordMap& recordMap, ExceptionHandlerManager& exceptionHandlerManager)
 {
     // Handling JS calls is weird: we need to ensure that we sort them by the PC in LLVM
     // generated code. That implies first pruning the ones that LLVM didn't generate.
@@ -541,15 +536,15 @@ void adjustCallICsForStackmaps(Vector<CallType>& calls, StackMaps::RecordMap& re
     for (unsigned i = 0; i < oldCalls.size(); ++i) {
         CallType& call = oldCalls[i];
 
-        StackMaps::RecordMap::iterator iter = recordMap.find(call.stackmapID());
-        if (iter == recordMap.end())
+        StackMaps::RecordMap::Records records = recordMap.find(call.stackmapID());
+        if (records.isEmpty())
             continue;
 
-        for (unsigned j = 0; j < iter->value.size(); ++j) {
+        for (unsigned j = 0; j < records.size(); ++j) {
             CallType copy = call;
-            copy.m_instructionOffset = iter->value[j].record.instructionOffset;
-            copy.setCallSiteIndex(exceptionHandlerManager.procureCallSiteIndex(iter->value[j].index, copy));
-            copy.setCorrespondingGenericUnwindOSRExit(exceptionHandlerManager.getCallOSRExit(iter->value[j].index, copy));
+            copy.m_instructionOffset = records[j].record.instructionOffset;
+            copy.setCallSiteIndex(exceptionHandlerManager.procureCallSiteIndex(records[j].index, copy));
+            copy.setCorrespondingGenericUnwindOSRExit(exceptionHandlerManager.getCallOSRExit(records[j].index, copy));
 
             calls.append(copy);
         }
@@ -560,7 +555,7 @@ void adjustCallICsForStackmaps(Vector<CallType>& calls, StackMaps::RecordMap& re
 
 static void fixFunctionBasedOnStackMaps(
     State& state, CodeBlock* codeBlock, JITCode* jitCode, GeneratedFunction generatedFunction,
-    StackMaps::RecordMap& recordMap)
+    const StackMaps::RecordMap& recordMap)
 {
     Graph& graph = state.graph;
     VM& vm = graph.m_vm;
@@ -641,8 +636,8 @@ static void fixFunctionBasedOnStackMaps(
     	// the stackmaps section for the stackmapID associated with the descriptor.
     	// In other words, check that it has not been optimized out
         OSRExitDescriptor& exitDescriptor = state.jitCode->osrExitDescriptors[i];
-        auto iter = recordMap.find(exitDescriptor.m_stackmapID);
-        if (iter == recordMap.end()) {
+        auto records = recordMap.find(exitDescriptor.m_stackmapID);
+        if (records.isEmpty()) {
             // It was optimized out.
             continue;
         }
@@ -655,25 +650,31 @@ static void fixFunctionBasedOnStackMaps(
 
         // JSCPOLLY COMMENT
         // Iterate over all the records of the stackmapID of the current OSR exit descriptor
-        for (unsigned j = 0; j < iter->value.size(); j++) {
+        for (unsigned j = 0; j < records.size(); j++) {
 
 
             // JSCPOLLY COMMENT
         	// Creates an OSRExit for the current record
             {
-                uint32_t stackmapRecordIndex = iter->value[j].index;
+                uint32_t stackmapRecordIndex = records[j].index;
                 OSRExit exit(exitDescriptor, stackmapRecordIndex);
                 state.jitCode->osrExit.append(exit);
                 state.finalizer->osrExit.append(OSRExitCompilationInfo());
             }
 
             OSRExit& exit = state.jitCode->osrExit.last();
+#if CPU(X86_64)
+            if (Options::useFTLSharedExitThunk() && exitDescriptor.canUseSharedExitThunk()) {
+                exit.m_exitSiteReturnAddress = bitwise_cast<char*>(generatedFunction)
+                    + records[j].record.instructionOffset + MacroAssembler::maxJumpReplacementSize();
+            }
+#endif
             if (exitDescriptor.willArriveAtExitFromIndirectExceptionCheck()) {
-                StackMaps::Record& record = iter->value[j].record;
+                StackMaps::Record& record = records[j].record;
                 RELEASE_ASSERT(exit.m_descriptor.m_semanticCodeOriginForCallFrameHeader.isSet());
                 CallSiteIndex callSiteIndex = state.jitCode->common.addUniqueCallSiteIndex(exit.m_descriptor.m_semanticCodeOriginForCallFrameHeader);
                 exit.m_exceptionHandlerCallSiteIndex = callSiteIndex;
-                exceptionHandlerManager.addNewExit(iter->value[j].index, state.jitCode->osrExit.size() - 1);
+                exceptionHandlerManager.addNewExit(records[j].index, state.jitCode->osrExit.size() - 1);
 
                 // Subs and GetByIds have an interesting register preservation story,
                 // see comment below at GetById to read about it.
@@ -731,8 +732,10 @@ static void fixFunctionBasedOnStackMaps(
                 dataLog("Handling OSR stackmap #", exit.m_descriptor.m_stackmapID, " for ",
                 		exit.m_codeOrigin, " of kind ", exitKindToString(exit.m_kind), "\n");
 
-            info.m_thunkAddress = linkBuffer->locationOf(info.m_thunkLabel);
-            exit.m_patchableCodeOffset = linkBuffer->offsetOf(info.m_thunkJump);
+            if (!exit.usesSharedExitThunk()) {
+                info.m_thunkAddress = linkBuffer->locationOf(info.m_thunkLabel);
+                exit.m_patchableCodeOffset = linkBuffer->offsetOf(info.m_thunkJump);
+            }
 
             if (exit.m_descriptor.mightArriveAtOSRExitFromGenericUnwind()) {
                 HandlerInfo newHandler = exit.m_descriptor.m_baselineExceptionHandler;
@@ -781,15 +784,15 @@ static void fixFunctionBasedOnStackMaps(
             if (verboseCompilationEnabled())
                 dataLog("Handling GetById stackmap #", getById.stackmapID(), "\n");
 
-            auto iter = recordMap.find(getById.stackmapID());
-            if (iter == recordMap.end()) {
+            auto records = recordMap.find(getById.stackmapID());
+            if (records.isEmpty()) {
                 // It was optimized out.
                 continue;
             }
 
             CodeOrigin codeOrigin = getById.codeOrigin();
-            for (unsigned i = 0; i < iter->value.size(); ++i) {
-                StackMaps::Record& record = iter->value[i].record;
+            for (unsigned i = 0; i < records.size(); ++i) {
+                StackMaps::Record& record = records[i].record;
 
                 RegisterSet usedRegisters = usedRegistersFor(record);
 
@@ -797,10 +800,10 @@ static void fixFunctionBasedOnStackMaps(
                 GPRReg base = record.locations[1].directGPR();
 
                 JITGetByIdGenerator gen(
-                    codeBlock, codeOrigin, exceptionHandlerManager.procureCallSiteIndex(iter->value[i].index, codeOrigin), usedRegisters, JSValueRegs(base),
+                    codeBlock, codeOrigin, exceptionHandlerManager.procureCallSiteIndex(records[i].index, codeOrigin), usedRegisters, JSValueRegs(base),
                     JSValueRegs(result));
 
-                bool addedUniqueExceptionJump = addNewExceptionJumpIfNecessary(iter->value[i].index);
+                bool addedUniqueExceptionJump = addNewExceptionJumpIfNecessary(records[i].index);
                 MacroAssembler::Label begin = slowPathJIT.label();
                 if (result == base) {
                     // This situation has a really interesting story. We may have a GetById inside
@@ -812,7 +815,7 @@ static void fixFunctionBasedOnStackMaps(
                     // register that we would like to do value recovery on. We combat this situation from ever
                     // taking place by ensuring we spill the original base value and then recover it from
                     // the spill slot as the first step in OSR exit.
-                    if (OSRExit* exit = exceptionHandlerManager.getByIdOSRExit(iter->value[i].index))
+                    if (OSRExit* exit = exceptionHandlerManager.getByIdOSRExit(records[i].index))
                         exit->spillRegistersToSpillSlot(slowPathJIT, jsCallThatMightThrowSpillOffset);
                 }
                 MacroAssembler::Call call = callOperation(
@@ -833,15 +836,15 @@ static void fixFunctionBasedOnStackMaps(
             if (verboseCompilationEnabled())
                 dataLog("Handling PutById stackmap #", putById.stackmapID(), "\n");
 
-            auto iter = recordMap.find(putById.stackmapID());
-            if (iter == recordMap.end()) {
+            auto records = recordMap.find(putById.stackmapID());
+            if (records.isEmpty()) {
                 // It was optimized out.
                 continue;
             }
 
             CodeOrigin codeOrigin = putById.codeOrigin();
-            for (unsigned i = 0; i < iter->value.size(); ++i) {
-                StackMaps::Record& record = iter->value[i].record;
+            for (unsigned i = 0; i < records.size(); ++i) {
+                StackMaps::Record& record = records[i].record;
 
                 RegisterSet usedRegisters = usedRegistersFor(record);
 
@@ -849,10 +852,10 @@ static void fixFunctionBasedOnStackMaps(
                 GPRReg value = record.locations[1].directGPR();
 
                 JITPutByIdGenerator gen(
-                    codeBlock, codeOrigin, exceptionHandlerManager.procureCallSiteIndex(iter->value[i].index, codeOrigin), usedRegisters, JSValueRegs(base),
+                    codeBlock, codeOrigin, exceptionHandlerManager.procureCallSiteIndex(records[i].index, codeOrigin), usedRegisters, JSValueRegs(base),
                     JSValueRegs(value), GPRInfo::patchpointScratchRegister, putById.ecmaMode(), putById.putKind());
 
-                bool addedUniqueExceptionJump = addNewExceptionJumpIfNecessary(iter->value[i].index);
+                bool addedUniqueExceptionJump = addNewExceptionJumpIfNecessary(records[i].index);
 
                 MacroAssembler::Label begin = slowPathJIT.label();
 
@@ -875,15 +878,15 @@ static void fixFunctionBasedOnStackMaps(
             if (verboseCompilationEnabled())
                 dataLog("Handling checkIn stackmap #", checkIn.stackmapID(), "\n");
 
-            auto iter = recordMap.find(checkIn.stackmapID());
-            if (iter == recordMap.end()) {
+            auto records = recordMap.find(checkIn.stackmapID());
+            if (records.isEmpty()) {
                 // It was optimized out.
                 continue;
             }
 
             CodeOrigin codeOrigin = checkIn.codeOrigin();
-            for (unsigned i = 0; i < iter->value.size(); ++i) {
-                StackMaps::Record& record = iter->value[i].record;
+            for (unsigned i = 0; i < records.size(); ++i) {
+                StackMaps::Record& record = records[i].record;
                 RegisterSet usedRegisters = usedRegistersFor(record);
                 GPRReg result = record.locations[0].directGPR();
                 GPRReg obj = record.locations[1].directGPR();
@@ -913,13 +916,13 @@ static void fixFunctionBasedOnStackMaps(
             if (verboseCompilationEnabled())
                 dataLog("Handling ArithSub stackmap #", arithSub.stackmapID(), "\n");
 
-            auto iter = recordMap.find(arithSub.stackmapID());
-            if (iter == recordMap.end())
+            auto records = recordMap.find(arithSub.stackmapID());
+            if (records.isEmpty())
                 continue; // It was optimized out.
 
             CodeOrigin codeOrigin = arithSub.codeOrigin();
-            for (unsigned i = 0; i < iter->value.size(); ++i) {
-                StackMaps::Record& record = iter->value[i].record;
+            for (unsigned i = 0; i < records.size(); ++i) {
+                StackMaps::Record& record = records[i].record;
                 RegisterSet usedRegisters = usedRegistersFor(record);
 
                 GPRReg result = record.locations[0].directGPR();
@@ -927,11 +930,11 @@ static void fixFunctionBasedOnStackMaps(
                 GPRReg right = record.locations[2].directGPR();
 
                 arithSub.m_slowPathStarts.append(slowPathJIT.label());
-                bool addedUniqueExceptionJump = addNewExceptionJumpIfNecessary(iter->value[i].index);
+                bool addedUniqueExceptionJump = addNewExceptionJumpIfNecessary(records[i].index);
                 if (result == left || result == right) {
                     // This situation has a really interesting register preservation story.
                     // See comment above for GetByIds.
-                    if (OSRExit* exit = exceptionHandlerManager.subOSRExit(iter->value[i].index))
+                    if (OSRExit* exit = exceptionHandlerManager.subOSRExit(records[i].index))
                         exit->spillRegistersToSpillSlot(slowPathJIT, jsCallThatMightThrowSpillOffset);
                 }
 
@@ -948,19 +951,19 @@ static void fixFunctionBasedOnStackMaps(
             if (verboseCompilationEnabled())
                 dataLog("Handling lazySlowPath stackmap #", descriptor.stackmapID(), "\n");
 
-            auto iter = recordMap.find(descriptor.stackmapID());
-            if (iter == recordMap.end()) {
+            auto records = recordMap.find(descriptor.stackmapID());
+            if (records.isEmpty()) {
                 // It was optimized out.
                 continue;
             }
             CodeOrigin codeOrigin = descriptor.codeOrigin();
-            for (unsigned i = 0; i < iter->value.size(); ++i) {
-                StackMaps::Record& record = iter->value[i].record;
+            for (unsigned i = 0; i < records.size(); ++i) {
+                StackMaps::Record& record = records[i].record;
                 RegisterSet usedRegisters = usedRegistersFor(record);
                 char* startOfIC =
                     bitwise_cast<char*>(generatedFunction) + record.instructionOffset;
                 CodeLocationLabel patchpoint((MacroAssemblerCodePtr(startOfIC)));
-                CodeLocationLabel exceptionTarget = exceptionHandlerManager.lazySlowPathExceptionTarget(iter->value[i].index);
+                CodeLocationLabel exceptionTarget = exceptionHandlerManager.lazySlowPathExceptionTarget(records[i].index);
                 if (!exceptionTarget)
                     exceptionTarget = state.finalizer->handleExceptionsLinkBuffer->entrypoint();
 
@@ -984,7 +987,7 @@ static void fixFunctionBasedOnStackMaps(
                 }
 
                 std::unique_ptr<LazySlowPath> lazySlowPath = std::make_unique<LazySlowPath>(
-                    patchpoint, exceptionTarget, usedRegisters, exceptionHandlerManager.procureCallSiteIndex(iter->value[i].index, codeOrigin),
+                    patchpoint, exceptionTarget, usedRegisters, exceptionHandlerManager.procureCallSiteIndex(records[i].index, codeOrigin),
                     descriptor.m_linker->run(locations), newZero, scratchAllocator);
 
                 CCallHelpers::Label begin = slowPathJIT.label();
@@ -1095,12 +1098,12 @@ static void fixFunctionBasedOnStackMaps(
         });
     }
 
-    auto iter = recordMap.find(state.handleStackOverflowExceptionStackmapID);
+    auto records = recordMap.find(state.handleStackOverflowExceptionStackmapID);
     // It's sort of remotely possible that we won't have an in-band exception handling
     // path, for some kinds of functions.
-    if (iter != recordMap.end()) {
-        for (unsigned i = iter->value.size(); i--;) {
-            StackMaps::Record& record = iter->value[i].record;
+    if (!records.isEmpty()) {
+        for (unsigned i = records.size(); i--;) {
+            StackMaps::Record& record = records[i].record;
 
             CodeLocationLabel source = CodeLocationLabel(
                 bitwise_cast<char*>(generatedFunction) + record.instructionOffset);
@@ -1111,12 +1114,12 @@ static void fixFunctionBasedOnStackMaps(
         }
     }
 
-    iter = recordMap.find(state.handleExceptionStackmapID);
+    records = recordMap.find(state.handleExceptionStackmapID);
     // It's sort of remotely possible that we won't have an in-band exception handling
     // path, for some kinds of functions.
-    if (iter != recordMap.end()) {
-        for (unsigned i = iter->value.size(); i--;) {
-            StackMaps::Record& record = iter->value[i].record;
+    if (!records.isEmpty()) {
+        for (unsigned i = records.size(); i--;) {
+            StackMaps::Record& record = records[i].record;
 
             CodeLocationLabel source = CodeLocationLabel(
                 bitwise_cast<char*>(generatedFunction) + record.instructionOffset);
@@ -1140,7 +1143,10 @@ static void fixFunctionBasedOnStackMaps(
 
         codeAddresses.append(bitwise_cast<char*>(generatedFunction) + record.instructionOffset + MacroAssembler::maxJumpReplacementSize());
 
-        if (exit.m_descriptor.m_isInvalidationPoint)
+        // The finalizer points these at the shared exit thunk, since we can't create it here.
+        if (exit.usesSharedExitThunk())
+            jitCode->osrExitCallSites.append(JITCode::OSRExitCallSite { exit.m_exitSiteReturnAddress, exitIndex });
+        else if (exit.m_descriptor.m_isInvalidationPoint)
             jitCode->common.jumpReplacements.append(JumpReplacement(source, info.m_thunkAddress));
         else
             MacroAssembler::replaceWithJump(source, info.m_thunkAddress);
@@ -1148,12 +1154,118 @@ static void fixFunctionBasedOnStackMaps(
         if (graph.compilation())
             graph.compilation()->addOSRExitSite(codeAddresses);
     }
+    std::sort(
+        jitCode->osrExitCallSites.begin(), jitCode->osrExitCallSites.end(),
+        [] (const JITCode::OSRExitCallSite& a, const JITCode::OSRExitCallSite& b) {
+            return a.returnAddress < b.returnAddress;
+        });
+}
+
+static void recordTimeOfMarker(void* context, const char*)
+{
+    *static_cast<double*>(context) = monotonicallyIncreasingTimeMS();
 }
 
+// JSCPOLLY COMMENT
+// Polly runs after the rest of the simple pipeline, in a pass manager of its own, so that we
+// can tell how long it took. The report passes around it record what it did in the
+// compilation's profiler entry. The detection report has to look at the module the way Polly's
+// ScopDetection will, so it runs after Polly's canonicalization passes. Those run again as part
+// of Polly, and neither they nor the report count as time in Polly.
+static void runPollyPasses(State& state, LLVMTargetMachineRef targetMachine, LModule module)
+{
+    PollyReportCollector report(state.graph);
+
+    double timeAfterDetectionReport = 0;
+    double timeAfterPolly = 0;
+    LLVMPassTimingClient detectionReportTimingClient { &timeAfterDetectionReport, recordTimeOfMarker };
+    LLVMPassTimingClient pollyTimingClient { &timeAfterPolly, recordTimeOfMarker };
+
+    LLVMPassManagerRef pollyPasses = llvm->CreatePassManager();
+    llvm->AddAnalysisPasses(targetMachine, pollyPasses);
+    llvm->AddScopedNoAliasAAPass(pollyPasses);
+    // BEGIN - DO NOT CHANGE THE ORDER OF THE ALIAS ANALYSIS PASSES
+    llvm->AddTypeBasedAliasAnalysisPass(pollyPasses);
+    llvm->AddBasicAliasAnalysisPass(pollyPasses);
+    // END - DO NOT CHANGE THE ORDER OF THE ALIAS ANALYSIS PASSES
+
+    llvm::legacy::PassManager& passManager = *reinterpret_cast<llvm::legacy::PassManager*>(pollyPasses);
+    llvm->registerCanonicalicationPasses(passManager);
+    llvm->addPollyDetectionReportPass(passManager, report.client());
+    llvm->addPassTimingMarker(passManager, detectionReportTimingClient, "Polly detection report");
+    llvm->registerPollyPasses(passManager);
+    llvm->addPassTimingMarker(passManager, pollyTimingClient, "Polly");
+    llvm->addPollyCodeGenerationReportPass(passManager, report.client());
+
+    double before = monotonicallyIncreasingTimeMS();
+    {
+        PollyOptionsScope optionsScope(state.graph.m_plan.pollyOverride);
+        llvm->RunPassManager(pollyPasses, module);
+    }
+    report.setMilliseconds(timeAfterPolly - timeAfterDetectionReport);
+    if (DFG::PhaseTimes* phaseTimes = state.graph.m_plan.phaseTimes()) {
+        phaseTimes->add("Polly detection report", timeAfterDetectionReport - before);
+        phaseTimes->add("Polly", report.milliseconds());
+    }
+
+    llvm->DisposePassManager(pollyPasses);
+
+    if (verboseCompilationEnabled() || Options::jscpollyVerboseReport())
+        dataLog(report);
+    report.record();
+
+    cachePollyOutcome(
+        state.pollyCacheKey,
+        report.numOptimizedScops() ? PollyOutcome::Optimized : PollyOutcome::NothingOptimized,
+        report.milliseconds());
+}
+
+// Adds the time since the previous marker to the pass that the marker follows.
+class PassTimingCollector {
+public:
+    PassTimingCollector(DFG::PhaseTimes& phaseTimes)
+        : m_phaseTimes(phaseTimes)
+    {
+    }
+
+    LLVMPassTimingClient client()
+    {
+        LLVMPassTimingClient result;
+        result.context = this;
+        result.didRunPass = didRunPass;
+        return result;
+    }
+
+    void start() { m_timeBeforePass = monotonicallyIncreasingTimeMS(); }
+
+private:
+    static void didRunPass(void* context, const char* passName)
+    {
+        PassTimingCollector* collector = static_cast<PassTimingCollector*>(context);
+        double now = monotonicallyIncreasingTimeMS();
+        collector->m_phaseTimes.add(toCString("LLVM ", passName), now - collector->m_timeBeforePass);
+        collector->m_timeBeforePass = now;
+    }
+
+    DFG::PhaseTimes& m_phaseTimes;
+    double m_timeBeforePass { 0 };
+};
+
 void compile(State& state, Safepoint::Result& safepointResult)
 {
+    DFG::PhaseTimes* phaseTimes = state.graph.m_plan.phaseTimes();
+
     char* error = 0;
 
+    // This may compute natural loops, so it has to happen while we still own the graph.
+    PassPipeline pipeline = choosePassPipeline(state);
+    if (Options::llvmSimpleOpt()) {
+        if (verboseCompilationEnabled())
+            dataLog("Using the ", pipeline, " LLVM pass pipeline.\n");
+        if (state.graph.compilation())
+            state.graph.compilation()->setPassPipeline(toCString(pipeline));
+    }
+
     {
         GraphSafepoint safepoint(state.graph, safepointResult);
 
@@ -1213,53 +1325,29 @@ void compile(State& state, Safepoint::Result& safepointResult)
 				// Intialize LLVM passes used by Polly
 				passRegistry = llvm->GetGlobalPassRegistry();
 				llvm->initializePollyPasses(*reinterpret_cast<llvm::PassRegistry*>(passRegistry));
-				llvm->initializePollyPassesJSCPolly(Options::jscpollyTiling());
-				std::cout << "init polly passes with tiling = " << Options::jscpollyTiling() << std::endl;
+				initializePollyOptions();
             }
             // END JSCPOLLY
 
-            //llvm->AddTargetData(targetData, modulePasses);
-            llvm->AddAnalysisPasses(targetMachine, modulePasses);
-            llvm->AddPromoteMemoryToRegisterPass(modulePasses);
-            llvm->AddGlobalOptimizerPass(modulePasses);
-            llvm->AddFunctionInliningPass(modulePasses);
-            llvm->AddPruneEHPass(modulePasses);
-            llvm->AddGlobalDCEPass(modulePasses);
-            llvm->AddConstantPropagationPass(modulePasses);
-            llvm->AddAggressiveDCEPass(modulePasses);
-            llvm->AddInstructionCombiningPass(modulePasses);
-            // BEGIN - DO NOT CHANGE THE ORDER OF THE ALIAS ANALYSIS PASSES
-            llvm->AddTypeBasedAliasAnalysisPass(modulePasses);
-            llvm->AddBasicAliasAnalysisPass(modulePasses);
-            // END - DO NOT CHANGE THE ORDER OF THE ALIAS ANALYSIS PASSES
-            llvm->AddGVNPass(modulePasses);
-            llvm->AddCFGSimplificationPass(modulePasses);
-            llvm->AddDeadStoreEliminationPass(modulePasses);
-            // JSCPOLLY BEGIN
-            llvm->AddLICMPass(modulePasses);
-            // JSCPOLLY END
+            std::unique_ptr<PassTimingCollector> passTiming;
+            if (phaseTimes)
+                passTiming = std::make_unique<PassTimingCollector>(*phaseTimes);
+            LLVMPassTimingClient passTimingClient = passTiming ? passTiming->client() : LLVMPassTimingClient();
+            addPassPipeline(pipeline, modulePasses, targetMachine, passTiming ? &passTimingClient : nullptr);
 
             if (enableLLVMFastISel)
                 llvm->AddLowerSwitchPass(modulePasses);
 
+            if (passTiming)
+                passTiming->start();
+            llvm->RunPassManager(modulePasses, module);
+
 			// JSCPOLLY BEGIN
-            if (state.withPolly && !state.withPollyNo) {
-            	std::cout << "running polly passes\n";
-                llvm->registerPollyPasses(*reinterpret_cast<llvm::legacy::PassManager*>(modulePasses));
+            if (pipeline == PassPipeline::Polyhedral) {
+                runPollyPasses(state, targetMachine, module);
+                mapParallelLoopRuntime(module, engine);
             }
 			// JSCPOLLY END
-
-            struct timeval start, end;
-            long secs_used,micros_used;
-            gettimeofday(&start, NULL);
-
-            llvm->RunPassManager(modulePasses, module);
-
-            gettimeofday(&end, NULL);
-            secs_used=(end.tv_sec - start.tv_sec); //avoid overflow by subtracting first
-            micros_used= ((secs_used*1000000) + end.tv_usec) - (start.tv_usec);
-            std::cout << "COMPILE: " << (micros_used/1000) << " milliseconds\n";
-
         } else {
             LLVMPassManagerBuilderRef passBuilder = llvm->PassManagerBuilderCreate();
             llvm->PassManagerBuilderSetOptLevel(passBuilder, Options::llvmOptimizationLevel());
@@ -1276,6 +1364,7 @@ void compile(State& state, Safepoint::Result& safepointResult)
 
             llvm->PassManagerBuilderDispose(passBuilder);
 
+            DFG::PhaseTimer timer(phaseTimes, "LLVM optimization");
             llvm->InitializeFunctionPassManager(functionPasses);
             for (LValue function = llvm->GetFirstFunction(module); function; function = llvm->GetNextFunction(function))
                 llvm->RunFunctionPassManager(functionPasses, function);
@@ -1289,7 +1378,12 @@ void compile(State& state, Safepoint::Result& safepointResult)
 
         // FIXME: Need to add support for the case where JIT memory allocation failed.
         // https://bugs.webkit.org/show_bug.cgi?id=113620
-        state.generatedFunction = reinterpret_cast<GeneratedFunction>(llvm->GetPointerToGlobal(engine, state.function));
+        {
+            DFG::PhaseTimer timer(phaseTimes, "LLVM machine code generation");
+            state.generatedFunction = generateCodeInParallel(state, module, engine);
+            if (!state.generatedFunction)
+                state.generatedFunction = reinterpret_cast<GeneratedFunction>(llvm->GetPointerToGlobal(engine, state.function));
+        }
         if (functionPasses)
             llvm->DisposePassManager(functionPasses);
         llvm->DisposePassManager(modulePasses);
@@ -1353,11 +1447,11 @@ void compile(State& state, Safepoint::Result& safepointResult)
         }
 
 
+        DFG::PhaseTimer stackmapsTimer(phaseTimes, "FTL stackmaps");
+
         // JSCPOLLY COMMENT
         // Parse stackmap section to create structured representation of it
-        RefPtr<DataView> stackmapsData = DataView::create(
-            ArrayBuffer::create(state.stackmapsSection->base(), state.stackmapsSection->size()));
-        state.jitCode->stackmaps.parse(stackmapsData.get());
+        state.jitCode->stackmaps.parse(state.stackmapsSection->base(), state.stackmapsSection->size());
 
         // JSCPOLLY COMMENT
         // Dumps structured view of stackmaps section
@@ -1368,7 +1462,7 @@ void compile(State& state, Safepoint::Result& safepointResult)
 
         // JSCPOLLY COMMENT
         // Computes map between stackmap IDs and associated records
-        StackMaps::RecordMap recordMap = state.jitCode->stackmaps.computeRecordMap();
+        StackMaps::RecordMap recordMap(state.jitCode->stackmaps);
 
         // JSCPOLLY COMMENT
         // Patch the code
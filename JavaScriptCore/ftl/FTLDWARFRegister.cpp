@@ -70,6 +70,43 @@ Reg DWARFRegister::reg() const
     return Reg();
 }
 
+DWARFRegister DWARFRegister::forReg(Reg reg)
+{
+#if CPU(X86_64)
+    if (reg.isGPR()) {
+        switch (reg.gpr()) {
+        case X86Registers::eax:
+            return DWARFRegister(0);
+        case X86Registers::edx:
+            return DWARFRegister(1);
+        case X86Registers::ecx:
+            return DWARFRegister(2);
+        case X86Registers::ebx:
+            return DWARFRegister(3);
+        case X86Registers::esi:
+            return DWARFRegister(4);
+        case X86Registers::edi:
+            return DWARFRegister(5);
+        case X86Registers::ebp:
+            return DWARFRegister(6);
+        case X86Registers::esp:
+            return DWARFRegister(7);
+        default:
+            // Registers r8..r15 are numbered sensibly.
+            return DWARFRegister(static_cast<int16_t>(reg.gpr()));
+        }
+    }
+    return DWARFRegister(static_cast<int16_t>(17 + reg.fpr()));
+#elif CPU(ARM64)
+    if (reg.isGPR())
+        return DWARFRegister(static_cast<int16_t>(reg.gpr()));
+    return DWARFRegister(static_cast<int16_t>(64 + reg.fpr()));
+#else
+    UNUSED_PARAM(reg);
+    return DWARFRegister();
+#endif
+}
+
 void DWARFRegister::dump(PrintStream& out) const
 {
     Reg reg = this->reg();
@@ -45,6 +45,9 @@ public:
     {
     }
     
+    // The inverse of reg(), for code that knows the machine register but deals in Locations.
+    static DWARFRegister forReg(Reg);
+    
     int16_t dwarfRegNum() const { return m_dwarfRegNum; }
     
     Reg reg() const; // This may return Reg() if it can't parse the Dwarf register number.
@@ -82,8 +82,11 @@ void ExitThunkGenerator::emitThunk(unsigned index, int32_t osrExitFromGenericUnw
 
 void ExitThunkGenerator::emitThunks(int32_t osrExitFromGenericUnwindStackSpillSlot)
 {
-    for (unsigned i = 0; i < m_state.finalizer->osrExit.size(); ++i)
+    for (unsigned i = 0; i < m_state.finalizer->osrExit.size(); ++i) {
+        if (m_state.jitCode->osrExit[i].usesSharedExitThunk())
+            continue;
         emitThunk(i, osrExitFromGenericUnwindStackSpillSlot);
+    }
 }
 
 } } // namespace JSC::FTL
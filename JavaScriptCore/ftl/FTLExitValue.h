@@ -70,6 +70,37 @@ public:
     
     bool operator!() const { return m_kind == InvalidExitValue; }
     
+    bool operator==(const ExitValue& other) const
+    {
+        if (m_kind != other.m_kind)
+            return false;
+        switch (m_kind) {
+        case InvalidExitValue:
+        case ExitValueDead:
+            return true;
+        case ExitValueArgument:
+            return u.argument.format == other.u.argument.format
+                && u.argument.argument == other.u.argument.argument;
+        case ExitValueConstant:
+            return u.constant == other.u.constant;
+        case ExitValueInJSStack:
+        case ExitValueInJSStackAsInt32:
+        case ExitValueInJSStackAsInt52:
+        case ExitValueInJSStackAsDouble:
+            return u.virtualRegister == other.u.virtualRegister;
+        case ExitValueRecovery:
+            return u.recovery.leftArgument == other.u.recovery.leftArgument
+                && u.recovery.rightArgument == other.u.recovery.rightArgument
+                && u.recovery.opcode == other.u.recovery.opcode
+                && u.recovery.format == other.u.recovery.format;
+        case ExitValueMaterializeNewObject:
+            return u.newObjectMaterializationData == other.u.newObjectMaterializationData;
+        }
+        RELEASE_ASSERT_NOT_REACHED();
+        return false;
+    }
+    bool operator!=(const ExitValue& other) const { return !(*this == other); }
+    
     static ExitValue dead()
     {
         ExitValue result;
@@ -37,6 +37,12 @@ JITCode::JITCode()
 {
 }
 
+void JITCode::initializePollyTierUpCounter()
+{
+    isPollyTierUpCandidate = true;
+    pollyTierUpCounter = -static_cast<int32_t>(Options::jscpollyTierUpLoopIterations());
+}
+
 JITCode::~JITCode()
 {
     if (FTL::shouldDumpDisassembly()) {
@@ -169,6 +175,17 @@ RegisterSet JITCode::liveRegistersToPreserveAtExceptionHandlingCallSite(CodeBloc
     return RegisterSet();
 }
 
+static void* getReturnAddress(JITCode::OSRExitCallSite* callSite)
+{
+    return callSite->returnAddress;
+}
+
+unsigned JITCode::osrExitIndexForCallSite(void* returnAddress) const
+{
+    return binarySearch<OSRExitCallSite, void*>(
+        osrExitCallSites, osrExitCallSites.size(), returnAddress, getReturnAddress)->exitIndex;
+}
+
 } } // namespace JSC::FTL
 
 #endif // ENABLE(FTL_JIT)
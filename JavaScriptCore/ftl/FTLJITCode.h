@@ -36,6 +36,7 @@
 #include "FTLUnwindInfo.h"
 #include "JITCode.h"
 #include "LLVMAPI.h"
+#include <wtf/HashMap.h>
 #include <wtf/RefCountedArray.h>
 
 #if OS(DARWIN)
@@ -104,6 +105,32 @@ public:
     StackMaps stackmaps;
 
     Vector<std::unique_ptr<LazySlowPath>> lazySlowPaths;
+
+    // The exits that use the shared exit thunk, sorted by the return address of their call to it.
+    struct OSRExitCallSite {
+        void* returnAddress;
+        unsigned exitIndex;
+    };
+    Vector<OSRExitCallSite> osrExitCallSites;
+    unsigned osrExitIndexForCallSite(void* returnAddress) const;
+
+    // The exits whose code has been compiled, keyed by a hash of the way they lay out their
+    // exit values. Exits that only differ in where they came from can share that code.
+    HashMap<unsigned, Vector<unsigned>, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> osrExitsByLayout;
+    unsigned numberOfOSRExitsSharingCode { 0 };
+
+    // JSCPOLLY COMMENT
+    // Plain FTL code for a function that the polly policy selected counts loop iterations
+    // in pollyTierUpCounter. The counter starts out negative and is counted up until it
+    // becomes non-negative, at which point we recompile the function with polly on the
+    // FTL worklist.
+    void initializePollyTierUpCounter();
+    void deferPollyTierUpIndefinitely() { pollyTierUpCounter = std::numeric_limits<int32_t>::min(); }
+    void forcePollyTierUpSlowPathConcurrently() { pollyTierUpCounter = 0; }
+
+    bool isPollyTierUpCandidate { false };
+    bool didTriggerPollyTierUp { false };
+    int32_t pollyTierUpCounter { 0 };
     
 private:
     CodePtr m_addressForCall;
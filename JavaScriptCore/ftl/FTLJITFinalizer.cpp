@@ -102,6 +102,8 @@ bool JITFinalizer::finalizeFunction()
 
     if (exitThunksLinkBuffer) {
         for (unsigned i = 0; i < osrExit.size(); ++i) {
+            if (jitCode->osrExit[i].usesSharedExitThunk())
+                continue;
             OSRExitCompilationInfo& info = osrExit[i];
             exitThunksLinkBuffer->link(
                 info.m_thunkJump,
@@ -114,6 +116,15 @@ bool JITFinalizer::finalizeFunction()
                 dumpDisassembly, *exitThunksLinkBuffer,
                 ("FTL exit thunks for %s", toCString(CodeBlockWithJITType(m_plan.codeBlock, JITCode::FTLJIT)).data())));
     } // else this function had no OSR exits, so no exit thunks.
+
+#if CPU(X86_64)
+    if (!jitCode->osrExitCallSites.isEmpty()) {
+        CodeLocationLabel sharedExitThunk(
+            m_plan.vm.getCTIStub(osrExitFromCallGenerationThunkGenerator).code());
+        for (JITCode::OSRExitCallSite& callSite : jitCode->osrExitCallSites)
+            MacroAssembler::replaceWithCall(jitCode->osrExit[callSite.exitIndex].exitSite(), sharedExitThunk);
+    }
+#endif
     
     if (sideCodeLinkBuffer) {
         // Side code is for special slow paths that we generate ourselves, like for inline
@@ -48,6 +48,7 @@ JSCallBase::JSCallBase(CallLinkInfo::CallType type, CodeOrigin semantic, CodeOri
     , m_semanticeOrigin(semantic)
     , m_callSiteDescriptionOrigin(callSiteDescription)
     , m_callLinkInfo(nullptr)
+    , m_correspondingGenericUnwindOSRExit(nullptr)
 {
 }
 
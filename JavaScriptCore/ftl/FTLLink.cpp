@@ -167,7 +167,8 @@ void link(State& state)
     }
     
     switch (graph.m_plan.mode) {
-    case FTLMode: {
+    case FTLMode:
+    case FTLForPollyMode: {
         CCallHelpers::JumpList mainPathJumps;
     
         jit.load32(
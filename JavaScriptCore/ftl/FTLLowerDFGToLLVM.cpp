@@ -30,9 +30,13 @@
 
 #if ENABLE(FTL_JIT)
 
+#include "AirCode.h"
+#include "B3PatchpointValue.h"
+#include "CallFrameShuffler.h"
 #include "CodeBlockWithJITType.h"
 #include "DFGAbstractInterpreterInlines.h"
 #include "DFGDominators.h"
+#include "DFGInductionVariables.h"
 #include "DFGInPlaceAbstractState.h"
 #include "DFGOSRAvailabilityAnalysisPhase.h"
 #include "DFGOSRExitFuzz.h"
@@ -48,15 +52,20 @@
 #include "FTLLoweredNodeValue.h"
 #include "FTLOperations.h"
 #include "FTLOutput.h"
+#include "FTLPollyPolicy.h"
+#include "FTLPollyReport.h"
+#include "FTLTargetFeatures.h"
 #include "FTLThunks.h"
 #include "FTLWeightedTarget.h"
 #include "JSArrowFunction.h"
 #include "JSCInlines.h"
 #include "JSLexicalEnvironment.h"
+#include "LinkBuffer.h"
 #include "OperandsInlines.h"
 #include "ScopedArguments.h"
 #include "ScopedArgumentsTable.h"
 #include "ScratchRegisterAllocator.h"
+#include "ThunkGenerators.h"
 #include "VirtualRegister.h"
 #include "Watchdog.h"
 #include <atomic>
@@ -75,7 +84,9 @@ namespace {
 std::atomic<int> compileCounter;
 
 // Begin JSCPOLLY
+#if !FTL_USES_B3
 LValue osrExitStringAlloca;
+#endif
 // End JSCPOLLY
 
 #if ASSERT_DISABLED
@@ -83,7 +94,7 @@ NO_RETURN_DUE_TO_CRASH static void ftlUnreachable()
 {
     CRASH();
 }
-#elif !FTL_USES_B3
+#else
 NO_RETURN_DUE_TO_CRASH static void ftlUnreachable(
     CodeBlock* codeBlock, BlockIndex blockIndex, unsigned nodeIndex)
 {
@@ -122,11 +133,14 @@ public:
 #if !FTL_USES_B3
         , m_tbaaKind(mdKindID(state.context, "tbaa"))
         , m_tbaaStructKind(mdKindID(state.context, "tbaa.struct"))
+        , m_aliasScopeKind(mdKindID(state.context, "alias.scope"))
+        , m_noAliasKind(mdKindID(state.context, "noalias"))
 #endif
     {
     }
 
     // BEGIN JSCPOLLY
+#if !FTL_USES_B3
     void set_string(LValue dest, const char* s) {
     	size_t idx = 0;
     	while (1) {
@@ -156,6 +170,7 @@ public:
     	indicesNull[1] = m_out.constInt32(idx);
     	m_out.set(cv, buildGEP(m_out.m_builder, dest, indicesNull, 2));
     }
+#endif // !FTL_USES_B3
     // END JSCPOLLY
 
     void lower()
@@ -181,11 +196,6 @@ public:
         m_ftlState.function = addFunction(
             m_ftlState.module, name.data(), functionType(m_out.int64));
         setFunctionCallingConv(m_ftlState.function, LLVMCCallConv);
-        if (isX86() && Options::llvmDisallowAVX()) {
-            // AVX makes V8/raytrace 80% slower. It makes Kraken/audio-oscillator 4.5x
-            // slower. It should be disabled.
-            addTargetDependentFunctionAttr(m_ftlState.function, "target-features", "-avx");
-        }
 #endif // !FTL_USES_B3
 
         if (verboseCompilationEnabled())
@@ -208,6 +218,14 @@ public:
             m_highBlock = m_graph.block(blockIndex);
             if (!m_highBlock)
                 continue;
+#if !FTL_USES_B3
+            // JSCPOLLY COMMENT
+            // The Polly report maps regions back to DFG blocks by name.
+            if (m_ftlState.withPolly) {
+                m_blocks.add(m_highBlock, m_out.newBlock(pollyBlockName(m_highBlock).data()));
+                continue;
+            }
+#endif
             m_blocks.add(m_highBlock, FTL_NEW_BLOCK(m_out, ("Block ", *m_highBlock)));
         }
 
@@ -364,7 +382,7 @@ public:
         m_out.appendTo(stackOverflow, m_handleExceptions);
         m_out.call(m_out.voidType, m_out.operation(operationThrowStackOverflowError), m_callFrame, m_out.constIntPtr(codeBlock()));
 #if FTL_USES_B3
-        // FIXME
+        jumpToExceptionHandler(lookupExceptionHandlerFromCallerFrame);
 #else
         m_ftlState.handleStackOverflowExceptionStackmapID = m_stackmapIDs++;
         m_out.call(
@@ -376,7 +394,7 @@ public:
 
         m_out.appendTo(m_handleExceptions, checkArguments);
 #if FTL_USES_B3
-        // FIXME
+        jumpToExceptionHandler(lookupExceptionHandler);
 #else
         m_ftlState.handleExceptionStackmapID = m_stackmapIDs++;
         m_out.call(
@@ -439,10 +457,31 @@ public:
         }
         m_out.jump(lowBlock(m_graph.block(0)));
 
+#if !FTL_USES_B3
+        // JSCPOLLY COMMENT
+        // Polly needs to know which arrays of a loop cannot alias each other. The loop
+        // predication phase has already pulled what bounds checks it could out of the loops.
+        if (m_ftlState.withPolly && Options::jscpollyAliasChecks()) {
+            m_graph.ensureNaturalLoops();
+            findLoopAliasGuards(InductionVariables(m_graph));
+        }
+#endif
+
         for (DFG::BasicBlock* block : preOrder)
             compileBlock(block);
 
 #if !FTL_USES_B3
+        // LLVM would keep AVX values live across the patchpoints of inline caches and lazy slow
+        // paths, which only preserve the double part of the FP registers. See FTLTargetFeatures.h.
+        bool allowAVX = m_ftlState.getByIds.isEmpty()
+            && m_ftlState.putByIds.isEmpty()
+            && m_ftlState.checkIns.isEmpty()
+            && m_ftlState.arithSubs.isEmpty()
+            && m_ftlState.lazySlowPaths.isEmpty();
+        CString features = targetFeatures(allowAVX);
+        if (!features.isNull())
+            addTargetDependentFunctionAttr(m_ftlState.function, "target-features", features.data());
+
         if (Options::dumpLLVMIR())
             dumpModule(m_ftlState.module);
         if (verboseCompilationEnabled())
@@ -774,6 +813,9 @@ private:
         case CheckInBounds:
             compileCheckInBounds();
             break;
+        case CheckNoHolesInRange:
+            compileCheckNoHolesInRange();
+            break;
         case GetByVal:
             compileGetByVal();
             break;
@@ -1045,9 +1087,11 @@ private:
         case CopyRest:
             compileCopyRest();
             break;
+        case LoopHint:
+            compileLoopHint();
+            break;
 
         case PhantomLocal:
-        case LoopHint:
         case MovHint:
         case ZombieHint:
         case ExitOK:
@@ -1591,6 +1635,13 @@ private:
             LValue left = lowInt32(m_node->child1());
             LValue right = lowInt32(m_node->child2());
 
+#if !FTL_USES_B3
+            if (m_node->arithMode() == Arith::ProvedNoOverflow) {
+                setInt32(isSub ? m_out.subNSW(left, right) : m_out.addNSW(left, right));
+                break;
+            }
+#endif
+
             if (!shouldCheckOverflow(m_node->arithMode())) {
                 setInt32(isSub ? m_out.sub(left, right) : m_out.add(left, right));
                 break;
@@ -1635,6 +1686,17 @@ private:
             }
 
             speculate(Overflow, noValue(), 0, m_out.extractValue(result, 1));
+
+            // BEGIN JSCPOLLY
+            // Past the overflow check the result is the same as that of an nsw operation, and
+            // unlike the extracted value scalar evolution can see through the latter. This is
+            // what lets polly delinearize a flattened a[i * n + j] access.
+            if (m_ftlState.withPolly) {
+                setInt32(isSub ? m_out.subNSW(left, right) : m_out.addNSW(left, right));
+                break;
+            }
+            // END JSCPOLLY
+
             setInt32(m_out.extractValue(result, 0));
 #endif // FTL_USES_B3
             break;
@@ -1711,14 +1773,17 @@ private:
                 break;
             }
 
+#if FTL_USES_B3
+            // FIXME: Use the sub IC once B3 can give JITSubGenerator the registers it needs.
+            setJSValue(vmCall(
+                m_out.int64, m_out.operation(operationValueSub), m_callFrame,
+                lowJSValue(m_node->child1()), lowJSValue(m_node->child2())));
+#else
             unsigned stackmapID = m_stackmapIDs++;
 
             if (Options::verboseCompilation())
                 dataLog("    Emitting ArithSub patchpoint with stackmap #", stackmapID, "\n");
 
-#if FTL_USES_B3
-            CRASH();
-#else
             LValue left = lowJSValue(m_node->child1());
             LValue right = lowJSValue(m_node->child2());
 
@@ -1767,6 +1832,11 @@ private:
 
             LValue result;
 
+#if !FTL_USES_B3
+            if (m_node->arithMode() == Arith::ProvedNoOverflow)
+                result = m_out.mulNSW(left, right);
+            else
+#endif
             if (!shouldCheckOverflow(m_node->arithMode()))
                 result = m_out.mul(left, right);
             else {
@@ -1777,7 +1847,13 @@ private:
 #else // FTL_USES_B3
                 LValue overflowResult = m_out.mulWithOverflow32(left, right);
                 speculate(Overflow, noValue(), 0, m_out.extractValue(overflowResult, 1));
-                result = m_out.extractValue(overflowResult, 0);
+                // BEGIN JSCPOLLY
+                // See compileArithAddOrSub().
+                if (m_ftlState.withPolly)
+                    result = m_out.mulNSW(left, right);
+                else
+                // END JSCPOLLY
+                    result = m_out.extractValue(overflowResult, 0);
 #endif // FTL_USES_B3
             }
 
@@ -2238,11 +2314,17 @@ private:
             if (!shouldCheckOverflow(m_node->arithMode()))
                 result = m_out.neg(value);
             else if (!shouldCheckNegativeZero(m_node->arithMode())) {
+#if FTL_USES_B3
+                B3::CheckValue* check = m_out.speculateSub(m_out.int32Zero, value);
+                blessSpeculation(check, Overflow, noValue(), nullptr, m_origin);
+                result = check;
+#else
                 // We don't have a negate-with-overflow intrinsic. Hopefully this
                 // does the trick, though.
                 LValue overflowResult = m_out.subWithOverflow32(m_out.int32Zero, value);
                 speculate(Overflow, noValue(), 0, m_out.extractValue(overflowResult, 1));
                 result = m_out.extractValue(overflowResult, 0);
+#endif
             } else {
                 speculate(Overflow, noValue(), 0, m_out.testIsZero32(value, m_out.constInt32(0x7fffffff)));
                 result = m_out.neg(value);
@@ -2264,9 +2346,14 @@ private:
             }
 
             LValue value = lowInt52(m_node->child1());
+#if FTL_USES_B3
+            B3::CheckValue* result = m_out.speculateSub(m_out.int64Zero, value);
+            blessSpeculation(result, Int52Overflow, noValue(), nullptr, m_origin);
+#else
             LValue overflowResult = m_out.subWithOverflow64(m_out.int64Zero, value);
             speculate(Int52Overflow, noValue(), 0, m_out.extractValue(overflowResult, 1));
             LValue result = m_out.extractValue(overflowResult, 0);
+#endif
             speculate(NegativeZero, noValue(), 0, m_out.isZero64(result));
             setInt52(result);
             break;
@@ -2550,8 +2637,63 @@ private:
         ASSERT(m_node->child1().useKind() == CellUse);
 
 #if FTL_USES_B3
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
+        if (!canLowerThrowingPatchpoint())
+            return;
+
+        LValue base = lowCell(m_node->child1());
+        LValue value = lowJSValue(m_node->child2());
+        auto uid = m_graph.identifiers()[m_node->identifierNumber()];
+
+        CodeOrigin semanticOrigin = m_node->origin.semantic;
+        CallSiteIndex callSiteIndex = m_ftlState.jitCode->common.addCodeOrigin(semanticOrigin);
+        ECMAMode ecmaMode = m_graph.executableFor(semanticOrigin)->ecmaMode();
+        PutKind putKind = m_node->op() == PutByIdDirect ? Direct : NotDirect;
+        VM* vm = &this->vm();
+
+        B3::PatchpointValue* patchpoint = m_out.patchpoint(B3::Void);
+        patchpoint->appendSomeRegister(base);
+        patchpoint->appendSomeRegister(value);
+        // The inline cache needs a scratch register. B3 may still hand us the inputs in clobbered
+        // registers, so clobber enough of them that one is always left over.
+        patchpoint->clobber(RegisterSet(GPRInfo::regT0, GPRInfo::regT1, GPRInfo::regT2));
+        patchpoint->setGenerator(
+            [=] (CCallHelpers& jit, const B3::StackmapGenerationParams& params) {
+                GPRReg baseGPR = params.reps[0].gpr();
+                GPRReg valueGPR = params.reps[1].gpr();
+                GPRReg scratchGPR = GPRInfo::regT0;
+                while (scratchGPR == baseGPR || scratchGPR == valueGPR)
+                    scratchGPR = scratchGPR == GPRInfo::regT0 ? GPRInfo::regT1 : GPRInfo::regT2;
+
+                RegisterSet usedRegisters = usedRegistersFor(params);
+
+                JITPutByIdGenerator gen(
+                    jit.codeBlock(), semanticOrigin, callSiteIndex, usedRegisters, JSValueRegs(baseGPR),
+                    JSValueRegs(valueGPR), scratchGPR, ecmaMode, putKind);
+
+                gen.generateFastPath(jit);
+                CCallHelpers::Jump done = jit.jump();
+
+                gen.slowPathJump().link(&jit);
+                CCallHelpers::Label slowPathBegin = jit.label();
+                CCallHelpers::JumpList exceptions;
+                CCallHelpers::Call slowPathCall = callOperation(
+                    usedRegisters, jit, callSiteIndex, &exceptions, gen.slowPathFunction(), InvalidGPRReg,
+                    CCallHelpers::TrustedImmPtr(gen.stubInfo()), valueGPR, baseGPR,
+                    CCallHelpers::TrustedImmPtr(uid)).call();
+                gen.reportSlowPathCall(slowPathBegin, slowPathCall);
+                CCallHelpers::Jump slowPathDone = jit.jump();
+
+                exceptions.link(&jit);
+                emitJumpToExceptionHandler(jit, vm, lookupExceptionHandler);
+
+                done.link(&jit);
+                slowPathDone.link(&jit);
+
+                jit.addLinkTask(
+                    [=] (LinkBuffer& linkBuffer) mutable {
+                        gen.finalize(linkBuffer);
+                    });
+            });
 #else
         LValue base = lowCell(m_node->child1());
         LValue value = lowJSValue(m_node->child2());
@@ -2722,6 +2864,30 @@ private:
         }
     }
 
+    // JSCPOLLY COMMENT
+    // Count loop iterations in plain FTL code for functions that get a polly tier-up.
+    void compileLoopHint()
+    {
+        if (!m_ftlState.jitCode->isPollyTierUpCandidate)
+            return;
+
+        TypedPointer counter = m_out.absolute(&m_ftlState.jitCode->pollyTierUpCounter);
+        LValue count = m_out.add(m_out.load32(counter), m_out.int32One);
+        m_out.store32(count, counter);
+
+        LBasicBlock tierUp = FTL_NEW_BLOCK(m_out, ("LoopHint polly tier up"));
+        LBasicBlock continuation = FTL_NEW_BLOCK(m_out, ("LoopHint continuation"));
+
+        m_out.branch(
+            m_out.greaterThanOrEqual(count, m_out.int32Zero), rarely(tierUp), usually(continuation));
+
+        LBasicBlock lastNext = m_out.appendTo(tierUp, continuation);
+        vmCall(m_out.voidType, m_out.operation(operationTriggerPollyTierUp), m_callFrame);
+        m_out.jump(continuation);
+
+        m_out.appendTo(continuation, lastNext);
+    }
+
     void compileCheckInBounds()
     {
         speculate(
@@ -2729,6 +2895,61 @@ private:
             m_out.aboveOrEqual(lowInt32(m_node->child1()), lowInt32(m_node->child2())));
     }
 
+    // Scans the elements from child2 to child3, inclusive, so that the loop after us can load
+    // them without checking for holes. All of the exits are LoadFromHole, so that if this keeps
+    // failing we go back to checking every load.
+    void compileCheckNoHolesInRange()
+    {
+        LValue storage = lowStorage(m_node->child1());
+        LValue low = lowInt32(m_node->child2());
+        LValue high = lowInt32(m_node->child3());
+
+        // The loads that rely on this scan have lost their bounds checks too, so an empty range
+        // can't be allowed to pass.
+        LValue publicLength = m_out.load32NonNegative(storage, m_heaps.Butterfly_publicLength);
+        speculate(
+            LoadFromHole, noValue(), 0,
+            m_out.bitOr(
+                m_out.lessThan(high, low),
+                m_out.bitOr(m_out.aboveOrEqual(low, publicLength), m_out.aboveOrEqual(high, publicLength))));
+
+        LBasicBlock loop = FTL_NEW_BLOCK(m_out, ("CheckNoHolesInRange loop"));
+        LBasicBlock continuation = FTL_NEW_BLOCK(m_out, ("CheckNoHolesInRange continuation"));
+
+        ValueFromBlock originalIndex = m_out.anchor(low);
+        m_out.jump(loop);
+
+        LBasicBlock lastNext = m_out.appendTo(loop, continuation);
+        LValue index = m_out.phi(m_out.int32, originalIndex);
+
+        LValue isHole;
+        switch (m_node->arrayMode().type()) {
+        case Array::Int32:
+        case Array::Contiguous: {
+            IndexedAbstractHeap& heap = m_node->arrayMode().type() == Array::Int32 ?
+                m_heaps.indexedInt32Properties : m_heaps.indexedContiguousProperties;
+            isHole = m_out.isZero64(m_out.load64(m_out.baseIndex(heap, storage, m_out.zeroExtPtr(index))));
+            break;
+        }
+        case Array::Double: {
+            LValue value = m_out.loadDouble(
+                m_out.baseIndex(m_heaps.indexedDoubleProperties, storage, m_out.zeroExtPtr(index)));
+            isHole = m_out.doubleNotEqualOrUnordered(value, value);
+            break;
+        }
+        default:
+            DFG_CRASH(m_graph, m_node, "Bad array type");
+            return;
+        }
+        speculate(LoadFromHole, noValue(), 0, isHole);
+
+        LValue nextIndex = m_out.add(index, m_out.int32One);
+        m_out.addIncomingToPhi(index, m_out.anchor(nextIndex));
+        m_out.branch(m_out.lessThanOrEqual(nextIndex, high), unsure(loop), unsure(continuation));
+
+        m_out.appendTo(continuation, lastNext);
+    }
+
     // An array read
     void compileGetByVal()
     {
@@ -2744,9 +2965,10 @@ private:
                 m_heaps.indexedInt32Properties : m_heaps.indexedContiguousProperties;
 
             // BEGIN JSCPOLLY
+#if !FTL_USES_B3
             if (m_ftlState.withPolly) {
 				// Do the intoptr instruction in the current block
-				TypedPointer pointer = basePtr(heap, storage, index, m_node->child2());
+				TypedPointer pointer = basePtr(heap, storage, m_out.int64);
 
 				// And create a new block to do the load
 				LBasicBlock getblock = FTL_NEW_BLOCK(m_out, ("getblock"));
@@ -2756,6 +2978,13 @@ private:
 				// The accessed value is in the array, no need to reallocate
 				if (m_node->arrayMode().isInBounds()) {
 					LValue result = m_out.loadArray(pointer, index, provenValue(m_node->child2()));
+					decorateArrayAccess(result);
+
+					// A CheckNoHolesInRange before the loop already scanned this element
+					if (m_node->arrayMode().isHoleFree()) {
+						setJSValue(result);
+						return;
+					}
 
 					// Test whether the accessed value is a hole in the array or not
 					LValue isHole = m_out.isZero64(result);
@@ -2770,24 +2999,26 @@ private:
 					return;
 				}
             }
-			else {
-			// END JSCPOLLY
-
-				if (m_node->arrayMode().isInBounds()) {
-					LValue result = m_out.load64(baseIndex(heap, storage, index, m_node->child2()));
-					LValue isHole = m_out.isZero64(result);
-					if (m_node->arrayMode().isSaneChain()) {
-						DFG_ASSERT(
-								m_graph, m_node, m_node->arrayMode().type() == Array::Contiguous);
-						result = m_out.select(
-								isHole, m_out.constInt64(JSValue::encode(jsUndefined())), result);
-					} else
-					speculate(LoadFromHole, noValue(), 0, isHole);
-					setJSValue(result);
-					return;
-				}
-			}
+#endif // !FTL_USES_B3
+            // END JSCPOLLY
 
+            if (m_node->arrayMode().isInBounds()) {
+                LValue result = m_out.load64(baseIndex(heap, storage, index, m_node->child2()));
+                if (m_node->arrayMode().isHoleFree()) {
+                    setJSValue(result);
+                    return;
+                }
+                LValue isHole = m_out.isZero64(result);
+                if (m_node->arrayMode().isSaneChain()) {
+                    DFG_ASSERT(
+                        m_graph, m_node, m_node->arrayMode().type() == Array::Contiguous);
+                    result = m_out.select(
+                        isHole, m_out.constInt64(JSValue::encode(jsUndefined())), result);
+                } else
+                    speculate(LoadFromHole, noValue(), 0, isHole);
+                setJSValue(result);
+                return;
+            }
 
             // The value is not in bounds, reallocate the array to get it
             LValue base = lowCell(m_node->child1());
@@ -2825,10 +3056,19 @@ private:
             IndexedAbstractHeap& heap = m_heaps.indexedDoubleProperties;
 
             if (m_node->arrayMode().isInBounds()) {
-                LValue result = m_out.loadDouble(
-                    baseIndex(heap, storage, index, m_node->child2()));
+                LValue result;
+                // BEGIN JSCPOLLY
+#if !FTL_USES_B3
+                if (m_ftlState.withPolly) {
+                    result = m_out.loadArray(
+                        basePtr(heap, storage, m_out.doubleType), index, provenValue(m_node->child2()));
+                    decorateArrayAccess(result);
+                } else
+#endif
+                // END JSCPOLLY
+                    result = m_out.loadDouble(baseIndex(heap, storage, index, m_node->child2()));
 
-                if (!m_node->arrayMode().isSaneChain()) {
+                if (!m_node->arrayMode().isSaneChain() && !m_node->arrayMode().isHoleFree()) {
                     speculate(
                         LoadFromHole, noValue(), 0,
                         m_out.doubleNotEqualOrUnordered(result, result));
@@ -2969,28 +3209,44 @@ private:
             TypedArrayType type = m_node->arrayMode().typedArrayType();
 
             if (isTypedView(type)) {
-                TypedPointer pointer = TypedPointer(
-                    m_heaps.typedArrayProperties,
-                    m_out.add(
-                        storage,
-                        m_out.shl(
-                            m_out.zeroExtPtr(index),
-                            m_out.constIntPtr(logElementSize(type)))));
+                TypedPointer pointer;
+                // BEGIN JSCPOLLY
+                // Polly addresses the element with a GEP instead, see loadTypedArrayElement().
+#if !FTL_USES_B3
+                if (!m_ftlState.withPolly)
+#endif
+                // END JSCPOLLY
+                    pointer = TypedPointer(
+                        m_heaps.typedArrayProperties,
+                        m_out.add(
+                            storage,
+                            m_out.shl(
+                                m_out.zeroExtPtr(index),
+                                m_out.constIntPtr(logElementSize(type)))));
 
                 if (isInt(type)) {
                     LValue result;
-                    switch (elementSize(type)) {
-                    case 1:
-                        result = isSigned(type) ? m_out.load8SignExt32(pointer) :  m_out.load8ZeroExt32(pointer);
-                        break;
-                    case 2:
-                        result = isSigned(type) ? m_out.load16SignExt32(pointer) :  m_out.load16ZeroExt32(pointer);
-                        break;
-                    case 4:
-                        result = m_out.load32(pointer);
-                        break;
-                    default:
-                        DFG_CRASH(m_graph, m_node, "Bad element size");
+                    // BEGIN JSCPOLLY
+#if !FTL_USES_B3
+                    if (m_ftlState.withPolly)
+                        result = loadTypedArrayElement(type, storage, index);
+                    else
+#endif
+                    // END JSCPOLLY
+                    {
+                        switch (elementSize(type)) {
+                        case 1:
+                            result = isSigned(type) ? m_out.load8SignExt32(pointer) :  m_out.load8ZeroExt32(pointer);
+                            break;
+                        case 2:
+                            result = isSigned(type) ? m_out.load16SignExt32(pointer) :  m_out.load16ZeroExt32(pointer);
+                            break;
+                        case 4:
+                            result = m_out.load32(pointer);
+                            break;
+                        default:
+                            DFG_CRASH(m_graph, m_node, "Bad element size");
+                        }
                     }
 
                     if (elementSize(type) < 4 || isSigned(type)) {
@@ -3016,6 +3272,15 @@ private:
 
                 ASSERT(isFloat(type));
 
+                // BEGIN JSCPOLLY
+#if !FTL_USES_B3
+                if (m_ftlState.withPolly) {
+                    setDouble(loadTypedArrayElement(type, storage, index));
+                    return;
+                }
+#endif
+                // END JSCPOLLY
+
                 LValue result;
                 switch (type) {
                 case TypeFloat32:
@@ -3131,6 +3396,7 @@ private:
                     FTL_TYPE_CHECK(jsValueValue(value), child3, SpecInt32, isNotInt32(value));
 
                 // BEGIN JSCPOLLY
+#if !FTL_USES_B3
                 if (m_ftlState.withPolly) {
 					IndexedAbstractHeap& heap = m_node->arrayMode().type() == Array::Int32 ?
 							m_heaps.indexedInt32Properties : m_heaps.indexedContiguousProperties;
@@ -3141,7 +3407,7 @@ private:
 					m_out.appendTo(storeblock);
 
 					// Do the intoptr instruction in the current block
-					TypedPointer baseArray = m_out.baseArray(heap, storage, m_out.zeroExtPtr(index), provenValue(child2));
+					TypedPointer baseArray = m_out.baseArray(heap, storage, m_out.int64);
 
 					// And create a new block to do the store
 					// added block name
@@ -3150,7 +3416,7 @@ private:
 					m_out.appendTo(putblock);
 
 					if (m_node->op() == PutByValAlias) {
-						m_out.storeArray(value, baseArray, index);
+						decorateArrayAccess(m_out.storeArray(value, baseArray, index));
 						break;
 					}
 
@@ -3160,31 +3426,30 @@ private:
 						: operationPutByValBeyondArrayBoundsNonStrict,
 						base, storage, index, value, continuation);
 
-					m_out.storeArray(value, baseArray, index);
+					decorateArrayAccess(m_out.storeArray(value, baseArray, index));
 					break;
                 }
-                else {
+#endif // !FTL_USES_B3
                 // END JSCPOLLY
 
-					TypedPointer elementPointer = m_out.baseIndex(
-						m_node->arrayMode().type() == Array::Int32 ?
-						m_heaps.indexedInt32Properties : m_heaps.indexedContiguousProperties,
-						storage, m_out.zeroExtPtr(index), provenValue(child2));
+                TypedPointer elementPointer = m_out.baseIndex(
+                    m_node->arrayMode().type() == Array::Int32 ?
+                    m_heaps.indexedInt32Properties : m_heaps.indexedContiguousProperties,
+                    storage, m_out.zeroExtPtr(index), provenValue(child2));
 
-					if (m_node->op() == PutByValAlias) {
-						m_out.store64(value, elementPointer);
-						break;
-					}
+                if (m_node->op() == PutByValAlias) {
+                    m_out.store64(value, elementPointer);
+                    break;
+                }
 
-					contiguousPutByValOutOfBounds(
-						codeBlock()->isStrictMode()
-						? operationPutByValBeyondArrayBoundsStrict
-						: operationPutByValBeyondArrayBoundsNonStrict,
-						base, storage, index, value, continuation);
+                contiguousPutByValOutOfBounds(
+                    codeBlock()->isStrictMode()
+                    ? operationPutByValBeyondArrayBoundsStrict
+                    : operationPutByValBeyondArrayBoundsNonStrict,
+                    base, storage, index, value, continuation);
 
-					m_out.store64(value, elementPointer);
-					break;
-                }
+                m_out.store64(value, elementPointer);
+                break;
             }
 
             case Array::Double: {
@@ -3194,6 +3459,28 @@ private:
                     doubleValue(value), child3, SpecDoubleReal,
                     m_out.doubleNotEqualOrUnordered(value, value));
 
+                // BEGIN JSCPOLLY
+#if !FTL_USES_B3
+                if (m_ftlState.withPolly) {
+                    TypedPointer baseArray = basePtr(m_heaps.indexedDoubleProperties, storage, m_out.doubleType);
+
+                    if (m_node->op() == PutByValAlias) {
+                        decorateArrayAccess(m_out.storeArray(value, baseArray, index));
+                        break;
+                    }
+
+                    contiguousPutByValOutOfBounds(
+                        codeBlock()->isStrictMode()
+                        ? operationPutDoubleByValBeyondArrayBoundsStrict
+                        : operationPutDoubleByValBeyondArrayBoundsNonStrict,
+                        base, storage, index, value, continuation);
+
+                    decorateArrayAccess(m_out.storeArray(value, baseArray, index));
+                    break;
+                }
+#endif
+                // END JSCPOLLY
+
                 TypedPointer elementPointer = m_out.baseIndex(
                     m_heaps.indexedDoubleProperties, storage, m_out.zeroExtPtr(index),
                     provenValue(child2));
@@ -3225,18 +3512,23 @@ private:
         default:
 #if FTL_USES_B3
             UNUSED_PARAM(child5);
-            CRASH();
+            failLowering("typed array PutByVal");
 #else
             TypedArrayType type = m_node->arrayMode().typedArrayType();
 
             if (isTypedView(type)) {
-                TypedPointer pointer = TypedPointer(
-                    m_heaps.typedArrayProperties,
-                    m_out.add(
-                        storage,
-                        m_out.shl(
-                            m_out.zeroExt(index, m_out.intPtr),
-                            m_out.constIntPtr(logElementSize(type)))));
+                TypedPointer pointer;
+                // BEGIN JSCPOLLY
+                // Polly stores in-bounds elements with a GEP instead, see storeTypedArrayElement().
+                if (!m_ftlState.withPolly || !(m_node->arrayMode().isInBounds() || m_node->op() == PutByValAlias))
+                // END JSCPOLLY
+                    pointer = TypedPointer(
+                        m_heaps.typedArrayProperties,
+                        m_out.add(
+                            storage,
+                            m_out.shl(
+                                m_out.zeroExt(index, m_out.intPtr),
+                                m_out.constIntPtr(logElementSize(type)))));
 
                 LType refType;
                 LValue valueToStore;
@@ -3346,6 +3638,13 @@ private:
                     }
                 }
 
+                // BEGIN JSCPOLLY
+                if (m_ftlState.withPolly && (m_node->arrayMode().isInBounds() || m_node->op() == PutByValAlias)) {
+                    storeTypedArrayElement(type, valueToStore, storage, index);
+                    return;
+                }
+                // END JSCPOLLY
+
                 if (m_node->arrayMode().isInBounds() || m_node->op() == PutByValAlias)
                     m_out.store(valueToStore, pointer, refType);
                 else {
@@ -3408,10 +3707,6 @@ private:
 
     void compileArrayPush()
     {
-#if FTL_USES_B3
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
-#else
         LValue base = lowCell(m_node->child1());
         LValue storage = lowStorage(m_node->child3());
 
@@ -3420,7 +3715,9 @@ private:
         case Array::Contiguous:
         case Array::Double: {
             LValue value;
+#if !FTL_USES_B3
             LType refType;
+#endif
 
             if (m_node->arrayMode().type() != Array::Double) {
                 value = lowJSValue(m_node->child2(), ManualOperandSpeculation);
@@ -3428,13 +3725,17 @@ private:
                     FTL_TYPE_CHECK(
                         jsValueValue(value), m_node->child2(), SpecInt32, isNotInt32(value));
                 }
+#if !FTL_USES_B3
                 refType = m_out.ref64;
+#endif
             } else {
                 value = lowDouble(m_node->child2());
                 FTL_TYPE_CHECK(
                     doubleValue(value), m_node->child2(), SpecDoubleReal,
                     m_out.doubleNotEqualOrUnordered(value, value));
+#if !FTL_USES_B3
                 refType = m_out.refDouble;
+#endif
             }
 
             IndexedAbstractHeap& heap = m_heaps.forArrayType(m_node->arrayMode().type());
@@ -3451,8 +3752,12 @@ private:
                 rarely(slowPath), usually(fastPath));
 
             LBasicBlock lastNext = m_out.appendTo(fastPath, slowPath);
+#if FTL_USES_B3
+            m_out.store(value, m_out.baseIndex(heap, storage, m_out.zeroExtPtr(prevLength)));
+#else
             m_out.store(
                 value, m_out.baseIndex(heap, storage, m_out.zeroExtPtr(prevLength)), refType);
+#endif
             LValue newLength = m_out.add(prevLength, m_out.int32One);
             m_out.store32(newLength, storage, m_heaps.Butterfly_publicLength);
 
@@ -3478,7 +3783,6 @@ private:
             DFG_CRASH(m_graph, m_node, "Bad array type");
             return;
         }
-#endif
     }
 
     void compileArrayPop()
@@ -4217,10 +4521,17 @@ private:
         LValue length = m_out.load32(kids[0], m_heaps.JSString_length);
         for (unsigned i = 1; i < numKids; ++i) {
             flags = m_out.bitAnd(flags, m_out.load32(kids[i], m_heaps.JSString_flags));
+#if FTL_USES_B3
+            B3::CheckValue* lengthCheck = m_out.speculateAdd(
+                length, m_out.load32(kids[i], m_heaps.JSString_length));
+            blessSpeculation(lengthCheck, Uncountable, noValue(), nullptr, m_origin);
+            length = lengthCheck;
+#else
             LValue lengthAndOverflow = m_out.addWithOverflow32(
                 length, m_out.load32(kids[i], m_heaps.JSString_length));
             speculate(Uncountable, noValue(), 0, m_out.extractValue(lengthAndOverflow, 1));
             length = m_out.extractValue(lengthAndOverflow, 0);
+#endif
         }
         m_out.store32(
             m_out.bitAnd(m_out.constInt32(JSString::Is8Bit), flags),
@@ -4899,8 +5210,58 @@ private:
     void compileCallOrConstruct()
     {
 #if FTL_USES_B3
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
+        if (!canLowerThrowingPatchpoint()) {
+            setJSValue(m_out.int64Zero);
+            return;
+        }
+
+        int numArgs = m_node->numChildren() - 1;
+
+        LValue jsCallee = lowJSValue(m_graph.varArgChild(m_node, 0));
+
+        CallLinkInfo::CallType callType =
+            m_node->op() == Construct ? CallLinkInfo::Construct : CallLinkInfo::Call;
+        CodeOrigin semanticOrigin = m_node->origin.semantic;
+        CodeOrigin callSiteDescriptionOrigin = codeOriginDescriptionOfCallSite();
+        CallSiteIndex callSiteIndex = m_ftlState.jitCode->common.addCodeOrigin(callSiteDescriptionOrigin);
+        State* state = &m_ftlState;
+        Procedure* proc = &m_proc;
+        VM* vm = &this->vm();
+
+        // The callee's frame is built in the argument area at the bottom of our frame, so it
+        // starts where the callee will push the return PC and our frame pointer.
+        auto calleeSlot = [] (int slot) -> B3::ValueRep {
+            return B3::ValueRep::stackArgument((slot - JSStack::CallerFrameAndPCSize) * sizeof(Register));
+        };
+
+        B3::PatchpointValue* patchpoint = m_out.patchpoint(B3::Int64);
+        patchpoint->append(B3::ConstrainedValue(jsCallee, B3::ValueRep::reg(GPRInfo::regT0)));
+        patchpoint->append(B3::ConstrainedValue(jsCallee, calleeSlot(JSStack::Callee)));
+        patchpoint->append(B3::ConstrainedValue(m_out.constInt64(numArgs), calleeSlot(JSStack::ArgumentCount))); // argument count and zeros for the tag
+        for (int i = 0; i < numArgs; ++i) {
+            patchpoint->append(B3::ConstrainedValue(
+                lowJSValue(m_graph.varArgChild(m_node, 1 + i)), calleeSlot(JSStack::ThisArgument + i)));
+        }
+        appendTagRegisters(patchpoint);
+        patchpoint->clobber(RegisterSet::volatileRegistersForJSCall());
+        patchpoint->setGenerator(
+            [=] (CCallHelpers& jit, const B3::StackmapGenerationParams& params) {
+                JSCallBase callBase(callType, semanticOrigin, callSiteDescriptionOrigin);
+                callBase.setCallSiteIndex(callSiteIndex);
+                callBase.emit(jit, *state, 0);
+
+                jit.addPtr(
+                    CCallHelpers::TrustedImm32(-static_cast<int32_t>(proc->code().frameSize())),
+                    GPRInfo::callFrameRegister, CCallHelpers::stackPointerRegister);
+                jit.move(GPRInfo::returnValueGPR, params.reps[0].gpr());
+
+                jit.addLinkTask(
+                    [=] (LinkBuffer& linkBuffer) mutable {
+                        callBase.link(*vm, linkBuffer);
+                    });
+            });
+
+        setJSValue(patchpoint);
 #else
         int numArgs = m_node->numChildren() - 1;
 
@@ -4942,8 +5303,73 @@ private:
     void compileTailCall()
     {
 #if FTL_USES_B3
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
+        int numArgs = m_node->numChildren() - 1;
+
+        CodeOrigin semanticOrigin = m_node->origin.semantic;
+        Procedure* proc = &m_proc;
+        VM* vm = &this->vm();
+
+        B3::PatchpointValue* patchpoint = m_out.patchpoint(B3::Void);
+        patchpoint->append(B3::ConstrainedValue(
+            lowJSValue(m_graph.varArgChild(m_node, 0)), B3::ValueRep::reg(GPRInfo::regT0)));
+        for (int i = 0; i < numArgs; ++i)
+            patchpoint->append(B3::ConstrainedValue(lowJSValue(m_graph.varArgChild(m_node, 1 + i)), B3::ValueRep::Any));
+        patchpoint->setGenerator(
+            [=] (CCallHelpers& jit, const B3::StackmapGenerationParams& params) {
+                CallFrameShuffleData shuffleData;
+                shuffleData.numLocals = proc->code().frameSize() / static_cast<unsigned>(sizeof(void*));
+                shuffleData.callee = ValueRecovery::inGPR(GPRInfo::regT0, DataFormatJS);
+                for (unsigned i = 1; i < params.reps.size(); ++i) {
+                    const B3::ValueRep& rep = params.reps[i];
+                    if (rep.isReg())
+                        shuffleData.args.append(ValueRecovery::inGPR(rep.gpr(), DataFormatJS));
+                    else if (rep.isStack()) {
+                        shuffleData.args.append(ValueRecovery::displacedInJSStack(
+                            VirtualRegister(static_cast<int>(rep.offsetFromFP() / static_cast<intptr_t>(sizeof(Register)))), DataFormatJS));
+                    } else {
+                        ASSERT(rep.isConstant());
+                        shuffleData.args.append(ValueRecovery::constant(JSValue::decode(rep.value())));
+                    }
+                }
+                shuffleData.setupCalleeSaveRegisters(jit.codeBlock());
+
+                CallLinkInfo* callLinkInfo = jit.codeBlock()->addCallLinkInfo();
+
+                CCallHelpers::DataLabelPtr targetToCheck;
+                CCallHelpers::Jump slowPath = jit.branchPtrWithPatch(
+                    CCallHelpers::NotEqual, GPRInfo::regT0, targetToCheck,
+                    CCallHelpers::TrustedImmPtr(0));
+
+                callLinkInfo->setFrameShuffleData(shuffleData);
+                CallFrameShuffler(jit, shuffleData).prepareForTailCall();
+
+                CCallHelpers::Call fastCall = jit.nearTailCall();
+
+                slowPath.link(&jit);
+
+                CallFrameShuffler slowPathShuffler(jit, shuffleData);
+                slowPathShuffler.setCalleeJSValueRegs(JSValueRegs(GPRInfo::regT0));
+                slowPathShuffler.prepareForSlowPath();
+
+                jit.move(CCallHelpers::TrustedImmPtr(callLinkInfo), GPRInfo::regT2);
+
+                CCallHelpers::Call slowCall = jit.nearCall();
+
+                jit.abortWithReason(JITDidReturnFromTailCall);
+
+                callLinkInfo->setUpCall(CallLinkInfo::TailCall, semanticOrigin, GPRInfo::regT0);
+
+                jit.addLinkTask(
+                    [=] (LinkBuffer& linkBuffer) {
+                        linkBuffer.link(
+                            slowCall, FunctionPtr(vm->getCTIStub(linkCallThunkGenerator).code().executableAddress()));
+                        callLinkInfo->setCallLocations(
+                            linkBuffer.locationOfNearCall(slowCall), linkBuffer.locationOf(targetToCheck),
+                            linkBuffer.locationOfNearCall(fastCall));
+                    });
+            });
+
+        m_out.unreachable();
 #else
         int numArgs = m_node->numChildren() - 1;
         StackmapArgumentList exitArguments;
@@ -4981,8 +5407,87 @@ private:
     void compileCallOrConstructVarargs()
     {
 #if FTL_USES_B3
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
+        if (!canLowerThrowingPatchpoint()) {
+            // Nothing in a try block is in tail position, so this is never a tail call.
+            ASSERT(m_node->op() != TailCallVarargs && m_node->op() != TailCallForwardVarargs);
+            setJSValue(m_out.int64Zero);
+            return;
+        }
+
+        LValue jsCallee = lowJSValue(m_node->child1());
+        LValue thisArg = lowJSValue(m_node->child3());
+
+        LValue jsArguments = nullptr;
+
+        switch (m_node->op()) {
+        case CallVarargs:
+        case TailCallVarargs:
+        case TailCallVarargsInlinedCaller:
+        case ConstructVarargs:
+            jsArguments = lowJSValue(m_node->child2());
+            break;
+        case CallForwardVarargs:
+        case TailCallForwardVarargs:
+        case TailCallForwardVarargsInlinedCaller:
+        case ConstructForwardVarargs:
+            break;
+        default:
+            DFG_CRASH(m_graph, m_node, "bad node type");
+            break;
+        }
+
+        unsigned stackmapID = m_stackmapIDs++;
+        Node* node = m_node;
+        CodeOrigin callSiteDescriptionOrigin = codeOriginDescriptionOfCallSite();
+        CallSiteIndex callSiteIndex = m_ftlState.jitCode->common.addCodeOrigin(callSiteDescriptionOrigin);
+        State* state = &m_ftlState;
+        VM* vm = &this->vm();
+
+        // JSCallVarargs keeps its inputs and the stack pointer here while it calls out to size
+        // and fill in the frame.
+        B3::StackSlotValue* spillSlots = m_out.lockedStackSlot(
+            JSCallVarargs::numSpillSlotsNeeded() * sizeof(void*))->as<B3::StackSlotValue>();
+
+        B3::PatchpointValue* patchpoint = m_out.patchpoint(B3::Int64);
+        patchpoint->append(B3::ConstrainedValue(jsCallee, B3::ValueRep::reg(GPRInfo::argumentGPR0)));
+        if (jsArguments) {
+            patchpoint->append(B3::ConstrainedValue(jsArguments, B3::ValueRep::reg(GPRInfo::argumentGPR1)));
+            patchpoint->append(B3::ConstrainedValue(thisArg, B3::ValueRep::reg(GPRInfo::argumentGPR2)));
+        } else
+            patchpoint->append(B3::ConstrainedValue(thisArg, B3::ValueRep::reg(GPRInfo::argumentGPR1)));
+        patchpoint->append(B3::ConstrainedValue(spillSlots, B3::ValueRep::Any)); // Keeps the slots alive.
+        appendTagRegisters(patchpoint);
+        patchpoint->clobber(RegisterSet::volatileRegistersForJSCall());
+        patchpoint->setGenerator(
+            [=] (CCallHelpers& jit, const B3::StackmapGenerationParams& params) {
+                JSCallVarargs call(stackmapID, node, callSiteDescriptionOrigin);
+                call.setCallSiteIndex(callSiteIndex);
+                int32_t spillSlotsOffset =
+                    static_cast<int32_t>(spillSlots->offsetFromFP() / static_cast<intptr_t>(sizeof(Register)));
+                call.emit(jit, *state, spillSlotsOffset, 0);
+                jit.move(GPRInfo::returnValueGPR, params.reps[0].gpr());
+                CCallHelpers::Jump done = jit.jump();
+
+                CCallHelpers::Label exceptionHandler = jit.label();
+                emitJumpToExceptionHandler(jit, vm, lookupExceptionHandler);
+
+                done.link(&jit);
+
+                jit.addLinkTask(
+                    [=] (LinkBuffer& linkBuffer) mutable {
+                        call.link(*vm, linkBuffer, linkBuffer.locationOf(exceptionHandler));
+                    });
+            });
+
+        switch (m_node->op()) {
+        case TailCallVarargs:
+        case TailCallForwardVarargs:
+            m_out.unreachable();
+            break;
+
+        default:
+            setJSValue(patchpoint);
+        }
 #else
         LValue jsCallee = lowJSValue(m_node->child1());
         LValue thisArg = lowJSValue(m_node->child3());
@@ -5133,9 +5638,177 @@ private:
 
     void compileJump()
     {
+#if !FTL_USES_B3
+        if (!m_loopAliasGuards.isEmpty())
+            emitLoopAliasGuard();
+#endif
+
         m_out.jump(lowBlock(m_node->targetBlock()));
     }
 
+#if !FTL_USES_B3
+    // JSCPOLLY COMMENT
+    // Butterflies of different arrays never overlap. So if the storage pointers that a loop
+    // accesses are distinct, LLVM may assume that accesses through different pointers don't
+    // alias, which polly needs to model loops that read some arrays and write others. At the
+    // pre-header of an outermost counted loop, we check that every storage written in the loop
+    // differs from every other storage accessed in it, and exit otherwise. Then each access
+    // gets alias.scope/noalias metadata. We only consider storages computed outside of any loop,
+    // so that each has one value per invocation and the metadata holds for all accesses, not
+    // just within one iteration. Typed arrays are left out since distinct views can share a
+    // buffer.
+    void findLoopAliasGuards(const InductionVariables& inductionVariables)
+    {
+        if (!inductionVariables.size())
+            return;
+
+        HashSet<Node*> nodesInLoops;
+        for (DFG::BasicBlock* block : m_graph.blocksInNaturalOrder()) {
+            if (!m_graph.m_naturalLoops->innerMostLoopOf(block))
+                continue;
+            for (Node* node : *block)
+                nodesInLoops.add(node);
+        }
+
+        for (unsigned i = 0; i < inductionVariables.size(); ++i) {
+            const InductionVariable& variable = inductionVariables[i];
+            if (m_graph.m_naturalLoops->innerMostOuterLoop(*variable.loop))
+                continue;
+            if (m_graph.hasExitSite(variable.preHeader->terminal()->origin.semantic, ArrayAliasing))
+                continue;
+
+            LoopAliasGuard guard;
+            for (unsigned blockIndex = 0; blockIndex < variable.loop->size(); ++blockIndex) {
+                for (Node* node : *variable.loop->at(blockIndex)) {
+                    Node* storage = butterflyStorageForAliasGuard(node);
+                    if (!storage || nodesInLoops.contains(storage))
+                        continue;
+                    guard.accesses.append(node);
+                    guard.storages.appendIfNotContains(storage);
+                    if (node->op() != GetByVal)
+                        guard.writtenStorages.appendIfNotContains(storage);
+                }
+            }
+
+            if (guard.storages.size() < 2 || guard.writtenStorages.isEmpty())
+                continue;
+
+            if (verboseCompilationEnabled()) {
+                dataLog(
+                    "Checking that ", guard.storages.size(), " storages of ", variable,
+                    " don't alias at ", *variable.preHeader, "\n");
+            }
+
+            m_loopAliasGuards.add(variable.preHeader, WTF::move(guard));
+        }
+    }
+
+    Node* butterflyStorageForAliasGuard(Node* node)
+    {
+        Edge storage;
+        switch (node->op()) {
+        case GetByVal:
+            storage = node->child3();
+            break;
+        case PutByVal:
+        case PutByValDirect:
+        case PutByValAlias:
+            storage = m_graph.varArgChild(node, 3);
+            break;
+        default:
+            return nullptr;
+        }
+
+        switch (node->arrayMode().type()) {
+        case Array::Int32:
+        case Array::Double:
+        case Array::Contiguous:
+            break;
+        default:
+            return nullptr;
+        }
+        if (!isPollyFriendlyArrayMode(node->arrayMode()))
+            return nullptr;
+        return storage.node();
+    }
+
+    void emitLoopAliasGuard()
+    {
+        auto iter = m_loopAliasGuards.find(m_highBlock);
+        if (iter == m_loopAliasGuards.end())
+            return;
+        const LoopAliasGuard& guard = iter->value;
+
+        HashMap<Node*, LValue> storageValues;
+        for (Node* storage : guard.storages) {
+            LoweredNodeValue value = m_storageValues.get(storage);
+            if (!isValid(value))
+                return;
+            storageValues.add(storage, value.value());
+        }
+
+        HashMap<Node*, Vector<Node*>> distinctStorages;
+        LValue failCondition = nullptr;
+        for (Node* written : guard.writtenStorages) {
+            for (Node* other : guard.storages) {
+                if (other == written)
+                    continue;
+                Vector<Node*>& distinctFromWritten = distinctStorages.add(written, Vector<Node*>()).iterator->value;
+                if (distinctFromWritten.contains(other))
+                    continue;
+                distinctFromWritten.append(other);
+                distinctStorages.add(other, Vector<Node*>()).iterator->value.append(written);
+
+                LValue same = m_out.equal(storageValues.get(written), storageValues.get(other));
+                failCondition = failCondition ? m_out.bitOr(failCondition, same) : same;
+            }
+        }
+
+        speculate(ArrayAliasing, noValue(), nullptr, failCondition);
+
+        for (Node* access : guard.accesses) {
+            Node* storage = butterflyStorageForAliasGuard(access);
+            auto distinctIter = distinctStorages.find(storage);
+            if (distinctIter == distinctStorages.end())
+                continue;
+
+            Vector<LValue> noAlias;
+            for (Node* other : distinctIter->value)
+                noAlias.append(aliasScopeFor(other));
+
+            AliasMetadata metadata;
+            metadata.scopes = mdNode(m_ftlState.context, aliasScopeFor(storage));
+            metadata.noAlias = mdNode(m_ftlState.context, noAlias);
+            m_aliasMetadata.add(access, metadata);
+        }
+    }
+
+    LValue aliasScopeFor(Node* storage)
+    {
+        if (!m_aliasDomain)
+            m_aliasDomain = mdNode(m_ftlState.context, mdString(m_ftlState.context, "JSC butterflies"));
+        auto result = m_aliasScopes.add(storage, nullptr);
+        if (result.isNewEntry) {
+            CString name = toCString("butterfly ", storage);
+            result.iterator->value = mdNode(
+                m_ftlState.context, mdString(m_ftlState.context, name.data()), m_aliasDomain);
+        }
+        return result.iterator->value;
+    }
+
+    // Puts the alias metadata found by emitLoopAliasGuard() on a load or store done for m_node.
+    void decorateArrayAccess(LValue instruction)
+    {
+        if (m_aliasMetadata.isEmpty())
+            return;
+        auto iter = m_aliasMetadata.find(m_node);
+        if (iter == m_aliasMetadata.end())
+            return;
+        setMetadata(instruction, m_aliasScopeKind, iter->value.scopes);
+        setMetadata(instruction, m_noAliasKind, iter->value.noAlias);
+    }
+#endif // !FTL_USES_B3
+
     void compileBranch()
 
     {
@@ -5394,7 +6067,7 @@ private:
     void compileInvalidationPoint()
     {
 #if FTL_USES_B3
-        UNREACHABLE_FOR_PLATFORM();
+        failLowering("InvalidationPoint");
 #else // FTL_USES_B3
         if (verboseCompilationEnabled())
             dataLog("    Invalidation point with availability: ", availabilityMap(), "\n");
@@ -5591,8 +6264,11 @@ private:
     void compileIn()
     {
 #if FTL_USES_B3
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
+        // FIXME: Use an inline cache once B3 can generate the patchable code that CheckIn needs.
+        Edge base = m_node->child2();
+        LValue cell = lowCell(base);
+        speculateObject(base, cell);
+        setJSValue(vmCall(m_out.int64, m_out.operation(operationGenericIn), m_callFrame, cell, lowJSValue(m_node->child1())));
 #else
         Edge base = m_node->child2();
         LValue cell = lowCell(base);
@@ -6581,11 +7257,11 @@ private:
     LValue getById(LValue base)
     {
 #if FTL_USES_B3
-        UNUSED_PARAM(base);
-
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
-        return nullptr;
+        // FIXME: Use an inline cache once B3 can generate the patchable code that GetById needs.
+        auto uid = m_graph.identifiers()[m_node->identifierNumber()];
+        return vmCall(
+            m_out.int64, m_out.operation(operationGetByIdGeneric), m_callFrame, base,
+            m_out.constIntPtr(uid));
 #else
         auto uid = m_graph.identifiers()[m_node->identifierNumber()];
 
@@ -6726,12 +7402,53 @@ private:
     }
 
     // BEGIN JSCPOLLY
+#if !FTL_USES_B3
     // Generate a pointer to the base of the array
-    TypedPointer basePtr(IndexedAbstractHeap& heap, LValue storage, LValue index, Edge edge, ptrdiff_t offset = 0)
-	{
-		return m_out.baseArray(
-			heap, storage, m_out.zeroExtPtr(index), provenValue(edge), offset);
-	}
+    TypedPointer basePtr(IndexedAbstractHeap& heap, LValue storage, LType elementType)
+    {
+        return m_out.baseArray(heap, storage, elementType);
+    }
+
+    LType typedArrayElementType(TypedArrayType type)
+    {
+        if (isFloat(type))
+            return elementSize(type) == 4 ? m_out.floatType : m_out.doubleType;
+        switch (elementSize(type)) {
+        case 1:
+            return m_out.int8;
+        case 2:
+            return m_out.int16;
+        case 4:
+            return m_out.int32;
+        default:
+            DFG_CRASH(m_graph, m_node, "Bad element size");
+            return m_out.int32;
+        }
+    }
+
+    // Typed array accesses done as a GEP on a pointer to an array of the element type rather
+    // than as intToPtr(storage + (index << log)), which polly can't analyze. Integers are
+    // extended to int32 and floats to double, like the load8SignExt32() and loadFloatToDouble()
+    // paths do.
+    LValue loadTypedArrayElement(TypedArrayType type, LValue storage, LValue index)
+    {
+        TypedPointer base = m_out.baseArray(m_heaps.typedArrayProperties, storage, typedArrayElementType(type));
+        LValue result = m_out.loadArray(base, index, provenValue(m_node->child2()));
+        if (isFloat(type))
+            return elementSize(type) == 4 ? m_out.fpCast(result, m_out.doubleType) : result;
+        if (elementSize(type) == 4)
+            return result;
+        return isSigned(type) ? m_out.signExt(result, m_out.int32) : m_out.zeroExt(result, m_out.int32);
+    }
+
+    void storeTypedArrayElement(TypedArrayType type, LValue value, LValue storage, LValue index)
+    {
+        if (type == TypeFloat32)
+            value = m_out.fpCast(value, m_out.floatType);
+        TypedPointer base = m_out.baseArray(m_heaps.typedArrayProperties, storage, typedArrayElementType(type));
+        m_out.storeArray(value, base, index);
+    }
+#endif // !FTL_USES_B3
     // END JSCPOLLY
 
     TypedPointer baseIndex(IndexedAbstractHeap& heap, LValue storage, LValue index, Edge edge, ptrdiff_t offset = 0)
@@ -6857,11 +7574,12 @@ private:
         LValue condition;
         if (Options::forceGCSlowPaths()) {
 #if FTL_USES_B3
-            CRASH();
+            // B3 has no undef; any value will do since we never take the success path.
+            result = m_out.intPtrZero;
 #else
             result = getUndef(m_out.int64);
-            condition = m_out.booleanFalse;
 #endif
+            condition = m_out.booleanFalse;
         } else {
             result = m_out.loadPtr(
                 allocator, m_heaps.MarkedAllocator_freeListHead);
@@ -7971,16 +8689,65 @@ private:
     LValue lazySlowPath(const Functor& functor, const Vector<LValue>& userArguments)
     {
 #if FTL_USES_B3
-        UNUSED_PARAM(functor);
+        if (!canLowerThrowingPatchpoint())
+            return m_out.int64Zero;
 
-        B3::PatchpointValue* result = m_out.patchpoint(B3::Int64);
-        for (LValue arg : userArguments)
-            result->append(ConstrainedValue(arg, ValueRep::SomeRegister));
-        result->setGenerator(
-            [&] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
-                jit.oops();
+        B3::PatchpointValue* patchpoint = m_out.patchpoint(B3::Int64);
+        for (LValue argument : userArguments)
+            patchpoint->appendSomeRegister(argument);
+
+        RefPtr<LazySlowPathLinkerTask> linker =
+            createSharedTask<LazySlowPathLinkerFunction>(functor);
+        CallSiteIndex callSiteIndex = m_ftlState.jitCode->common.addCodeOrigin(m_node->origin.semantic);
+        JITCode* jitCode = m_ftlState.jitCode.get();
+        VM* vm = &this->vm();
+
+        patchpoint->setGenerator(
+            [=] (CCallHelpers& jit, const B3::StackmapGenerationParams& params) {
+                Vector<Location> locations;
+                for (const B3::ValueRep& rep : params.reps)
+                    locations.append(Location::forRegister(DWARFRegister::forReg(rep.reg()), 0));
+
+                RegisterSet usedRegisters = usedRegistersFor(params);
+                ScratchRegisterAllocator scratchAllocator(usedRegisters);
+                RefPtr<LazySlowPath::Generator> generator = linker->run(locations);
+
+                // Leave room for the jump to the slow path. When the slow path is done, it jumps
+                // back to the end of this room.
+                CCallHelpers::Label patchpointLabel = jit.label();
+                unsigned patchpointStart = jit.debugOffset();
+                while (jit.debugOffset() - patchpointStart < MacroAssembler::maxJumpReplacementSize())
+                    jit.nop();
+                CCallHelpers::Jump done = jit.jump();
+
+                unsigned index = jitCode->lazySlowPaths.size();
+                jitCode->lazySlowPaths.append(nullptr);
+
+                CCallHelpers::Label begin = jit.label();
+                jit.pushToSaveImmediateWithoutTouchingRegisters(CCallHelpers::TrustedImm32(index));
+                CCallHelpers::Jump generatorJump = jit.jump();
+
+                CCallHelpers::Label exceptionTarget = jit.label();
+                emitJumpToExceptionHandler(jit, vm, lookupExceptionHandler);
+
+                done.link(&jit);
+
+                jit.addLinkTask(
+                    [=] (LinkBuffer& linkBuffer) {
+                        linkBuffer.link(
+                            generatorJump,
+                            CodeLocationLabel(vm->getCTIStub(lazySlowPathGenerationThunkGenerator).code()));
+
+                        CodeLocationLabel patchpointLocation = linkBuffer.locationOf(patchpointLabel);
+                        MacroAssembler::replaceWithJump(patchpointLocation, linkBuffer.locationOf(begin));
+
+                        jitCode->lazySlowPaths[index] = std::make_unique<LazySlowPath>(
+                            patchpointLocation, linkBuffer.locationOf(exceptionTarget), usedRegisters,
+                            callSiteIndex, generator, InvalidGPRReg, scratchAllocator);
+                    });
             });
-        return result;
+
+        return patchpoint;
 #else
         unsigned stackmapID = m_stackmapIDs++;
 
@@ -9321,12 +10088,6 @@ private:
             m_out.speculate(failCondition), kind, lowValue, highValue, origin, isExceptionHandler);
 #else // FTL_USES_B3
 
-        // BEGIN JSCPOLLY
-        if (m_ftlState.withPolly && !Options::jscpollyUseStackmaps()) {
-        	return;
-        }
-        // END JSCPOLLY
-
         // Store the exit descriptor in m_ftlState.jitCode object
         appendOSRExitDescriptor(kind, isExceptionHandler ? ExceptionType::CCallException : ExceptionType::None, lowValue, highValue, origin);
         OSRExitDescriptor& exitDescriptor = m_ftlState.jitCode->osrExitDescriptors.last();
@@ -9400,8 +10161,85 @@ private:
     }
 
 #if FTL_USES_B3
+    // For the lowering paths that B3 can't do yet: typed array stores that Air has no
+    // instructions for, and OSR exits, which speculation checks, invalidation points and
+    // throwing patchpoints inside a try block all need. We finish lowering with placeholder values so
+    // that the procedure stays well formed, and the plan throws the compilation out afterwards,
+    // which leaves the function in the DFG.
+    void failLowering(const char* what)
+    {
+        if (verboseCompilationEnabled() && !m_ftlState.loweringFailed)
+            dataLog("FTL lowering with B3 failed at ", m_node, ": no support for ", what, " yet.\n");
+        m_ftlState.loweringFailed = true;
+    }
+
+    // A patchpoint that throws can only leave the machine frame, since it can't branch to the
+    // OSR exit that a catch in this frame would need.
+    bool canLowerThrowingPatchpoint()
+    {
+        CodeOrigin opCatchOrigin;
+        HandlerInfo* exceptionHandler;
+        if (!m_graph.willCatchExceptionInMachineFrame(m_origin.forExit, opCatchOrigin, exceptionHandler))
+            return true;
+        failLowering("exceptions thrown from patchpoints into a catch in the same frame");
+        return false;
+    }
+
+    // JS callees expect the tag constants in their registers, which B3 is otherwise free to use.
+    void appendTagRegisters(B3::StackmapValue* value)
+    {
+        value->append(B3::ConstrainedValue(m_tagTypeNumber, B3::ValueRep::reg(GPRInfo::tagTypeNumberRegister)));
+        value->append(B3::ConstrainedValue(m_tagMask, B3::ValueRep::reg(GPRInfo::tagMaskRegister)));
+    }
+
+    // The registers that the slow path of an inline cache or a lazy slow path has to preserve.
+    static RegisterSet usedRegistersFor(const B3::StackmapGenerationParams& params)
+    {
+        if (Options::assumeAllRegsInFTLICAreLive())
+            return RegisterSet::allRegisters();
+        RegisterSet result(params.usedRegisters, RegisterSet::calleeSaveRegisters());
+        for (const B3::ValueRep& rep : params.reps) {
+            if (rep.isReg())
+                result.set(rep.reg());
+        }
+        return result;
+    }
+
+    // The in-band exception path: once the frame is handed back to the JS JIT's view of the
+    // world, the handler found by the lookup function takes over. Patchpoints that throw emit
+    // this themselves, because they can't branch to m_handleExceptions.
+    template<typename LookupFunction>
+    static void emitJumpToExceptionHandler(CCallHelpers& jit, VM* vm, LookupFunction lookup)
+    {
+        jit.copyCalleeSavesToVMCalleeSavesBuffer();
+        jit.move(MacroAssembler::TrustedImmPtr(vm), GPRInfo::argumentGPR0);
+        jit.move(GPRInfo::callFrameRegister, GPRInfo::argumentGPR1);
+        CCallHelpers::Call call = jit.call();
+        jit.jumpToExceptionHandler();
+        jit.addLinkTask(
+            [=] (LinkBuffer& linkBuffer) {
+                linkBuffer.link(call, FunctionPtr(lookup));
+            });
+    }
+
+    template<typename LookupFunction>
+    void jumpToExceptionHandler(LookupFunction lookup)
+    {
+        VM* vm = &this->vm();
+        B3::PatchpointValue* patchpoint = m_out.patchpoint(B3::Void);
+        patchpoint->setGenerator(
+            [=] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+                emitJumpToExceptionHandler(jit, vm, lookup);
+            });
+    }
+
+    // FIXME: Build an OSRExit from the exit descriptor and the params' reps, and generate the
+    // exit from here. Until then, the check's generator can't exit, so a function that has a
+    // speculation check stays in the DFG.
     void blessSpeculation(B3::StackmapValue* value, ExitKind kind, FormattedValue lowValue, Node* highValue, NodeOrigin origin, bool isExceptionHandler = false)
     {
+        failLowering("OSR exits");
+
         appendOSRExitDescriptor(kind, isExceptionHandler ? ExceptionType::CCallException : ExceptionType::None, lowValue, highValue, origin);
         OSRExitDescriptor& exitDescriptor = m_ftlState.jitCode->osrExitDescriptors.last();
         CodeOrigin codeOrigin = exitDescriptor.m_codeOrigin;
@@ -9891,10 +10729,10 @@ private:
         UNUSED_PARAM(nodeIndex);
 #else
 #if FTL_USES_B3
-        UNUSED_PARAM(blockIndex);
-        UNUSED_PARAM(nodeIndex);
-        if (verboseCompilationEnabled() || !verboseCompilationEnabled())
-            CRASH();
+        m_out.call(
+            m_out.voidType, m_out.operation(ftlUnreachable),
+            m_out.constIntPtr(codeBlock()), m_out.constInt32(blockIndex),
+            m_out.constInt32(nodeIndex));
 #else
         m_out.call(
             m_out.voidType,
@@ -9947,6 +10785,24 @@ private:
 
     HashMap<Node*, LValue> m_phis;
 
+#if !FTL_USES_B3
+    // JSCPOLLY COMMENT
+    // See findLoopAliasGuards().
+    struct LoopAliasGuard {
+        Vector<Node*> accesses;
+        Vector<Node*> storages;
+        Vector<Node*> writtenStorages;
+    };
+    struct AliasMetadata {
+        LValue scopes;
+        LValue noAlias;
+    };
+    HashMap<DFG::BasicBlock*, LoopAliasGuard> m_loopAliasGuards;
+    HashMap<Node*, AliasMetadata> m_aliasMetadata;
+    HashMap<Node*, LValue> m_aliasScopes;
+    LValue m_aliasDomain { nullptr };
+#endif
+
     LocalOSRAvailabilityCalculator m_availabilityCalculator;
 
     Vector<AvailableRecovery, 3> m_availableRecoveries;
@@ -9965,6 +10821,8 @@ private:
 #if !FTL_USES_B3
     unsigned m_tbaaKind;
     unsigned m_tbaaStructKind;
+    unsigned m_aliasScopeKind;
+    unsigned m_noAliasKind;
 #endif
 };
 
@@ -117,6 +117,14 @@ bool OSRExitDescriptor::isExceptionHandler() const
     return m_exceptionType != ExceptionType::None;
 }
 
+bool OSRExitDescriptor::canUseSharedExitThunk() const
+{
+    return !willArriveAtExitFromIndirectExceptionCheck()
+        && !mightArriveAtOSRExitFromGenericUnwind()
+        && !mightArriveAtOSRExitFromCallOperation()
+        && !m_isInvalidationPoint;
+}
+
 void OSRExitDescriptor::validateReferences(const TrackedReferences& trackedReferences)
 {
     for (unsigned i = m_values.size(); i--;)
@@ -38,6 +38,7 @@
 #include "FTLStackMaps.h"
 #include "FTLStackmapArgumentList.h"
 #include "HandlerInfo.h"
+#include "MacroAssembler.h"
 #include "MethodOfGettingAValueProfile.h"
 #include "Operands.h"
 #include "Reg.h"
@@ -157,6 +158,9 @@ struct OSRExitDescriptor {
     bool mightArriveAtOSRExitFromCallOperation() const;
     bool needsRegisterRecoveryOnGenericUnwindOSRExitPath() const;
     bool isExceptionHandler() const;
+    // Exits that are only ever reached by jumping from their own patchpoint, so they don't need
+    // a thunk that knows how to come in from an exception check, an unwind or an invalidation.
+    bool canUseSharedExitThunk() const;
 
     ExitKind m_kind;
     ExceptionType m_exceptionType;
@@ -187,14 +191,26 @@ struct OSRExit : public DFG::OSRExitBase {
 
     OSRExitDescriptor& m_descriptor;
     MacroAssemblerCodeRef m_code;
+    // The code of an exit starts by counting the exit in m_count. This is where it continues,
+    // possibly in the code of another exit that it shares the rest with.
+    CodeLocationLabel m_codeAfterCounting;
     // Offset within the exit stubs of the stub for this exit.
     unsigned m_patchableCodeOffset;
     // Offset within Stackmap::records
     uint32_t m_stackmapRecordIndex;
+    // If set, this exit has no thunk of its own. Its patchpoint calls the shared exit thunk
+    // instead, which finds the exit from this return address, and is repatched to call the
+    // exit's code directly once that is compiled.
+    void* m_exitSiteReturnAddress { nullptr };
 
     RegisterSet registersToPreserveForCallThatMightThrow;
 
     CodeLocationJump codeLocationForRepatch(CodeBlock* ftlCodeBlock) const;
+    bool usesSharedExitThunk() const { return !!m_exitSiteReturnAddress; }
+    CodeLocationLabel exitSite() const
+    {
+        return CodeLocationLabel(static_cast<char*>(m_exitSiteReturnAddress) - MacroAssembler::maxJumpReplacementSize());
+    }
     void considerAddingAsFrequentExitSite(CodeBlock* profiledCodeBlock)
     {
         OSRExitBase::considerAddingAsFrequentExitSite(profiledCodeBlock, ExitFromFTL);
@@ -37,6 +37,7 @@
 #include "FTLOperations.h"
 #include "FTLState.h"
 #include "FTLSaveRestore.h"
+#include "FTLTargetFeatures.h"
 #include "LinkBuffer.h"
 #include "MaxFrameExtentForSlowPathCall.h"
 #include "OperandsInlines.h"
@@ -174,6 +175,21 @@ static void compileRecovery(
         value.dataFormat(), jit, GPRInfo::regT0, GPRInfo::regT1, GPRInfo::regT2);
 }
 
+// Every exit counts itself in its own m_count before it does anything else, so that exits that
+// share the rest of their code are still counted separately. This runs while the registers still
+// hold the state of the code we're exiting, so it puts back everything it touches.
+static void countExit(CCallHelpers& jit, const OSRExit& exit)
+{
+    jit.pushToSave(GPRInfo::regT0);
+    jit.pushToSave(GPRInfo::regT1);
+    jit.move(CCallHelpers::TrustedImmPtr(&exit.m_count), GPRInfo::regT0);
+    jit.load32(CCallHelpers::Address(GPRInfo::regT0), GPRInfo::regT1);
+    jit.add32(CCallHelpers::TrustedImm32(1), GPRInfo::regT1);
+    jit.store32(GPRInfo::regT1, CCallHelpers::Address(GPRInfo::regT0));
+    jit.popToRestore(GPRInfo::regT1);
+    jit.popToRestore(GPRInfo::regT0);
+}
+
 static void compileStub(
     unsigned exitID, JITCode* jitCode, OSRExit& exit, VM* vm, CodeBlock* codeBlock)
 {
@@ -222,7 +238,17 @@ static void compileStub(
     // We don't care about the value they saved. But, we do appreciate the fact that they did it, because we use
     // that slot for saveAllRegisters().
 
+    countExit(jit, exit);
+    CCallHelpers::Label afterCounting = jit.label();
+
     saveAllRegisters(jit, registerScratch);
+
+#if CPU(X86_64) && !FTL_USES_B3
+    // The LLVM code we are leaving may have used AVX. Everything we exit to uses SSE, which is
+    // slow on some CPUs until the upper halves of the YMM registers are cleared.
+    if (canUseAVX())
+        jit.zeroUpperVectorBits();
+#endif
     
     // Bring the stack back into a sane form and assert that it's sane.
     jit.popToRestore(GPRInfo::regT0);
@@ -503,11 +529,12 @@ static void compileStub(
         jit.store64(GPRInfo::regT0, AssemblyHelpers::addressFor(reg));
     }
     
-    handleExitCounts(jit, exit);
+    handleExitCountsOfCountedExit(jit, exit);
     reifyInlinedCallFrames(jit, exit);
     adjustAndJumpToTarget(jit, exit, exit.m_isExceptionHandler);
     
     LinkBuffer patchBuffer(*vm, jit, codeBlock);
+    exit.m_codeAfterCounting = patchBuffer.locationOf(afterCounting);
     exit.m_code = FINALIZE_CODE_IF(
         shouldDumpDisassembly() || Options::verboseOSR() || Options::verboseFTLOSRExit(),
         patchBuffer,
@@ -518,6 +545,87 @@ static void compileStub(
             toCString(*record).data()));
 }
 
+// Apart from counting themselves, all that the code of an exit depends on is where it exits to and
+// how it gets the values it exits with. Exits for which that is the same can share that code. We
+// find them by hashing that layout. We find many such exits when LLVM duplicates an exit's
+// patchpoint, but also when several checks of a node exit with the same state and nothing to
+// profile. When the profiler is on, each exit has to count itself for the profiler as well, so
+// we don't share then.
+static unsigned exitLayoutHash(JITCode* jitCode, const OSRExit& exit)
+{
+    unsigned hash = exit.m_codeOrigin.hash();
+    hash = WTF::pairIntHash(hash, exit.m_descriptor.m_values.size());
+    for (unsigned index = 0; index < exit.m_descriptor.m_values.size(); ++index)
+        hash = WTF::pairIntHash(hash, exit.m_descriptor.m_values[index].kind());
+    for (const StackMaps::Location& location : jitCode->stackmaps.records[exit.m_stackmapRecordIndex].locations) {
+        hash = WTF::pairIntHash(hash, location.kind);
+        hash = WTF::pairIntHash(hash, location.dwarfReg.dwarfRegNum());
+        hash = WTF::pairIntHash(hash, location.offset);
+    }
+    return hash;
+}
+
+static bool haveSameExitLayout(JITCode* jitCode, const OSRExit& a, const OSRExit& b)
+{
+    if (jitCode->stackmaps.records[a.m_stackmapRecordIndex].locations
+        != jitCode->stackmaps.records[b.m_stackmapRecordIndex].locations)
+        return false;
+
+    if (&a.m_descriptor == &b.m_descriptor)
+        return true;
+
+    const OSRExitDescriptor& descriptorA = a.m_descriptor;
+    const OSRExitDescriptor& descriptorB = b.m_descriptor;
+
+    // Exits that profile a value also depend on what they profile it into.
+    if (descriptorA.m_profileDataFormat != DataFormatNone || descriptorB.m_profileDataFormat != DataFormatNone)
+        return false;
+    if (!descriptorA.m_materializations.isEmpty() || !descriptorB.m_materializations.isEmpty())
+        return false;
+
+    return a.m_codeOrigin == b.m_codeOrigin
+        && a.m_codeOriginForExitProfile == b.m_codeOriginForExitProfile
+        && a.m_isExceptionHandler == b.m_isExceptionHandler
+        && descriptorA.m_values.numberOfArguments() == descriptorB.m_values.numberOfArguments()
+        && descriptorA.m_values.numberOfLocals() == descriptorB.m_values.numberOfLocals()
+        && descriptorA.m_values == descriptorB.m_values;
+}
+
+static bool shareStubOfExitWithSameLayout(
+    unsigned exitID, JITCode* jitCode, OSRExit& exit, VM* vm, CodeBlock* codeBlock)
+{
+    if (vm->m_perBytecodeProfiler)
+        return false;
+
+    Vector<unsigned>& exitsWithSameHash =
+        jitCode->osrExitsByLayout.add(exitLayoutHash(jitCode, exit), Vector<unsigned>()).iterator->value;
+
+    for (unsigned otherExitID : exitsWithSameHash) {
+        OSRExit& other = jitCode->osrExit[otherExitID];
+        if (!haveSameExitLayout(jitCode, exit, other))
+            continue;
+
+        CCallHelpers jit(vm, codeBlock);
+        countExit(jit, exit);
+        CCallHelpers::Jump jumpToSharedCode = jit.jump();
+
+        LinkBuffer patchBuffer(*vm, jit, codeBlock);
+        patchBuffer.link(jumpToSharedCode, other.m_codeAfterCounting);
+        exit.m_codeAfterCounting = other.m_codeAfterCounting;
+        exit.m_code = FINALIZE_CODE_IF(
+            shouldDumpDisassembly() || Options::verboseOSR() || Options::verboseFTLOSRExit(),
+            patchBuffer,
+            ("FTL OSR exit #%u (%s, %s) from %s, sharing the code of exit #%u",
+                exitID, toCString(exit.m_codeOrigin).data(),
+                exitKindToString(exit.m_kind), toCString(*codeBlock).data(), otherExitID));
+        jitCode->numberOfOSRExitsSharingCode++;
+        return true;
+    }
+
+    exitsWithSameHash.append(exitID);
+    return false;
+}
+
 extern "C" void* compileFTLOSRExit(ExecState* exec, unsigned exitID)
 {
     SamplingRegion samplingRegion("FTL OSR Exit Compilation");
@@ -559,14 +667,27 @@ extern "C" void* compileFTLOSRExit(ExecState* exec, unsigned exitID)
 
     prepareCodeOriginForOSRExit(exec, exit.m_codeOrigin);
     
-    compileStub(exitID, jitCode, exit, vm, codeBlock);
-
-    MacroAssembler::repatchJump(
-        exit.codeLocationForRepatch(codeBlock), CodeLocationLabel(exit.m_code.code()));
+    if (!shareStubOfExitWithSameLayout(exitID, jitCode, exit, vm, codeBlock))
+        compileStub(exitID, jitCode, exit, vm, codeBlock);
+
+#if CPU(X86_64)
+    if (exit.usesSharedExitThunk()) {
+        // Keep it a call, since the exit code expects the slot that the call pushes.
+        MacroAssembler::replaceWithCall(exit.exitSite(), CodeLocationLabel(exit.m_code.code()));
+    } else
+#endif
+        MacroAssembler::repatchJump(
+            exit.codeLocationForRepatch(codeBlock), CodeLocationLabel(exit.m_code.code()));
     
     return exit.m_code.code().executableAddress();
 }
 
+extern "C" void* compileFTLOSRExitFromCall(ExecState* exec, void* returnAddress)
+{
+    JITCode* jitCode = exec->codeBlock()->jitCode()->ftl();
+    return compileFTLOSRExit(exec, jitCode->osrExitIndexForCallSite(returnAddress));
+}
+
 } } // namespace JSC::FTL
 
 #endif // ENABLE(FTL_JIT)
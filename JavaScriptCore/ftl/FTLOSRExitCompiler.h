@@ -36,6 +36,9 @@ namespace JSC { namespace FTL {
 // jump to.
 extern "C" {
 void* JIT_OPERATION compileFTLOSRExit(ExecState*, unsigned exitID) WTF_INTERNAL;
+// Same, but for exits that use the shared exit thunk, which find the exit from the
+// return address of the exit site's call to that thunk.
+void* JIT_OPERATION compileFTLOSRExitFromCall(ExecState*, void* returnAddress) WTF_INTERNAL;
 }
 
 } } // namespace JSC::FTL
@@ -29,6 +29,9 @@
 #if ENABLE(FTL_JIT)
 
 #include "ClonedArguments.h"
+#include "DFGDriver.h"
+#include "DFGToFTLForPollyDeferredCompilationCallback.h"
+#include "DFGWorklist.h"
 #include "DirectArguments.h"
 #include "FTLJITCode.h"
 #include "FTLLazySlowPath.h"
@@ -377,6 +380,65 @@ extern "C" void* JIT_OPERATION compileFTLLazySlowPath(ExecState* exec, unsigned
     return lazySlowPath.stub().code().executableAddress();
 }
 
+extern "C" void JIT_OPERATION operationTriggerPollyTierUp(ExecState* exec)
+{
+    VM* vm = &exec->vm();
+    NativeCallFrameTracer tracer(vm, exec);
+    DeferGC deferGC(vm->heap);
+    CodeBlock* codeBlock = exec->codeBlock();
+
+    if (codeBlock->jitType() != JSC::JITCode::FTLJIT) {
+        dataLog("Unexpected code block in FTL->FTLForPolly tier-up: ", *codeBlock, "\n");
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+
+    JITCode* jitCode = codeBlock->jitCode()->ftl();
+
+    if (Options::verboseOSR()) {
+        dataLog(
+            *codeBlock, ": Entered triggerPollyTierUp with counter = ",
+            jitCode->pollyTierUpCounter, "\n");
+    }
+
+    // Whatever happens below, we don't want to come back here until the compile we
+    // trigger becomes ready, which forces the slow path again.
+    jitCode->deferPollyTierUpIndefinitely();
+
+    Worklist::State worklistState;
+    if (Worklist* worklist = existingGlobalFTLWorklistOrNull()) {
+        worklistState = worklist->completeAllReadyPlansForVM(
+            *vm, CompilationKey(codeBlock->baselineVersion(), FTLForPollyMode));
+    } else
+        worklistState = Worklist::NotKnown;
+
+    // Either we are still compiling, or we are done and the callback has installed the
+    // polly code (or dropped it on the floor). New calls will pick up the replacement.
+    if (worklistState != Worklist::NotKnown)
+        return;
+
+    if (jitCode->didTriggerPollyTierUp)
+        return;
+    jitCode->didTriggerPollyTierUp = true;
+
+    // An FTL OSR entry code block is never the replacement, so the polly code would replace
+    // the FTL code block that owns it. If that one is gone, there is nothing left to replace.
+    CodeBlock* replacedCodeBlock = codeBlock->baselineVersion()->replacement();
+    if (!replacedCodeBlock || replacedCodeBlock->jitType() != JSC::JITCode::FTLJIT) {
+        if (Options::verboseOSR())
+            dataLog("Not triggering polly compilation of ", *codeBlock, " because it was jettisoned.\n");
+        return;
+    }
+    // The callback relies on this to tell the FTL code block apart from newer ones.
+    replacedCodeBlock->jitCode()->ftl()->didTriggerPollyTierUp = true;
+
+    if (Options::verboseOSR())
+        dataLog("Triggering polly compilation of ", *codeBlock, "\n");
+
+    DFG::compile(
+        *vm, codeBlock->newReplacement(), codeBlock, FTLForPollyMode, UINT_MAX,
+        Operands<JSValue>(), ToFTLForPollyDeferredCompilationCallback::create(replacedCodeBlock));
+}
+
 } } // namespace JSC::FTL
 
 #endif // ENABLE(FTL_JIT)
@@ -47,6 +47,8 @@ void JIT_OPERATION operationPopulateObjectInOSR(
 
 void* JIT_OPERATION compileFTLLazySlowPath(ExecState*, unsigned) WTF_INTERNAL;
 
+void JIT_OPERATION operationTriggerPollyTierUp(ExecState*) WTF_INTERNAL;
+
 } // extern "C"
 
 } } // namespace JSC::DFG
@@ -96,17 +96,27 @@ LValue Output::load(TypedPointer pointer, LType refType)
 }
 
 // BEGIN JSCPOLLY
+/* The int32 index is sign extended here rather than left to the GEP, so that when it was
+   computed with nsw arithmetic (see the JSCPOLLY paths of compileArithAddOrSub() and
+   compileArithMul()) scalar evolution can push the extension down to the operands of
+   i * n + j and polly can delinearize the access into a two dimensional one. The GEP is
+   inbounds because every caller has already checked the index against the vector length. */
+void Output::arrayIndices(LValue index, LValue* indices)
+{
+	indices[0] = int64Zero;
+	indices[1] = signExt(index, int64);
+}
+
 /* baseArray points to the beginning of the array */
 LValue Output::loadArray(TypedPointer baseArray, LValue index, JSValue value)
 {
 	LValue result;
 
 	LValue indices[2];
-	indices[0] = constInt32(0);
-	indices[1] = index;
+	arrayIndices(index, indices);
 
 	//Generate a GEP to do the pointer arithmetic
-	result = get(buildGEP(m_builder, baseArray.value(), indices, 2));
+	result = get(buildInBoundsGEP(m_builder, baseArray.value(), indices, 2));
 
 	baseArray.heap().decorateInstruction(result, *m_heaps, this);
     return result;
@@ -122,18 +132,18 @@ void Output::store(LValue value, TypedPointer pointer, LType refType)
 }
 
 // BEGIN JSCPOLLY
-void Output::storeArray(LValue value, TypedPointer baseArray, LValue index)
+LValue Output::storeArray(LValue value, TypedPointer baseArray, LValue index)
 {
 	LValue result;
 
 	LValue indices[2];
-	indices[0] = constInt32(0);
-	indices[1] = index;
+	arrayIndices(index, indices);
 
 	//Generate a GEP to do the pointer arithmetic
-	result = set(value, buildGEP(m_builder, baseArray.value(), indices, 2));
+	result = set(value, buildInBoundsGEP(m_builder, baseArray.value(), indices, 2));
 
 	baseArray.heap().decorateInstruction(result, *m_heaps, this);
+	return result;
 }
 // END JSCPOLLY
 
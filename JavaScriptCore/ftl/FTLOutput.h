@@ -122,7 +122,11 @@ public:
     
     LValue add(LValue left, LValue right) { return buildAdd(m_builder, left, right); }
     LValue sub(LValue left, LValue right) { return buildSub(m_builder, left, right); }
+    // For operations known not to overflow in the signed sense.
+    LValue addNSW(LValue left, LValue right) { return buildNSWAdd(m_builder, left, right); }
+    LValue subNSW(LValue left, LValue right) { return buildNSWSub(m_builder, left, right); }
     LValue mul(LValue left, LValue right) { return buildMul(m_builder, left, right); }
+    LValue mulNSW(LValue left, LValue right) { return buildNSWMul(m_builder, left, right); }
     LValue div(LValue left, LValue right) { return buildDiv(m_builder, left, right); }
     LValue rem(LValue left, LValue right) { return buildRem(m_builder, left, right); }
     LValue neg(LValue value) { return buildNeg(m_builder, value); }
@@ -273,7 +277,9 @@ public:
     void storeDouble(LValue value, TypedPointer pointer) { store(value, pointer, refDouble); }
 
     // BEGIN JSCPOLLY
-    void storeArray(LValue value, TypedPointer pointer, LValue index);
+    LValue storeArray(LValue value, TypedPointer pointer, LValue index);
+    // Fills in the two GEP indices used by loadArray() and storeArray() for an int32 index.
+    void arrayIndices(LValue index, LValue* indices);
     // END JSCPOLLY
 
     LValue addPtr(LValue value, ptrdiff_t immediate = 0)
@@ -309,11 +315,18 @@ public:
     }
 
     // BEGIN JSCPOLLY
-    // Generate a pointer to the base of the array
-    TypedPointer baseArray(IndexedAbstractHeap& heap, LValue base, LValue index, JSValue indexAsConstant = JSValue(), ptrdiff_t offset = 0)
-	{
-		return heap.baseArray(*this, base, index, indexAsConstant);
-	}
+    // Generate a pointer to the base of the array, typed as a pointer to an array of elementType,
+    // so that loadArray() and storeArray() can address elements with a GEP. The array type has
+    // no length, like a C flexible array member, so that neither LLVM nor Polly's dependence
+    // analysis assumes a bound on the index.
+    TypedPointer baseArray(const AbstractHeap& heap, LValue base, LType elementType)
+    {
+        return TypedPointer(heap, intToPtr(base, pointerType(arrayType(elementType, 0))));
+    }
+    TypedPointer baseArray(IndexedAbstractHeap& heap, LValue base, LType elementType)
+    {
+        return baseArray(heap.atAnyIndex(), base, elementType);
+    }
     // END JSCPOLLY
 
     TypedPointer absolute(void* address)
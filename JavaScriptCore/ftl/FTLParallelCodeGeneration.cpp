@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLParallelCodeGeneration.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "DFGCommon.h"
+#include "FTLState.h"
+#include "Options.h"
+#include <atomic>
+#include <mutex>
+#include <wtf/ParallelHelperPool.h>
+
+namespace JSC { namespace FTL {
+
+using namespace DFG;
+
+static ParallelHelperPool& codeGenerationHelperPool()
+{
+    static std::once_flag initializeHelperPoolOnceFlag;
+    static ParallelHelperPool* helperPool;
+    std::call_once(
+        initializeHelperPoolOnceFlag,
+        [] {
+            helperPool = new ParallelHelperPool();
+            helperPool->ensureThreads(Options::numberOfFTLCompilerThreads());
+        });
+    return *helperPool;
+}
+
+GeneratedFunction generateCodeInParallel(State& state, LModule module, LLVMExecutionEngineRef engine)
+{
+    if (!Options::useFTLParallelCodeGeneration())
+        return nullptr;
+
+    unsigned maxPartitions = codeGenerationHelperPool().numberOfThreads() + 1;
+    Vector<LLVMMemoryBufferRef> partitions(maxPartitions);
+    unsigned numPartitions = llvm->splitModuleByFunction(
+        module, state.function, Options::ftlParallelCodeGenerationMinimumInstructions(),
+        partitions.data(), maxPartitions);
+    if (!numPartitions)
+        return nullptr;
+    partitions.shrink(numPartitions);
+
+    if (verboseCompilationEnabled())
+        dataLog("Generating code for ", numPartitions, " partitions in parallel.\n");
+
+    LLVMTargetMachineRef targetMachine = llvm->GetExecutionEngineTargetMachine(engine);
+    Vector<LLVMMemoryBufferRef> objects(numPartitions);
+    Vector<char*> errors(numPartitions);
+    std::atomic<unsigned> nextPartition { 0 };
+
+    // This thread helps too, so the helpers just make the wait shorter. The engine doesn't
+    // generate code of its own until we look up the main function, so the helpers have its
+    // target machine to themselves.
+    ParallelHelperClient client(&codeGenerationHelperPool());
+    client.runFunctionInParallel(
+        [&] () {
+            for (;;) {
+                unsigned index = nextPartition++;
+                if (index >= numPartitions)
+                    return;
+                errors[index] = nullptr;
+                objects[index] = llvm->emitObjectFile(targetMachine, partitions[index], &errors[index]);
+            }
+        });
+
+    // Load the main function's object last, so that its unwind info is the one we record even
+    // if another object came with some.
+    for (unsigned i = numPartitions; i--;) {
+        if (!objects[i]) {
+            dataLog("FATAL: Could not generate code for LLVM module partition: ", errors[i], "\n");
+            CRASH();
+        }
+        if (!llvm->addObjectFile(engine, objects[i])) {
+            dataLog("FATAL: Could not load LLVM module partition.\n");
+            CRASH();
+        }
+    }
+
+    return bitwise_cast<GeneratedFunction>(
+        static_cast<uintptr_t>(llvm->GetFunctionAddress(engine, llvm->GetValueName(state.function))));
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLParallelCodeGeneration_h
+#define FTLParallelCodeGeneration_h
+
+#include "DFGCommon.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "FTLAbbreviatedTypes.h"
+#include "FTLGeneratedFunction.h"
+#include "LLVMAPI.h"
+
+namespace JSC { namespace FTL {
+
+class State;
+
+// Code generation is where most of an FTL compile goes for big functions, and MCJIT does it
+// on one thread. When the optimized module has several large functions, which for now means
+// loop bodies that Polly outlined for parallel execution, this splits the module by function
+// and generates an object for each part on a pool of helper threads, with as many threads as
+// there are FTL compiler threads. The objects are then loaded into the engine, which links
+// them together, and the main function is looked up by name.
+//
+// The main function keeps its stackmaps and unwind info, and goes through the same memory
+// manager as before, so the rest of the FTL doesn't notice. Slow paths and other cold code
+// can't be outlined this way: stackmaps describe locations in the frame of the function that
+// contains them, and OSR exit expects that to be the frame of the main function.
+//
+// Returns null if the module isn't worth splitting, in which case the caller should let MCJIT
+// generate code for it as usual. Must be called after all IR passes ran.
+GeneratedFunction generateCodeInParallel(State&, LModule, LLVMExecutionEngineRef);
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#endif // FTLParallelCodeGeneration_h
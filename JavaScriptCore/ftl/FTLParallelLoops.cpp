@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLParallelLoops.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "Options.h"
+#include <atomic>
+#include <mutex>
+#include <wtf/ThreadSpecific.h>
+
+namespace JSC { namespace FTL {
+
+namespace {
+
+// One invocation of a parallel loop. Iterations are handed out in chunks from m_next, in
+// the GNU OpenMP sense: [start, end) stepping by increment.
+class ParallelLoop {
+public:
+    ParallelLoop(void (*body)(void*), void* data, long start, long end, long increment, long chunkSize)
+        : m_body(body)
+        , m_data(data)
+        , m_end(end)
+        , m_increment(increment)
+        , m_chunkStride(chunkSize * increment)
+        , m_next(start)
+    {
+    }
+
+    void runBody() { m_body(m_data); }
+
+    bool takeChunk(long* chunkStart, long* chunkEnd)
+    {
+        long start = m_next.fetch_add(m_chunkStride, std::memory_order_relaxed);
+        if (m_increment > 0) {
+            if (start >= m_end)
+                return false;
+            *chunkEnd = m_end - start > m_chunkStride ? start + m_chunkStride : m_end;
+        } else {
+            if (start <= m_end)
+                return false;
+            *chunkEnd = m_end - start < m_chunkStride ? start + m_chunkStride : m_end;
+        }
+        *chunkStart = start;
+        return true;
+    }
+
+private:
+    void (*m_body)(void*);
+    void* m_data;
+    long m_end;
+    long m_increment;
+    long m_chunkStride;
+    std::atomic<long> m_next;
+};
+
+// What a thread knows about the parallel loop it is part of. The thread that started the
+// loop also owns the helper client that runs it.
+struct ParallelLoopContext {
+    ParallelLoop* loop { nullptr };
+    std::unique_ptr<ParallelLoop> ownedLoop;
+    std::unique_ptr<ParallelHelperClient> client;
+};
+
+ThreadSpecific<ParallelLoopContext>* s_parallelLoopContext;
+
+ParallelLoopContext& parallelLoopContext()
+{
+    return **s_parallelLoopContext;
+}
+
+long tripCount(long start, long end, long increment)
+{
+    if (increment > 0)
+        return end > start ? (end - start + increment - 1) / increment : 0;
+    return start > end ? (start - end - increment - 1) / -increment : 0;
+}
+
+void parallelLoopStart(void (*body)(void*), void* data, unsigned, long start, long end, long increment)
+{
+    ParallelLoopContext& context = parallelLoopContext();
+    RELEASE_ASSERT(!context.loop);
+
+    unsigned numThreads = parallelLoopHelperPool().numberOfThreads() + 1;
+    long iterations = tripCount(start, end, increment);
+
+    // A few chunks per thread balances the load without making the threads fight over the
+    // chunk counter.
+    long chunkSize = std::max<long>(1, iterations / (numThreads * 4));
+    context.ownedLoop = std::make_unique<ParallelLoop>(body, data, start, end, increment, chunkSize);
+    context.loop = context.ownedLoop.get();
+
+    if (numThreads == 1 || iterations < static_cast<long>(Options::jscpollyMinimumParallelLoopIterations()))
+        return;
+
+    ParallelLoop* loop = context.loop;
+    context.client = std::make_unique<ParallelHelperClient>(&parallelLoopHelperPool());
+    context.client->setFunction(
+        [loop] () {
+            ParallelLoopContext& helperContext = parallelLoopContext();
+            helperContext.loop = loop;
+            loop->runBody();
+            helperContext.loop = nullptr;
+        });
+}
+
+bool parallelLoopNext(long* chunkStart, long* chunkEnd)
+{
+    return parallelLoopContext().loop->takeChunk(chunkStart, chunkEnd);
+}
+
+void parallelLoopEndNoWait()
+{
+}
+
+void parallelLoopEnd()
+{
+    ParallelLoopContext& context = parallelLoopContext();
+    if (context.client) {
+        context.client->finish();
+        context.client = nullptr;
+    }
+    context.loop = nullptr;
+    context.ownedLoop = nullptr;
+}
+
+} // anonymous namespace
+
+ParallelHelperPool& parallelLoopHelperPool()
+{
+    static std::once_flag initializeParallelLoopsOnceFlag;
+    static ParallelHelperPool* helperPool;
+    std::call_once(
+        initializeParallelLoopsOnceFlag,
+        [] {
+            s_parallelLoopContext = new ThreadSpecific<ParallelLoopContext>();
+            helperPool = new ParallelHelperPool();
+            helperPool->ensureThreads(std::max(1u, Options::jscpollyParallelLoopThreads()) - 1);
+        });
+    return *helperPool;
+}
+
+void mapParallelLoopRuntime(LModule module, LLVMExecutionEngineRef engine)
+{
+    static const struct {
+        const char* name;
+        void* address;
+    } functions[] = {
+        { "GOMP_parallel_loop_runtime_start", bitwise_cast<void*>(&parallelLoopStart) },
+        { "GOMP_loop_runtime_next", bitwise_cast<void*>(&parallelLoopNext) },
+        { "GOMP_loop_end_nowait", bitwise_cast<void*>(&parallelLoopEndNoWait) },
+        { "GOMP_parallel_end", bitwise_cast<void*>(&parallelLoopEnd) },
+    };
+
+    bool isParallel = false;
+    for (const auto& function : functions) {
+        LValue declaration = llvm->GetNamedFunction(module, function.name);
+        if (!declaration)
+            continue;
+        llvm->AddGlobalMapping(engine, declaration, function.address);
+        isParallel = true;
+    }
+
+    // Make sure the pool exists before the code that uses it runs.
+    if (isParallel)
+        parallelLoopHelperPool();
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
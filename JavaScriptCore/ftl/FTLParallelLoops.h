@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLParallelLoops_h
+#define FTLParallelLoops_h
+
+#include "DFGCommon.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "FTLAbbreviatedTypes.h"
+#include "LLVMAPI.h"
+#include <wtf/ParallelHelperPool.h>
+
+namespace JSC { namespace FTL {
+
+// JSCPOLLY COMMENT
+// Runtime for the parallel loops that Polly generates when jscpollyParallel is set. Polly
+// emits calls to the GNU OpenMP runtime: the thread running FTL code starts the loop, runs
+// the outlined loop body itself, and then waits for the other threads to finish. We don't
+// link against an OpenMP runtime. Instead, mapParallelLoopRuntime() points those calls at
+// functions that run the loop body on a pool of JSC helper threads.
+//
+// Polly only builds SCoPs out of loads, stores and arithmetic, so the loop body never
+// allocates, calls into the runtime or exits to the baseline JIT. The thread running FTL
+// code keeps the JSLock and doesn't reach a GC safepoint until all helpers are done with the
+// loop, so the helpers can't observe a collection and don't need to be known to the heap.
+
+ParallelHelperPool& parallelLoopHelperPool();
+
+// Must be called after the Polly passes ran and before the module is finalized.
+void mapParallelLoopRuntime(LModule, LLVMExecutionEngineRef);
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#endif // FTLParallelLoops_h
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLPassPipeline.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "CodeBlock.h"
+#include "DFGNaturalLoops.h"
+#include "DFGPlan.h"
+#include "FTLAbbreviations.h"
+#include "FTLState.h"
+#include "Options.h"
+
+namespace JSC { namespace FTL {
+
+using namespace DFG;
+
+static bool parsePassPipeline(const char* string, PassPipeline& result)
+{
+    if (!strcmp(string, "fast"))
+        result = PassPipeline::Fast;
+    else if (!strcmp(string, "standard"))
+        result = PassPipeline::Standard;
+    else if (!strcmp(string, "loopHeavy"))
+        result = PassPipeline::LoopHeavy;
+    else if (!strcmp(string, "polyhedral"))
+        result = PassPipeline::Polyhedral;
+    else
+        return false;
+    return true;
+}
+
+PassPipeline choosePassPipeline(State& state)
+{
+    // Without llvmSimpleOpt, the pass manager builder picks the passes, so don't bother computing
+    // natural loops for a choice nobody will use.
+    if (!Options::llvmSimpleOpt())
+        return PassPipeline::Standard;
+
+    bool runsPolly = state.withPolly && !state.withPollyNo;
+
+    // Whether Polly runs is up to the plan, so the override can't turn it on or off.
+    PassPipeline forced;
+    if (Options::llvmPassPipeline() && parsePassPipeline(Options::llvmPassPipeline(), forced)) {
+        if ((forced == PassPipeline::Polyhedral) == runsPolly)
+            return forced;
+    }
+    if (runsPolly)
+        return PassPipeline::Polyhedral;
+
+    Graph& graph = state.graph;
+    graph.ensureNaturalLoops();
+    if (!graph.m_naturalLoops->numLoops())
+        return PassPipeline::Fast;
+
+    unsigned numNodes = 0;
+    unsigned numNodesInLoops = 0;
+    for (BasicBlock* block : graph.blocksInNaturalOrder()) {
+        numNodes += block->size();
+        if (graph.m_naturalLoops->innerMostLoopOf(block))
+            numNodesInLoops += block->size();
+    }
+
+    if (numNodes > Options::llvmLoopHeavyPassPipelineMaximumNodes())
+        return PassPipeline::Standard;
+    if (graph.m_plan.mode == FTLForOSREntryMode)
+        return PassPipeline::LoopHeavy;
+    if (numNodesInLoops >= numNodes * Options::llvmLoopHeavyPassPipelineMinimumLoopFraction())
+        return PassPipeline::LoopHeavy;
+    if (static_cast<double>(graph.m_profiledBlock->timeSinceCreation().count()) <= Options::llvmLoopHeavyPassPipelineMaximumWarmUpMilliseconds())
+        return PassPipeline::LoopHeavy;
+    return PassPipeline::Standard;
+}
+
+void addPassPipeline(PassPipeline pipeline, LLVMPassManagerRef passes, LLVMTargetMachineRef targetMachine, const LLVMPassTimingClient* timingClient)
+{
+    auto add = [&] (void (*addPass)(LLVMPassManagerRef), const char* passName) {
+        addPass(passes);
+        if (timingClient)
+            llvm->addPassTimingMarker(*reinterpret_cast<llvm::legacy::PassManager*>(passes), *timingClient, passName);
+    };
+
+    llvm->AddAnalysisPasses(targetMachine, passes);
+    add(llvm->AddPromoteMemoryToRegisterPass, "mem2reg");
+
+    if (pipeline == PassPipeline::Fast) {
+        add(llvm->AddInstructionCombiningPass, "instcombine");
+        add(llvm->AddCFGSimplificationPass, "simplifycfg");
+        add(llvm->AddAggressiveDCEPass, "adce");
+        return;
+    }
+
+    add(llvm->AddGlobalOptimizerPass, "globalopt");
+    add(llvm->AddFunctionInliningPass, "inline");
+    add(llvm->AddPruneEHPass, "prune-eh");
+    add(llvm->AddGlobalDCEPass, "globaldce");
+    add(llvm->AddConstantPropagationPass, "constprop");
+    add(llvm->AddAggressiveDCEPass, "adce");
+    add(llvm->AddInstructionCombiningPass, "instcombine");
+    // JSCPOLLY COMMENT
+    // Reads the alias.scope/noalias metadata that the lowering puts on array accesses
+    // in loops whose butterflies were checked to be distinct.
+    llvm->AddScopedNoAliasAAPass(passes);
+    // BEGIN - DO NOT CHANGE THE ORDER OF THE ALIAS ANALYSIS PASSES
+    llvm->AddTypeBasedAliasAnalysisPass(passes);
+    llvm->AddBasicAliasAnalysisPass(passes);
+    // END - DO NOT CHANGE THE ORDER OF THE ALIAS ANALYSIS PASSES
+    add(llvm->AddGVNPass, "gvn");
+    add(llvm->AddCFGSimplificationPass, "simplifycfg");
+    add(llvm->AddDeadStoreEliminationPass, "dse");
+    // JSCPOLLY BEGIN
+    add(llvm->AddLICMPass, "licm");
+    // JSCPOLLY END
+
+    if (pipeline != PassPipeline::LoopHeavy)
+        return;
+
+    add(llvm->AddLoopRotatePass, "loop-rotate");
+    add(llvm->AddIndVarSimplifyPass, "indvars");
+    add(llvm->AddLoopUnrollPass, "loop-unroll");
+    add(llvm->AddLoopVectorizePass, "loop-vectorize");
+    add(llvm->AddSLPVectorizePass, "slp-vectorizer");
+    add(llvm->AddInstructionCombiningPass, "instcombine");
+    add(llvm->AddCFGSimplificationPass, "simplifycfg");
+}
+
+} } // namespace JSC::FTL
+
+namespace WTF {
+
+void printInternal(PrintStream& out, JSC::FTL::PassPipeline pipeline)
+{
+    switch (pipeline) {
+    case JSC::FTL::PassPipeline::Fast:
+        out.print("fast");
+        return;
+    case JSC::FTL::PassPipeline::Standard:
+        out.print("standard");
+        return;
+    case JSC::FTL::PassPipeline::LoopHeavy:
+        out.print("loopHeavy");
+        return;
+    case JSC::FTL::PassPipeline::Polyhedral:
+        out.print("polyhedral");
+        return;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+} // namespace WTF
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLPassPipeline_h
+#define FTLPassPipeline_h
+
+#include "DFGCommon.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "LLVMAPI.h"
+#include <wtf/PrintStream.h>
+
+namespace JSC { namespace FTL {
+
+class State;
+
+// The LLVM IR pipelines that the llvmSimpleOpt mode picks from for each compile.
+enum class PassPipeline {
+    // Just enough cleanup for the backend: mem2reg, instcombine, CFG simplification and dead
+    // code elimination. Straight-line glue code doesn't win enough from GVN and LICM to pay
+    // for them.
+    Fast,
+
+    // Scalar optimizations, including GVN, dead store elimination and LICM.
+    Standard,
+
+    // Standard, then loop rotation, induction variable simplification, unrolling and the loop
+    // and SLP vectorizers, for code that spends its time in loops.
+    LoopHeavy,
+
+    // Standard, followed by Polly. Used whenever the plan asked for Polly.
+    Polyhedral
+};
+
+// Picks the pipeline from the number of DFG nodes and natural loops, how much of the code is
+// in loops, and how this code block behaved before we got to compile it: an OSR entry compile
+// or a code block that got hot soon after it was created is one that spends its time looping.
+// The llvmPassPipeline option overrides the choice. Must be called before the graph safepoint,
+// since it may compute natural loops.
+PassPipeline choosePassPipeline(State&);
+
+// If given a timing client, puts a marker after each pass that tells the client which pass
+// just ran.
+void addPassPipeline(PassPipeline, LLVMPassManagerRef, LLVMTargetMachineRef, const LLVMPassTimingClient* = nullptr);
+
+} } // namespace JSC::FTL
+
+namespace WTF {
+
+void printInternal(PrintStream&, JSC::FTL::PassPipeline);
+
+} // namespace WTF
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#endif // FTLPassPipeline_h
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLPollyCache.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "CodeBlock.h"
+#include "FTLPollyOptions.h"
+#include "JSCInlines.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wtf/SHA1.h>
+
+namespace JSC { namespace FTL {
+
+using namespace DFG;
+
+// Bump this whenever the lowering or the Polly pipeline changes in a way that could change
+// the outcome for the same function.
+static const unsigned pollyCacheVersion = 1;
+
+static bool verbosePollyCache()
+{
+    return verboseCompilationEnabled() || Options::jscpollyVerbosePolicy();
+}
+
+template<typename T>
+static void addToHash(SHA1& sha1, const T& value)
+{
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+static void addToHash(SHA1& sha1, const char* string)
+{
+    if (string)
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(string), strlen(string) + 1);
+    else
+        addToHash(sha1, '\0');
+}
+
+static void addToHash(SHA1& sha1, CodeBlock* codeBlock)
+{
+    addToHash(sha1, codeBlock->hash().hash());
+    addToHash(sha1, static_cast<unsigned>(codeBlock->specializationKind()));
+    addToHash(sha1, codeBlock->instructionCount());
+}
+
+CString pollyCacheKey(Graph& graph)
+{
+    if (!Options::jscpollyCacheDirectory())
+        return CString();
+
+    SHA1 sha1;
+    addToHash(sha1, pollyCacheVersion);
+
+    addToHash(sha1, graph.m_codeBlock);
+    for (InlineCallFrame* inlineCallFrame : *graph.m_plan.inlineCallFrames)
+        addToHash(sha1, inlineCallFrame->baselineCodeBlock.get());
+
+    // The speculations decide what the lowering hands to Polly.
+    for (BasicBlock* block : graph.blocksInNaturalOrder()) {
+        addToHash(sha1, block->index);
+        for (Node* node : *block) {
+            addToHash(sha1, static_cast<unsigned>(node->op()));
+            addToHash(sha1, node->flags());
+            addToHash(sha1, node->prediction());
+            if (node->hasArrayMode())
+                addToHash(sha1, node->arrayMode().asWord());
+        }
+    }
+
+    addToHash(sha1, Options::useLoopPredication());
+    addToHash(sha1, Options::jscpollyAliasChecks());
+    LLVMPollyOptions options = pollyOptions(graph.m_plan.pollyOverride);
+    addToHash(sha1, options.tiling);
+    addToHash(sha1, options.tileSize);
+    addToHash(sha1, options.secondLevelTiling);
+    addToHash(sha1, options.secondLevelTileSize);
+    addToHash(sha1, options.registerTiling);
+    addToHash(sha1, options.registerTileSize);
+    addToHash(sha1, options.vectorizer);
+    addToHash(sha1, options.fusion);
+    addToHash(sha1, options.parallel);
+    addToHash(sha1, options.vectorWidth);
+
+    return sha1.computeHexDigest();
+}
+
+static CString pathFor(const CString& key)
+{
+    return toCString(Options::jscpollyCacheDirectory(), "/", key.data(), ".jscpolly");
+}
+
+static const char* outcomeName(PollyOutcome outcome)
+{
+    switch (outcome) {
+    case PollyOutcome::Unknown:
+        return "Unknown";
+    case PollyOutcome::NothingOptimized:
+        return "NothingOptimized";
+    case PollyOutcome::Optimized:
+        return "Optimized";
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+PollyOutcome cachedPollyOutcome(const CString& key)
+{
+    if (key.isNull())
+        return PollyOutcome::Unknown;
+
+    CString path = pathFor(key);
+    FILE* file = fopen(path.data(), "r");
+    if (!file)
+        return PollyOutcome::Unknown;
+
+    PollyOutcome result = PollyOutcome::Unknown;
+    unsigned version;
+    char name[32];
+    if (fscanf(file, "jscpolly %u %31s", &version, name) == 2 && version == pollyCacheVersion) {
+        for (PollyOutcome outcome : { PollyOutcome::NothingOptimized, PollyOutcome::Optimized }) {
+            if (!strcmp(name, outcomeName(outcome)))
+                result = outcome;
+        }
+    }
+    fclose(file);
+
+    if (verbosePollyCache())
+        dataLog("Polly cache: ", path, " says ", result, "\n");
+    return result;
+}
+
+void cachePollyOutcome(const CString& key, PollyOutcome outcome, double milliseconds)
+{
+    if (key.isNull() || outcome == PollyOutcome::Unknown)
+        return;
+
+    // Other processes may be reading this entry, so only ever replace it as a whole. Other
+    // compiler threads, in this process or another, may be writing it too, so the temporary
+    // file needs a name of its own.
+    CString path = pathFor(key);
+    CString temporaryPathTemplate = toCString(path, ".XXXXXX");
+    Vector<char> temporaryPath(temporaryPathTemplate.length() + 1);
+    memcpy(temporaryPath.data(), temporaryPathTemplate.data(), temporaryPath.size());
+    int fd = mkstemp(temporaryPath.data());
+    // mkstemp() makes the file private to us, but other users may share the cache directory.
+    if (fd != -1)
+        fchmod(fd, 0644);
+    FILE* file = fd == -1 ? nullptr : fdopen(fd, "w");
+    if (!file) {
+        if (fd != -1) {
+            close(fd);
+            unlink(temporaryPath.data());
+        }
+        if (verbosePollyCache())
+            dataLog("Polly cache: could not write ", temporaryPath.data(), "\n");
+        return;
+    }
+    fprintf(file, "jscpolly %u %s\n%lf\n", pollyCacheVersion, outcomeName(outcome), milliseconds);
+    bool ok = !fclose(file);
+    if (ok)
+        ok = !rename(temporaryPath.data(), path.data());
+    if (!ok)
+        unlink(temporaryPath.data());
+
+    if (verbosePollyCache())
+        dataLog("Polly cache: ", ok ? "recorded " : "failed to record ", outcome, " in ", path, "\n");
+}
+
+} } // namespace JSC::FTL
+
+namespace WTF {
+
+void printInternal(PrintStream& out, JSC::FTL::PollyOutcome outcome)
+{
+    out.print(JSC::FTL::outcomeName(outcome));
+}
+
+} // namespace WTF
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLPollyCache_h
+#define FTLPollyCache_h
+
+#include "DFGCommon.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "DFGGraph.h"
+#include <wtf/PrintStream.h>
+#include <wtf/text/CString.h>
+
+namespace JSC { namespace FTL {
+
+// JSCPOLLY COMMENT
+// A record, kept across runs in jscpollyCacheDirectory, of what Polly achieved on the
+// functions it was run on. Functions are identified by the hash of their source and of the
+// source of everything inlined into them, by the speculations the DFG made, and by the
+// options that affect what Polly sees and does. Polly is expensive, and most functions it is
+// run on end up with nothing it can optimize, so later runs skip Polly for those. Functions it
+// did optimize are compiled with Polly right away in later runs, instead of going through the
+// background tier's plain FTL compile first.
+//
+// We don't cache the generated code itself: FTL code bakes in the addresses of heap cells,
+// structures and runtime functions of the process that compiled it.
+
+enum class PollyOutcome {
+    Unknown,
+    NothingOptimized,
+    Optimized
+};
+
+// Returns a null string if there is no cache directory.
+CString pollyCacheKey(DFG::Graph&);
+
+PollyOutcome cachedPollyOutcome(const CString& key);
+void cachePollyOutcome(const CString& key, PollyOutcome, double milliseconds);
+
+} } // namespace JSC::FTL
+
+namespace WTF {
+
+void printInternal(PrintStream&, JSC::FTL::PollyOutcome);
+
+} // namespace WTF
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#endif // FTLPollyCache_h
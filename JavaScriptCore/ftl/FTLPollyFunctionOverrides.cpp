@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLPollyFunctionOverrides.h"
+
+#if ENABLE(FTL_JIT)
+
+#include "CodeBlock.h"
+#include "Options.h"
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <wtf/DataLog.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC { namespace FTL {
+
+static const char* triStateName(TriState state)
+{
+    switch (state) {
+    case FalseTriState:
+        return "off";
+    case TrueTriState:
+        return "on";
+    case MixedTriState:
+        return "unset";
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+void PollyFunctionOverride::dump(PrintStream& out) const
+{
+    out.print("polly = ", triStateName(polly), ", tiling = ", triStateName(tiling));
+    out.print(", tile size = ", tileSize, ", second level tile size = ", secondLevelTileSize);
+    out.print(", unroll = ", unroll, ", vector width = ", vectorWidth);
+    out.print(", vectorizer = ", vectorizer.data() ? vectorizer.data() : "unset");
+    out.print(", fusion = ", fusion.data() ? fusion.data() : "unset");
+}
+
+PollyFunctionOverrides& PollyFunctionOverrides::ensureGlobalOverrides()
+{
+    static LazyNeverDestroyed<PollyFunctionOverrides> overrides;
+    static std::once_flag initializeOverridesFlag;
+    std::call_once(initializeOverridesFlag, [] {
+        const char* overridesFile = Options::jscpollyFunctionOverrides();
+        overrides.construct(overridesFile);
+    });
+    return overrides;
+}
+
+PollyFunctionOverrides::PollyFunctionOverrides(const char* filename)
+{
+    parseOverridesInFile(filename);
+}
+
+static bool parseSwitch(const String& value, TriState& result)
+{
+    if (value == "on") {
+        result = TrueTriState;
+        return true;
+    }
+    if (value == "off") {
+        result = FalseTriState;
+        return true;
+    }
+    return false;
+}
+
+static bool parseSize(const String& value, unsigned& result)
+{
+    bool ok;
+    unsigned size = value.toUIntStrict(&ok);
+    if (!ok || !size)
+        return false;
+    result = size;
+    return true;
+}
+
+bool PollyFunctionOverrides::parseSetting(PollyFunctionOverride& entry, const String& key, const String& value)
+{
+    if (key == "polly")
+        return parseSwitch(value, entry.polly);
+    if (key == "tiling")
+        return parseSwitch(value, entry.tiling);
+    if (key == "tileSize")
+        return parseSize(value, entry.tileSize);
+    if (key == "secondLevelTileSize")
+        return parseSize(value, entry.secondLevelTileSize);
+    if (key == "unroll")
+        return parseSize(value, entry.unroll);
+    if (key == "vectorWidth")
+        return parseSize(value, entry.vectorWidth);
+    if (key == "vectorizer") {
+        if (value != "none" && value != "polly" && value != "stripmine")
+            return false;
+        entry.vectorizer = value.ascii();
+        return true;
+    }
+    if (key == "fusion") {
+        if (value != "min" && value != "max")
+            return false;
+        entry.fusion = value.ascii();
+        return true;
+    }
+    return false;
+}
+
+void PollyFunctionOverrides::parseOverridesInFile(const char* filename)
+{
+    if (!filename)
+        return;
+
+    FILE* f = fopen(filename, "r");
+    if (!f) {
+        dataLogF("Failed to open file %s. Did you add the file-read-data entitlement to WebProcess.sb?\n", filename);
+        return;
+    }
+
+    char* line;
+    char buffer[BUFSIZ];
+    while ((line = fgets(buffer, sizeof(buffer), f))) {
+        if (strstr(line, "//") == line)
+            continue;
+
+        Vector<String> words;
+        String(line).simplifyWhiteSpace().split(' ', words);
+
+        // Skip empty lines.
+        if (words.isEmpty())
+            continue;
+
+        PollyFunctionOverride entry;
+        for (unsigned i = 1; i < words.size(); ++i) {
+            size_t equals = words[i].find('=');
+            if (equals == notFound
+                || !parseSetting(entry, words[i].left(equals), words[i].substring(equals + 1)))
+                dataLog("Ignoring bad polly setting '", words[i], "' for ", words[0], " in ", filename, "\n");
+        }
+        m_entries.set(words[0], entry);
+    }
+
+    int result = fclose(f);
+    if (result)
+        dataLogF("Failed to close file %s: %s\n", filename, strerror(errno));
+}
+
+const PollyFunctionOverride* PollyFunctionOverrides::find(CodeBlock* codeBlock) const
+{
+    ASSERT(!isCompilationThread());
+    if (m_entries.isEmpty())
+        return nullptr;
+
+    String name = String::fromUTF8(codeBlock->inferredName());
+    String hash = String::fromUTF8(codeBlock->hashAsStringIfPossible());
+    String signatures[] = { name + '#' + hash, hash, name };
+    for (const String& signature : signatures) {
+        auto iter = m_entries.find(signature);
+        if (iter != m_entries.end())
+            return &iter->value;
+    }
+    return nullptr;
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT)
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLPollyFunctionOverrides_h
+#define FTLPollyFunctionOverrides_h
+
+#if ENABLE(FTL_JIT)
+
+#include <wtf/HashMap.h>
+#include <wtf/PrintStream.h>
+#include <wtf/TriState.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class CodeBlock;
+
+namespace FTL {
+
+// JSCPOLLY COMMENT
+// Polly settings for one function, read from the jscpollyFunctionOverrides file. Anything
+// left unset (MixedTriState, 0 or null) comes from the global jscpolly* options.
+struct PollyFunctionOverride {
+    void dump(PrintStream&) const;
+
+    TriState polly { MixedTriState };
+    TriState tiling { MixedTriState };
+    unsigned tileSize { 0 };
+    unsigned secondLevelTileSize { 0 };
+    // Polly's register tiling is what unrolls and jams the innermost tiled loops.
+    unsigned unroll { 0 };
+    unsigned vectorWidth { 0 };
+    CString vectorizer;
+    CString fusion;
+};
+
+// The file uses the format of dfgWhitelist, except that each function signature is followed
+// by the settings for that function:
+//
+//     // Comments are lines starting with //.
+//     matmul polly=on tileSize=64 unroll=4 vectorWidth=8 fusion=max
+//     stencil#A1b2C3 polly=off
+//
+// A signature is either a function's inferred name, its code block hash, or both, separated
+// by '#'. The settings are polly=on|off, tiling=on|off, tileSize=<n>,
+// secondLevelTileSize=<n>, unroll=<n>, vectorWidth=<n>, vectorizer=none|polly|stripmine
+// and fusion=min|max.
+class PollyFunctionOverrides {
+public:
+    static PollyFunctionOverrides& ensureGlobalOverrides();
+    explicit PollyFunctionOverrides(const char*);
+
+    bool isEmpty() const { return m_entries.isEmpty(); }
+
+    // Must be called on the main thread, since it may have to compute the code block's hash.
+    const PollyFunctionOverride* find(CodeBlock*) const;
+
+private:
+    void parseOverridesInFile(const char*);
+    bool parseSetting(PollyFunctionOverride&, const String& key, const String& value);
+
+    HashMap<String, PollyFunctionOverride> m_entries;
+};
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT)
+
+#endif // FTLPollyFunctionOverrides_h
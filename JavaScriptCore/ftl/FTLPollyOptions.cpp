@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLPollyOptions.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "FTLPollyFunctionOverrides.h"
+#include "Options.h"
+#include <mutex>
+#include <stdio.h>
+#include <wtf/DataLog.h>
+#include <wtf/MathExtras.h>
+#include <wtf/StdLibExtras.h>
+
+namespace JSC { namespace FTL {
+
+static bool verbosePollyOptions()
+{
+    return verboseCompilationEnabled() || Options::jscpollyVerboseReport();
+}
+
+void HostCacheSizes::dump(PrintStream& out) const
+{
+    out.print("L1d = ", level1Data, ", L2 = ", level2, ", L3 = ", level3);
+}
+
+#if OS(LINUX)
+static bool readCacheAttribute(unsigned index, const char* attribute, char* buffer, size_t bufferSize)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%u/%s", index, attribute);
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return false;
+    bool result = !!fgets(buffer, bufferSize, file);
+    fclose(file);
+    return result;
+}
+
+// Sizes look like "32K", "2048K" or "8M".
+static size_t parseCacheSize(const char* string)
+{
+    char* end;
+    unsigned long long size = strtoull(string, &end, 10);
+    switch (*end) {
+    case 'K':
+        return size * KB;
+    case 'M':
+        return size * MB;
+    case 'G':
+        return size * KB * MB;
+    default:
+        return size;
+    }
+}
+#endif // OS(LINUX)
+
+static HostCacheSizes computeHostCacheSizes()
+{
+    HostCacheSizes result;
+#if OS(LINUX)
+    char level[16];
+    char type[32];
+    char size[32];
+    for (unsigned index = 0; readCacheAttribute(index, "level", level, sizeof(level)); ++index) {
+        if (!readCacheAttribute(index, "type", type, sizeof(type))
+            || !readCacheAttribute(index, "size", size, sizeof(size)))
+            continue;
+        if (!strncmp(type, "Instruction", strlen("Instruction")))
+            continue;
+        switch (atoi(level)) {
+        case 1:
+            result.level1Data = parseCacheSize(size);
+            break;
+        case 2:
+            result.level2 = parseCacheSize(size);
+            break;
+        case 3:
+            result.level3 = parseCacheSize(size);
+            break;
+        default:
+            break;
+        }
+    }
+#endif // OS(LINUX)
+    return result;
+}
+
+const HostCacheSizes& hostCacheSizes()
+{
+    static HostCacheSizes sizes;
+    static std::once_flag once;
+    std::call_once(once, [] { sizes = computeHostCacheSizes(); });
+    return sizes;
+}
+
+// The side of a square tile such that one tile of each of three arrays of doubles fits in
+// a cache of the given size, rounded down to a multiple of the vector width.
+static unsigned tileSizeForCache(size_t cacheSize)
+{
+    static const unsigned vectorWidth = 4;
+    static const unsigned arrays = 3;
+    if (!cacheSize)
+        return 0;
+    unsigned side = static_cast<unsigned>(sqrt(static_cast<double>(cacheSize) / (arrays * sizeof(double))));
+    return std::max(vectorWidth, side - side % vectorWidth);
+}
+
+LLVMPollyOptions pollyOptions(const PollyFunctionOverride* override)
+{
+    LLVMPollyOptions options;
+    options.tiling = Options::jscpollyTiling();
+    options.tileSize = Options::jscpollyTileSize();
+    options.secondLevelTiling = Options::jscpollySecondLevelTiling();
+    options.secondLevelTileSize = Options::jscpollySecondLevelTileSize();
+    options.registerTiling = Options::jscpollyRegisterTiling();
+    options.registerTileSize = Options::jscpollyRegisterTileSize();
+    options.vectorizer = Options::jscpollyVectorizer();
+    options.fusion = Options::jscpollyFusion();
+    options.parallel = Options::jscpollyParallel();
+    options.vectorWidth = Options::jscpollyVectorWidth();
+
+    if (override) {
+        if (override->tiling != MixedTriState)
+            options.tiling = override->tiling == TrueTriState;
+        if (override->tileSize)
+            options.tileSize = override->tileSize;
+        if (override->secondLevelTileSize) {
+            options.secondLevelTiling = true;
+            options.secondLevelTileSize = override->secondLevelTileSize;
+        }
+        if (override->unroll) {
+            options.registerTiling = true;
+            options.registerTileSize = override->unroll;
+        }
+        if (override->vectorWidth)
+            options.vectorWidth = override->vectorWidth;
+        if (override->vectorizer.data())
+            options.vectorizer = override->vectorizer.data();
+        if (override->fusion.data())
+            options.fusion = override->fusion.data();
+    }
+
+    if (!Options::jscpollyTileSizesFromCaches() || !options.tiling)
+        return options;
+
+    const HostCacheSizes& caches = hostCacheSizes();
+    if (!options.tileSize)
+        options.tileSize = tileSizeForCache(caches.level2 ? caches.level2 : caches.level3);
+
+    // Only tile twice if the inner tiles are actually smaller than the outer ones.
+    unsigned innerTileSize = tileSizeForCache(caches.level1Data);
+    if (!options.secondLevelTileSize && innerTileSize && (!options.tileSize || innerTileSize < options.tileSize)) {
+        options.secondLevelTiling = true;
+        options.secondLevelTileSize = innerTileSize;
+    }
+    return options;
+}
+
+void initializePollyOptions()
+{
+    static std::once_flag once;
+    std::call_once(
+        once,
+        [] {
+            LLVMPollyOptions options = pollyOptions();
+            bool ok = llvm->configurePolly(options);
+            if (verbosePollyOptions() || !ok) {
+                dataLog(
+                    "Polly options", ok ? "" : " (some were not recognized by this Polly)",
+                    ": tiling = ", options.tiling, ", tile size = ", options.tileSize,
+                    ", second level tiling = ", options.secondLevelTiling,
+                    ", second level tile size = ", options.secondLevelTileSize,
+                    ", register tiling = ", options.registerTiling,
+                    ", register tile size = ", options.registerTileSize,
+                    ", vectorizer = ", options.vectorizer ? options.vectorizer : "default",
+                    ", fusion = ", options.fusion ? options.fusion : "default",
+                    ", parallel = ", options.parallel,
+                    ", vector width = ", options.vectorWidth,
+                    ", host caches: ", hostCacheSizes(), "\n");
+            }
+        });
+}
+
+static StaticLock pollyOptionsLock;
+
+PollyOptionsScope::PollyOptionsScope(const PollyFunctionOverride* override)
+{
+    if (PollyFunctionOverrides::ensureGlobalOverrides().isEmpty())
+        return;
+
+    m_locker = std::unique_lock<StaticLock>(pollyOptionsLock);
+    LLVMPollyOptions options = pollyOptions(override);
+    bool ok = llvm->reconfigurePolly(options);
+    if (verbosePollyOptions() || !ok) {
+        dataLog("Polly options for this compile", ok ? "" : " (some could not be set)", ": ");
+        if (override)
+            dataLog("function override ", *override, "\n");
+        else
+            dataLog("no function override\n");
+    }
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLPollyOptions_h
+#define FTLPollyOptions_h
+
+#include "DFGCommon.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "LLVMAPI.h"
+#include <mutex>
+#include <wtf/Lock.h>
+#include <wtf/PrintStream.h>
+
+namespace JSC { namespace FTL {
+
+// JSCPOLLY COMMENT
+// Sizes in bytes of the caches of the CPU we run on, or 0 when we can't tell.
+struct HostCacheSizes {
+    size_t level1Data { 0 };
+    size_t level2 { 0 };
+    size_t level3 { 0 };
+
+    void dump(PrintStream&) const;
+};
+
+const HostCacheSizes& hostCacheSizes();
+
+struct PollyFunctionOverride;
+
+// The Polly options that the jscpolly* options ask for, with the function's settings from
+// jscpollyFunctionOverrides, if any, taking precedence. With jscpollyTileSizesFromCaches,
+// tile sizes that are left at 0 are picked so that the tiles of three arrays of doubles fit
+// in the cache that level of tiling targets: L2 (or L3) for the first level and L1 for the
+// second.
+LLVMPollyOptions pollyOptions(const PollyFunctionOverride* = nullptr);
+
+// Configures Polly's passes. Polly's options are process-wide, so this only does something
+// the first time it is called.
+void initializePollyOptions();
+
+// Runs Polly with the options of one function. Since Polly's options are process-wide, when
+// there are function overrides, every compile running Polly holds a lock while it sets the
+// options it wants and runs the passes. Without overrides, this does nothing.
+class PollyOptionsScope {
+public:
+    explicit PollyOptionsScope(const PollyFunctionOverride*);
+
+private:
+    std::unique_lock<StaticLock> m_locker;
+};
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#endif // FTLPollyOptions_h
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLPollyPolicy.h"
+
+#if ENABLE(FTL_JIT)
+
+#include "CodeBlock.h"
+#include "DFGNaturalLoops.h"
+#include "FTLPollyFunctionOverrides.h"
+#include "FTLState.h"
+#include "JSCInlines.h"
+
+namespace JSC { namespace FTL {
+
+using namespace DFG;
+
+static bool verbosePollyPolicy()
+{
+    return verboseCompilationEnabled() || Options::jscpollyVerbosePolicy();
+}
+
+bool isPollyFriendlyArrayMode(const ArrayMode& arrayMode)
+{
+    switch (arrayMode.type()) {
+    case Array::Int32:
+    case Array::Contiguous:
+    case Array::Double:
+        return arrayMode.isInBounds();
+    default:
+        return isTypedView(arrayMode.typedArrayType()) && arrayMode.isInBounds();
+    }
+}
+
+static bool isArrayAccess(Node* node)
+{
+    switch (node->op()) {
+    case GetByVal:
+    case PutByVal:
+    case PutByValDirect:
+    case PutByValAlias:
+        return true;
+    default:
+        return false;
+    }
+}
+
+PollyPolicySummary summarizeForPolly(Graph& graph)
+{
+    PollyPolicySummary result;
+
+    graph.ensureNaturalLoops();
+
+    for (BasicBlock* block : graph.blocksInNaturalOrder()) {
+        unsigned depth = graph.m_naturalLoops->loopDepth(block);
+        result.maxLoopDepth = std::max(result.maxLoopDepth, depth);
+
+        // Accesses outside of loops are not interesting to Polly either way.
+        if (!depth)
+            continue;
+
+        for (Node* node : *block) {
+            if (!isArrayAccess(node))
+                continue;
+            if (isPollyFriendlyArrayMode(node->arrayMode())) {
+                result.affineAccesses++;
+                result.affineWeight += block->executionCount;
+            } else {
+                result.otherAccesses++;
+                result.otherWeight += block->executionCount;
+            }
+        }
+    }
+
+    result.profiledExecutionCount = graph.m_profiledBlock->jitExecuteCounter().count();
+
+    return result;
+}
+
+bool shouldCompileWithPolly(Graph& graph)
+{
+    // A polly=on or polly=off in jscpollyFunctionOverrides wins over everything else.
+    const PollyFunctionOverride* override = graph.m_plan.pollyOverride;
+    if (override && override->polly != MixedTriState) {
+        if (verbosePollyPolicy()) {
+            dataLog(
+                "Polly policy for ", *graph.m_codeBlock, ": ",
+                override->polly == TrueTriState ? "polly" : "no polly", " (function override)\n");
+        }
+        return override->polly == TrueTriState;
+    }
+
+    if (!Options::jscpolly())
+        return false;
+
+    // The old behavior: every FTL compile gets Polly.
+    if (!Options::jscpollyPerFunctionPolicy())
+        return true;
+
+    PollyPolicySummary summary = summarizeForPolly(graph);
+
+    const char* reason = nullptr;
+    if (summary.maxLoopDepth < Options::jscpollyMinimumLoopDepth())
+        reason = "loop nest too shallow";
+    else if (summary.affineAccesses < Options::jscpollyMinimumAffineAccesses())
+        reason = "too few affine array accesses in loops";
+    else if (summary.affineWeight < Options::jscpollyMinimumAffineAccessRatio() * (summary.affineWeight + summary.otherWeight))
+        reason = "loops dominated by non-affine array accesses";
+    else if (summary.profiledExecutionCount < Options::jscpollyMinimumExecutionCount())
+        reason = "not executed enough";
+
+    if (verbosePollyPolicy()) {
+        dataLog(
+            "Polly policy for ", *graph.m_codeBlock, ": ", summary, " -> ",
+            reason ? "no polly (" : "polly", reason ? reason : "", reason ? ")" : "", "\n");
+    }
+
+    return !reason;
+}
+
+void PollyPolicySummary::dump(PrintStream& out) const
+{
+    out.print(
+        "maxLoopDepth = ", maxLoopDepth, ", affineAccesses = ", affineAccesses,
+        " (weight ", affineWeight, "), otherAccesses = ", otherAccesses,
+        " (weight ", otherWeight, "), profiledExecutionCount = ", profiledExecutionCount);
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT)
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLPollyPolicy_h
+#define FTLPollyPolicy_h
+
+#if ENABLE(FTL_JIT)
+
+#include "DFGArrayMode.h"
+#include "DFGGraph.h"
+
+namespace JSC { namespace FTL {
+
+// JSCPOLLY COMMENT
+// Decides, per compilation, whether the FTL should run the Polly passes. Polly is only
+// worth its compile time on functions that contain loop nests doing array accesses that
+// we know how to lower to analyzable LLVM IR; everything else gets the plain pipeline.
+
+struct PollyPolicySummary {
+    unsigned maxLoopDepth { 0 };
+    unsigned affineAccesses { 0 };
+    unsigned otherAccesses { 0 };
+    double affineWeight { 0 };
+    double otherWeight { 0 };
+    double profiledExecutionCount { 0 };
+
+    void dump(PrintStream&) const;
+};
+
+// Returns true if the access is one the withPolly lowering can turn into a GEP on a typed
+// array pointer rather than an intToPtr-based address.
+bool isPollyFriendlyArrayMode(const DFG::ArrayMode&);
+
+PollyPolicySummary summarizeForPolly(DFG::Graph&);
+
+bool shouldCompileWithPolly(DFG::Graph&);
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT)
+
+#endif // FTLPollyPolicy_h
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLPollyReport.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "CodeBlock.h"
+#include "CodeBlockWithJITType.h"
+#include "JSCInlines.h"
+#include "ProfilerCompilation.h"
+#include "ProfilerDatabase.h"
+#include <wtf/ASCIICType.h>
+
+namespace JSC { namespace FTL {
+
+using namespace DFG;
+
+static const char pollyBlockNamePrefix[] = "jscpolly.block.";
+
+CString pollyBlockName(BasicBlock* block)
+{
+    return toCString(pollyBlockNamePrefix, block->index);
+}
+
+PollyReportCollector::PollyReportCollector(Graph& graph)
+    : m_graph(graph)
+    , m_milliseconds(0)
+{
+    m_client.context = this;
+    m_client.didDetectScop = didDetectScop;
+    m_client.didRejectRegion = didRejectRegion;
+    m_client.didGenerateScop = didGenerateScop;
+}
+
+PollyReportCollector::~PollyReportCollector()
+{
+}
+
+unsigned PollyReportCollector::numOptimizedScops() const
+{
+    unsigned result = 0;
+    for (const Scop& scop : m_scops) {
+        if (scop.isOptimized)
+            result++;
+    }
+    return result;
+}
+
+void PollyReportCollector::record()
+{
+    Profiler::Compilation* compilation = m_graph.compilation();
+    if (!compilation)
+        return;
+
+    Profiler::Database& database = *m_graph.m_vm.m_perBytecodeProfiler;
+    auto originStackOf = [&] (BasicBlock* block) -> Profiler::OriginStack {
+        CodeOrigin origin = originOf(block);
+        if (!origin.isSet())
+            return Profiler::OriginStack();
+        return Profiler::OriginStack(database, m_graph.m_codeBlock, origin);
+    };
+
+    Profiler::PollyReport& report = compilation->ensurePollyReport();
+    for (const Scop& scop : m_scops) {
+        report.addScop(Profiler::PollyScop(
+            originStackOf(scop.entry), scop.numLoops, scop.numGeneratedLoops, scop.isOptimized,
+            scop.isVectorized));
+    }
+    for (const Rejection& rejection : m_rejections)
+        report.addRejection(Profiler::PollyRejection(originStackOf(rejection.entry), rejection.reason));
+    report.setMilliseconds(m_milliseconds);
+}
+
+void PollyReportCollector::dump(PrintStream& out) const
+{
+    out.print("Polly report for ", CodeBlockWithJITType(m_graph.m_codeBlock, JITCode::FTLJIT), ":\n");
+    for (const Scop& scop : m_scops) {
+        out.print("    SCoP at ", pointerDump(scop.entry), " (", originOf(scop.entry), "): ", scop.numLoops, " loops");
+        if (scop.isOptimized) {
+            out.print(", generated ", scop.numGeneratedLoops, " loops");
+            if (scop.isVectorized)
+                out.print(", vectorized");
+        } else
+            out.print(", not optimized");
+        out.print("\n");
+    }
+    for (const Rejection& rejection : m_rejections)
+        out.print("    Rejected region at ", pointerDump(rejection.entry), " (", originOf(rejection.entry), "): ", rejection.reason, "\n");
+    out.print("    Time in Polly: ", m_milliseconds, " ms\n");
+}
+
+void PollyReportCollector::didDetectScop(void* context, const char* entryBlockName, unsigned numLoops)
+{
+    PollyReportCollector* collector = static_cast<PollyReportCollector*>(context);
+    Scop scop;
+    scop.entry = collector->blockForName(entryBlockName);
+    scop.numLoops = numLoops;
+    scop.numGeneratedLoops = 0;
+    scop.isOptimized = false;
+    scop.isVectorized = false;
+    collector->m_scops.append(scop);
+}
+
+void PollyReportCollector::didRejectRegion(void* context, const char* entryBlockName, const char* reason)
+{
+    PollyReportCollector* collector = static_cast<PollyReportCollector*>(context);
+    BasicBlock* entry = collector->blockForName(entryBlockName);
+
+    // Nested regions sharing an entry tend to be rejected for the same reason.
+    for (const Rejection& rejection : collector->m_rejections) {
+        if (rejection.entry == entry && !strcmp(rejection.reason.data(), reason))
+            return;
+    }
+
+    collector->m_rejections.append(Rejection { entry, reason });
+}
+
+void PollyReportCollector::didGenerateScop(void* context, const char* entryBlockName, unsigned numGeneratedLoops, bool isVectorized)
+{
+    PollyReportCollector* collector = static_cast<PollyReportCollector*>(context);
+    BasicBlock* entry = collector->blockForName(entryBlockName);
+
+    for (Scop& scop : collector->m_scops) {
+        if (scop.entry != entry || scop.isOptimized)
+            continue;
+        scop.numGeneratedLoops = numGeneratedLoops;
+        scop.isOptimized = true;
+        scop.isVectorized = isVectorized;
+        return;
+    }
+
+    // Polly generated code for a region that detection reported under another entry. Still
+    // worth recording, but we don't know how many loops it started with.
+    Scop scop;
+    scop.entry = entry;
+    scop.numLoops = 0;
+    scop.numGeneratedLoops = numGeneratedLoops;
+    scop.isOptimized = true;
+    scop.isVectorized = isVectorized;
+    collector->m_scops.append(scop);
+}
+
+BasicBlock* PollyReportCollector::blockForName(const char* name) const
+{
+    // LLVM and Polly derive the names of the blocks they create from the block they split,
+    // so a name like "jscpolly.block.12.region_entering" still belongs to block #12.
+    size_t prefixLength = strlen(pollyBlockNamePrefix);
+    if (strncmp(name, pollyBlockNamePrefix, prefixLength))
+        return nullptr;
+
+    BlockIndex index = 0;
+    const char* digits = name + prefixLength;
+    if (!isASCIIDigit(*digits))
+        return nullptr;
+    for (; isASCIIDigit(*digits); ++digits)
+        index = index * 10 + (*digits - '0');
+
+    if (index >= m_graph.numBlocks())
+        return nullptr;
+    return m_graph.block(index);
+}
+
+CodeOrigin PollyReportCollector::originOf(BasicBlock* block) const
+{
+    if (!block || block->isEmpty())
+        return CodeOrigin();
+    return block->at(0)->origin.semantic;
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
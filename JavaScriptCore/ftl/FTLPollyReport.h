@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef FTLPollyReport_h
+#define FTLPollyReport_h
+
+#include "DFGCommon.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "DFGGraph.h"
+#include "LLVMAPI.h"
+#include "ProfilerOriginStack.h"
+#include <wtf/PrintStream.h>
+#include <wtf/text/CString.h>
+
+namespace JSC { namespace FTL {
+
+// JSCPOLLY COMMENT
+// Collects what Polly detected, rejected and generated while optimizing an FTL module, and
+// maps it back to the DFG blocks it came from. The lowering names the LLVM blocks of DFG
+// blocks with pollyBlockName() when compiling with Polly so that this mapping survives the
+// block splitting and renaming done by LLVM and Polly.
+
+CString pollyBlockName(DFG::BasicBlock*);
+
+class PollyReportCollector {
+public:
+    PollyReportCollector(DFG::Graph&);
+    ~PollyReportCollector();
+
+    const LLVMPollyReportClient& client() const { return m_client; }
+
+    void setMilliseconds(double milliseconds) { m_milliseconds = milliseconds; }
+    double milliseconds() const { return m_milliseconds; }
+
+    unsigned numOptimizedScops() const;
+
+    // Adds the report to the graph's profiler compilation, if there is one.
+    void record();
+
+    void dump(PrintStream&) const;
+
+private:
+    struct Scop {
+        DFG::BasicBlock* entry;
+        unsigned numLoops;
+        unsigned numGeneratedLoops;
+        bool isOptimized;
+        bool isVectorized;
+    };
+
+    struct Rejection {
+        DFG::BasicBlock* entry;
+        CString reason;
+    };
+
+    static void didDetectScop(void* context, const char* entryBlockName, unsigned numLoops);
+    static void didRejectRegion(void* context, const char* entryBlockName, const char* reason);
+    static void didGenerateScop(void* context, const char* entryBlockName, unsigned numGeneratedLoops, bool isVectorized);
+
+    DFG::BasicBlock* blockForName(const char*) const;
+    CodeOrigin originOf(DFG::BasicBlock*) const;
+
+    DFG::Graph& m_graph;
+    LLVMPollyReportClient m_client;
+    Vector<Scop> m_scops;
+    Vector<Rejection> m_rejections;
+    double m_milliseconds;
+};
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#endif // FTLPollyReport_h
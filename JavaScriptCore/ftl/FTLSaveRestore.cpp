@@ -43,8 +43,10 @@ static size_t bytesForGPRs()
 static size_t bytesForFPRs()
 {
     // FIXME: It might be worthwhile saving the full state of the FP registers, at some point.
-    // Right now we don't need this since we only do the save/restore just prior to OSR exit, and
-    // OSR exit will be guaranteed to only need the double portion of the FP registers.
+    // Right now we don't need this since OSR exit will be guaranteed to only need the double
+    // portion of the FP registers. The only other client is the lazy slow path generation thunk,
+    // which does resume the LLVM code, but LLVM isn't allowed to use AVX in functions that have
+    // lazy slow paths, so there are no YMM upper halves to preserve. See FTLTargetFeatures.h.
     return MacroAssembler::numberOfFPRegisters() * sizeof(double);
 }
 
@@ -45,7 +45,7 @@ T readObject(StackMaps::ParseContext& context)
 
 void StackMaps::Constant::parse(StackMaps::ParseContext& context)
 {
-    integer = context.view->read<int64_t>(context.offset, true);
+    integer = context.read<int64_t>();
 }
 
 void StackMaps::Constant::dump(PrintStream& out) const
@@ -57,22 +57,22 @@ void StackMaps::StackSize::parse(StackMaps::ParseContext& context)
 {
     switch (context.version) {
     case 0:
-        functionOffset = context.view->read<uint32_t>(context.offset, true);
-        size = context.view->read<uint32_t>(context.offset, true);
+        functionOffset = context.read<uint32_t>();
+        size = context.read<uint32_t>();
         break;
         
     // JSCPOLLY BEGIN
     // PORT to version 2 of stackmaps in LLVM 4.0
     case 2:
-    	functionOffset = context.view->read<uint64_t>(context.offset, true);
-    	size = context.view->read<uint64_t>(context.offset, true);
-    	recordCount = context.view->read<uint64_t>(context.offset, true);
+    	functionOffset = context.read<uint64_t>();
+    	size = context.read<uint64_t>();
+    	recordCount = context.read<uint64_t>();
     	break;
     // JSCPOLLY END
 
     default:
-        functionOffset = context.view->read<uint64_t>(context.offset, true);
-        size = context.view->read<uint64_t>(context.offset, true);
+        functionOffset = context.read<uint64_t>();
+        size = context.read<uint64_t>();
         break;
     }
 }
@@ -84,10 +84,10 @@ void StackMaps::StackSize::dump(PrintStream& out) const
 
 void StackMaps::Location::parse(StackMaps::ParseContext& context)
 {
-    kind = static_cast<Kind>(context.view->read<uint8_t>(context.offset, true));
-    size = context.view->read<uint8_t>(context.offset, true);
-    dwarfReg = DWARFRegister(context.view->read<uint16_t>(context.offset, true));
-    this->offset = context.view->read<int32_t>(context.offset, true);
+    kind = static_cast<Kind>(context.read<uint8_t>());
+    size = context.read<uint8_t>();
+    dwarfReg = DWARFRegister(context.read<uint16_t>());
+    this->offset = context.read<int32_t>();
 }
 
 void StackMaps::Location::dump(PrintStream& out) const
@@ -108,9 +108,9 @@ void StackMaps::Location::restoreInto(
 
 void StackMaps::LiveOut::parse(StackMaps::ParseContext& context)
 {
-    dwarfReg = DWARFRegister(context.view->read<uint16_t>(context.offset, true)); // regnum
-    context.view->read<uint8_t>(context.offset, true); // reserved
-    size = context.view->read<uint8_t>(context.offset, true); // size in bytes
+    dwarfReg = DWARFRegister(context.read<uint16_t>()); // regnum
+    context.skip(1); // reserved
+    size = context.read<uint8_t>(); // size in bytes
 }
 
 void StackMaps::LiveOut::dump(PrintStream& out) const
@@ -120,30 +120,33 @@ void StackMaps::LiveOut::dump(PrintStream& out) const
 
 bool StackMaps::Record::parse(StackMaps::ParseContext& context)
 {
-    int64_t id = context.view->read<int64_t>(context.offset, true);
+    int64_t id = context.read<int64_t>();
     ASSERT(static_cast<int32_t>(id) == id);
     patchpointID = static_cast<uint32_t>(id);
     if (static_cast<int32_t>(patchpointID) < 0)
         return false;
     
-    instructionOffset = context.view->read<uint32_t>(context.offset, true);
-    flags = context.view->read<uint16_t>(context.offset, true);
+    instructionOffset = context.read<uint32_t>();
+    flags = context.read<uint16_t>();
     
-    unsigned length = context.view->read<uint16_t>(context.offset, true);
+    unsigned length = context.read<uint16_t>();
+    locations.reserveInitialCapacity(length);
     while (length--)
-        locations.append(readObject<Location>(context));
+        locations.uncheckedAppend(readObject<Location>(context));
     
     if (context.version >= 1)
-        context.view->read<uint16_t>(context.offset, true); // padding
+        context.skip(sizeof(uint16_t)); // padding
 
-    unsigned numLiveOuts = context.view->read<uint16_t>(context.offset, true);
+    unsigned numLiveOuts = context.read<uint16_t>();
+    liveOuts.reserveInitialCapacity(numLiveOuts);
     while (numLiveOuts--)
-        liveOuts.append(readObject<LiveOut>(context));
+        liveOuts.uncheckedAppend(readObject<LiveOut>(context));
 
     if (context.version >= 1) {
-        if (context.offset & 7) {
-            ASSERT(!(context.offset & 3));
-            context.view->read<uint32_t>(context.offset, true); // padding
+        size_t offset = context.cursor - context.start;
+        if (offset & 7) {
+            ASSERT(!(offset & 3));
+            context.skip(sizeof(uint32_t)); // padding
         }
     }
     
@@ -196,42 +199,45 @@ RegisterSet StackMaps::Record::usedRegisterSet() const
     return result;
 }
 
-bool StackMaps::parse(DataView* view)
+bool StackMaps::parse(const void* data, size_t size)
 {
     ParseContext context;
-    context.offset = 0;
-    context.view = view;
+    context.start = static_cast<const uint8_t*>(data);
+    context.cursor = context.start;
+    context.end = context.start + size;
     
-    version = context.version = context.view->read<uint8_t>(context.offset, true);
+    version = context.version = context.read<uint8_t>();
 
-    context.view->read<uint8_t>(context.offset, true); // Reserved
-    context.view->read<uint8_t>(context.offset, true); // Reserved
-    context.view->read<uint8_t>(context.offset, true); // Reserved
+    context.skip(3); // Reserved
 
     uint32_t numFunctions;
     uint32_t numConstants;
     uint32_t numRecords;
     
-    numFunctions = context.view->read<uint32_t>(context.offset, true);
+    numFunctions = context.read<uint32_t>();
     if (context.version >= 1) {
-        numConstants = context.view->read<uint32_t>(context.offset, true);
-        numRecords = context.view->read<uint32_t>(context.offset, true);
+        numConstants = context.read<uint32_t>();
+        numRecords = context.read<uint32_t>();
     }
+    stackSizes.reserveInitialCapacity(numFunctions);
     while (numFunctions--)
-        stackSizes.append(readObject<StackSize>(context));
+        stackSizes.uncheckedAppend(readObject<StackSize>(context));
     
     if (!context.version)
-        numConstants = context.view->read<uint32_t>(context.offset, true);
+        numConstants = context.read<uint32_t>();
+    constants.reserveInitialCapacity(numConstants);
     while (numConstants--)
-        constants.append(readObject<Constant>(context));
+        constants.uncheckedAppend(readObject<Constant>(context));
     
     if (!context.version)
-        numRecords = context.view->read<uint32_t>(context.offset, true);
+        numRecords = context.read<uint32_t>();
+    records.reserveInitialCapacity(numRecords);
     while (numRecords--) {
-        Record record;
-        if (!record.parse(context))
+        records.uncheckedAppend(Record());
+        if (!records.last().parse(context)) {
+            records.removeLast();
             return false;
-        records.append(record);
+        }
     }
     
     return true;
@@ -256,11 +262,37 @@ void StackMaps::dumpMultiline(PrintStream& out, const char* prefix) const
         out.print(prefix, "    ", records[i], "\n");
 }
 
-StackMaps::RecordMap StackMaps::computeRecordMap() const
+StackMaps::RecordMap::RecordMap(StackMaps& stackmaps)
+    : m_stackmaps(&stackmaps)
+{
+    // Bucket the record indices by ID with a counting sort, so that each ID's records are
+    // contiguous and in the order LLVM emitted them.
+    Vector<Record>& records = stackmaps.records;
+    
+    uint32_t numIDs = 0;
+    for (const Record& record : records)
+        numIDs = std::max(numIDs, record.patchpointID + 1);
+    
+    m_start.fill(0, numIDs + 1);
+    for (const Record& record : records)
+        m_start[record.patchpointID + 1]++;
+    for (uint32_t id = 0; id < numIDs; ++id)
+        m_start[id + 1] += m_start[id];
+    
+    Vector<uint32_t> cursor(m_start);
+    m_recordIndices.grow(records.size());
+    for (uint32_t i = 0; i < records.size(); ++i)
+        m_recordIndices[cursor[records[i].patchpointID]++] = i;
+}
+
+StackMaps::RecordMap::Records StackMaps::RecordMap::find(uint32_t stackmapID) const
 {
-    RecordMap result;
-    for (unsigned i = records.size(); i--;)
-        result.add(records[i].patchpointID, Vector<RecordAndIndex>()).iterator->value.append(RecordAndIndex{ records[i], i });
+    Records result;
+    if (stackmapID >= m_start.size() - 1)
+        return result;
+    result.m_stackmaps = m_stackmaps;
+    result.m_indices = m_recordIndices.data() + m_start[stackmapID];
+    result.m_size = m_start[stackmapID + 1] - m_start[stackmapID];
     return result;
 }
 
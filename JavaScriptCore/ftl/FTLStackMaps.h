@@ -28,11 +28,11 @@
 
 #if ENABLE(FTL_JIT)
 
-#include "DataView.h"
 #include "FTLDWARFRegister.h"
 #include "GPRInfo.h"
 #include "RegisterSet.h"
-#include <wtf/HashMap.h>
+#include <wtf/FlipBytes.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
@@ -41,10 +41,29 @@ class MacroAssembler;
 namespace FTL {
 
 struct StackMaps {
+    // Reads the section in place. The section is little-endian and records are 8-byte aligned,
+    // but nothing else is, so every read goes through memcpy.
     struct ParseContext {
         unsigned version;
-        DataView* view;
-        unsigned offset;
+        const uint8_t* start;
+        const uint8_t* cursor;
+        const uint8_t* end;
+
+        template<typename T>
+        T read()
+        {
+            RELEASE_ASSERT(static_cast<size_t>(end - cursor) >= sizeof(T));
+            T result;
+            memcpy(&result, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return flipBytesIfLittleEndian(result, true);
+        }
+
+        void skip(size_t bytes)
+        {
+            RELEASE_ASSERT(static_cast<size_t>(end - cursor) >= bytes);
+            cursor += bytes;
+        }
     };
     
     struct Constant {
@@ -86,6 +105,14 @@ struct StackMaps {
         void parse(ParseContext&);
         void dump(PrintStream& out) const;
         
+        bool operator==(const Location& other) const
+        {
+            return dwarfReg.dwarfRegNum() == other.dwarfReg.dwarfRegNum()
+                && size == other.size
+                && kind == other.kind
+                && offset == other.offset;
+        }
+        
         GPRReg directGPR() const;
         void restoreInto(MacroAssembler&, StackMaps&, char* savedRegisters, GPRReg result) const;
     };
@@ -124,17 +151,52 @@ struct StackMaps {
     Vector<Constant> constants;
     Vector<Record> records;
     
-    bool parse(DataView*); // Returns true on parse success, false on failure. Failure means that LLVM is signaling compile failure to us.
+    bool parse(const void* data, size_t size); // Returns true on parse success, false on failure. Failure means that LLVM is signaling compile failure to us.
     void dump(PrintStream&) const;
     void dumpMultiline(PrintStream&, const char* prefix) const;
     
     struct RecordAndIndex {
-        Record record;
+        Record& record;
         uint32_t index;
     };
-    typedef HashMap<uint32_t, Vector<RecordAndIndex>, WTF::IntHash<uint32_t>, WTF::UnsignedWithZeroKeyHashTraits<uint32_t>> RecordMap;
-    
-    RecordMap computeRecordMap() const;
+
+    // Maps each stackmap ID to the records that LLVM emitted for it. There are none if the
+    // patchpoint was optimized out, and more than one if it was duplicated. We hand out IDs
+    // densely from zero, so this is a table indexed by ID into the record indices grouped by ID,
+    // and lookups don't hash or copy records.
+    class RecordMap {
+    public:
+        class Records {
+        public:
+            Records() { }
+
+            unsigned size() const { return m_size; }
+            bool isEmpty() const { return !m_size; }
+
+            RecordAndIndex operator[](unsigned i) const
+            {
+                ASSERT(i < m_size);
+                uint32_t index = m_indices[i];
+                return RecordAndIndex { m_stackmaps->records[index], index };
+            }
+
+        private:
+            friend class RecordMap;
+
+            StackMaps* m_stackmaps { nullptr };
+            const uint32_t* m_indices { nullptr };
+            unsigned m_size { 0 };
+        };
+
+        RecordMap(StackMaps&);
+
+        Records find(uint32_t stackmapID) const;
+
+    private:
+        StackMaps* m_stackmaps;
+        Vector<uint32_t> m_start; // Indexed by stackmap ID, with one extra entry at the end.
+        Vector<uint32_t> m_recordIndices;
+    };
 
     unsigned stackSize() const;
 
@@ -52,7 +52,8 @@ State::State(bool withPolly, bool withPollyNo, Graph& graph)
     , unwindDataSectionSize(0)
 {
     switch (graph.m_plan.mode) {
-    case FTLMode: {
+    case FTLMode:
+    case FTLForPollyMode: {
         jitCode = adoptRef(new JITCode());
         break;
     }
@@ -65,6 +65,9 @@ public:
     // JSCPOLLY BEGIN
     bool withPolly;
     bool withPollyNo;
+#if !FTL_USES_B3
+    CString pollyCacheKey;
+#endif
     // JSCPOLLY END
 
     // None of these things is owned by State. It is the responsibility of
@@ -77,6 +80,9 @@ public:
     LModule module;
     LValue function;
     bool allocationFailed { false }; // Throw out the compilation once LLVM returns.
+#if FTL_USES_B3
+    bool loweringFailed { false }; // The graph needs something B3 lowering can't do yet.
+#endif
     RefPtr<JITCode> jitCode;
     GeneratedFunction generatedFunction;
     JITFinalizer* finalizer;
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "FTLTargetFeatures.h"
+
+#if ENABLE(FTL_JIT) && !FTL_USES_B3
+
+#include "MacroAssembler.h"
+#include "Options.h"
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC { namespace FTL {
+
+bool canUseAVX()
+{
+#if CPU(X86_64)
+    return !Options::llvmDisallowAVX() && MacroAssembler::supportsAVX();
+#else
+    return false;
+#endif
+}
+
+CString targetFeatures(bool allowAVX)
+{
+#if CPU(X86_64)
+    StringBuilder features;
+    auto add = [&] (const char* feature) {
+        if (!features.isEmpty())
+            features.append(',');
+        features.append(feature);
+    };
+
+    bool useHostFeatures = Options::llvmUseHostCPUFeatures();
+
+    // Each of these implies the older SSE extensions, and AVX2 implies AVX.
+    if (useHostFeatures && MacroAssembler::supportsSSE4_2())
+        add("+sse4.2");
+    if (allowAVX && canUseAVX()) {
+        if (useHostFeatures) {
+            add("+avx");
+            if (MacroAssembler::supportsAVX2())
+                add("+avx2");
+            if (MacroAssembler::supportsFMA())
+                add("+fma");
+        }
+    } else {
+        // This also disables everything that builds on AVX, like AVX2 and FMA.
+        add("-avx");
+    }
+
+    if (features.isEmpty())
+        return CString();
+    return features.toString().utf8();
+#else
+    UNUSED_PARAM(allowAVX);
+    return CString();
+#endif
+}
+
+} } // namespace JSC::FTL
+
+#endif // ENABLE(FTL_JIT) && !FTL_USES_B3
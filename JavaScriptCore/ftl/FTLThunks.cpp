@@ -118,6 +118,16 @@ MacroAssemblerCodeRef osrExitGenerationThunkGenerator(VM* vm)
         vm, compileFTLOSRExit, "FTL OSR exit generation thunk", extraPopsToRestore);
 }
 
+// This is the shared exit thunk: exits that don't need a thunk of their own call it, so what it
+// sees in the "return address" slot is a return address that identifies the exit, rather than
+// its index.
+MacroAssemblerCodeRef osrExitFromCallGenerationThunkGenerator(VM* vm)
+{
+    unsigned extraPopsToRestore = 0;
+    return genericGenerationThunkGenerator(
+        vm, compileFTLOSRExitFromCall, "FTL shared OSR exit generation thunk", extraPopsToRestore);
+}
+
 MacroAssemblerCodeRef lazySlowPathGenerationThunkGenerator(VM* vm)
 {
     unsigned extraPopsToRestore = 1;
@@ -525,9 +525,12 @@ static EncodedJSValue JSC_HOST_CALL functionNeverInlineFunction(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionNoDFG(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionOptimizeNextInvocation(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionNumberOfDFGCompiles(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionNumberOfFTLOSRExitsSharingCode(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionReoptimizationRetryCount(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionTransferArrayBuffer(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionFailNextNewCodeBlock(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionCompileTimes(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionProfilerDatabaseJSON(ExecState*);
 static NO_RETURN_WITH_VALUE EncodedJSValue JSC_HOST_CALL functionQuit(ExecState*);
 static NO_RETURN_DUE_TO_CRASH EncodedJSValue JSC_HOST_CALL functionAbort(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionFalse1(ExecState*);
@@ -689,10 +692,13 @@ protected:
         addFunction(vm, "noInline", functionNeverInlineFunction, 1);
         addFunction(vm, "noDFG", functionNoDFG, 1);
         addFunction(vm, "numberOfDFGCompiles", functionNumberOfDFGCompiles, 1);
+        addFunction(vm, "numberOfFTLOSRExitsSharingCode", functionNumberOfFTLOSRExitsSharingCode, 1);
         addFunction(vm, "optimizeNextInvocation", functionOptimizeNextInvocation, 1);
         addFunction(vm, "reoptimizationRetryCount", functionReoptimizationRetryCount, 1);
         addFunction(vm, "transferArrayBuffer", functionTransferArrayBuffer, 1);
         addFunction(vm, "failNextNewCodeBlock", functionFailNextNewCodeBlock, 1);
+        addFunction(vm, "compileTimes", functionCompileTimes, 0);
+        addFunction(vm, "profilerDatabaseJSON", functionProfilerDatabaseJSON, 0);
 #if ENABLE(SAMPLING_FLAGS)
         addFunction(vm, "setSamplingFlags", functionSetSamplingFlags, 1);
         addFunction(vm, "clearSamplingFlags", functionClearSamplingFlags, 1);
@@ -1365,6 +1371,11 @@ EncodedJSValue JSC_HOST_CALL functionNumberOfDFGCompiles(ExecState* exec)
     return JSValue::encode(numberOfDFGCompiles(exec));
 }
 
+EncodedJSValue JSC_HOST_CALL functionNumberOfFTLOSRExitsSharingCode(ExecState* exec)
+{
+    return JSValue::encode(numberOfFTLOSRExitsSharingCode(exec));
+}
+
 EncodedJSValue JSC_HOST_CALL functionReoptimizationRetryCount(ExecState* exec)
 {
     if (exec->argumentCount() < 1)
@@ -1377,6 +1388,27 @@ EncodedJSValue JSC_HOST_CALL functionReoptimizationRetryCount(ExecState* exec)
     return JSValue::encode(jsNumber(block->reoptimizationRetryCounter()));
 }
 
+// Returns the compile times recorded under --recordCompileTimes=true as a JSON string.
+EncodedJSValue JSC_HOST_CALL functionCompileTimes(ExecState* exec)
+{
+#if ENABLE(DFG_JIT)
+    return JSValue::encode(jsString(exec, DFG::compileTimesJSON()));
+#else
+    UNUSED_PARAM(exec);
+    return JSValue::encode(jsUndefined());
+#endif
+}
+
+// Returns what the profiler recorded under --useProfiler=true or -p, in the same JSON format that
+// it saves at exit.
+EncodedJSValue JSC_HOST_CALL functionProfilerDatabaseJSON(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    if (!vm.m_perBytecodeProfiler)
+        return JSValue::encode(jsUndefined());
+    return JSValue::encode(jsString(exec, vm.m_perBytecodeProfiler->toJSON()));
+}
+
 EncodedJSValue JSC_HOST_CALL functionTransferArrayBuffer(ExecState* exec)
 {
     if (exec->argumentCount() < 1)
@@ -33,6 +33,40 @@
 
 namespace JSC {
 
+// JSCPOLLY BEGIN
+// Receives what the Polly passes found and generated while optimizing a module. Regions are
+// identified by the name of their entry block, so clients that want to map them back to
+// their own IR should name their blocks accordingly.
+struct LLVMPollyReportClient {
+    void* context;
+    void (*didDetectScop)(void* context, const char* entryBlockName, unsigned numLoops);
+    void (*didRejectRegion)(void* context, const char* entryBlockName, const char* reason);
+    void (*didGenerateScop)(void* context, const char* entryBlockName, unsigned numGeneratedLoops, bool isVectorized);
+};
+
+// How Polly's schedule optimizer should transform the SCoPs it finds. Zero tile sizes and
+// null strings leave Polly's own defaults in place.
+struct LLVMPollyOptions {
+    bool tiling;
+    unsigned tileSize;
+    bool secondLevelTiling;
+    unsigned secondLevelTileSize;
+    bool registerTiling;
+    unsigned registerTileSize;
+    const char* vectorizer;
+    const char* fusion;
+    bool parallel;
+    unsigned vectorWidth;
+};
+// JSCPOLLY END
+
+// Told, by marker passes put after each pass of a pipeline, which pass has just finished.
+// See LLVMPassTiming.h.
+struct LLVMPassTimingClient {
+    void* context;
+    void (*didRunPass)(void* context, const char* passName);
+};
+
 struct LLVMAPI {
 #define LLVM_API_FUNCTION_DECLARATION(returnType, name, signature) \
     returnType (*name) signature;
@@ -50,11 +84,21 @@ struct LLVMAPI {
     LLVMPassRegistryRef (*GetGlobalPassRegistry) (void);
 
     void (*initializePollyPasses) (llvm::PassRegistry &Registry);
-    void (*initializePollyPassesJSCPolly) (bool tiling);
+    bool (*configurePolly) (const LLVMPollyOptions&);
+    bool (*reconfigurePolly) (const LLVMPollyOptions&);
     void (*registerPollyPasses) (llvm::legacy::PassManagerBase &PM);
     void (*registerCanonicalicationPasses) (llvm::legacy::PassManagerBase &PM);
+    void (*addPollyDetectionReportPass) (llvm::legacy::PassManagerBase&, const LLVMPollyReportClient&);
+    void (*addPollyCodeGenerationReportPass) (llvm::legacy::PassManagerBase&, const LLVMPollyReportClient&);
     // JSCPOLLY END
 
+    // Parallel code generation. See LLVMParallelCodeGen.h.
+    unsigned (*splitModuleByFunction) (LLVMModuleRef, LLVMValueRef mainFunction, unsigned minimumInstructionCount, LLVMMemoryBufferRef* partitions, unsigned maxPartitions);
+    LLVMMemoryBufferRef (*emitObjectFile) (LLVMTargetMachineRef, LLVMMemoryBufferRef bitcode, char** error);
+    bool (*addObjectFile) (LLVMExecutionEngineRef, LLVMMemoryBufferRef object);
+
+    void (*addPassTimingMarker) (llvm::legacy::PassManagerBase&, const LLVMPassTimingClient&, const char* passName);
+
 };
 
 extern LLVMAPI* llvm;
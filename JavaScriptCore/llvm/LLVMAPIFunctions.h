@@ -30,6 +30,7 @@
 
 #define FOR_EACH_LLVM_API_FUNCTION(macro) \
     macro(void, DisposeMessage, (char *Message)) \
+    macro(void, DisposeMemoryBuffer, (LLVMMemoryBufferRef MemBuf)) \
     macro(void, InstallFatalErrorHandler, (LLVMFatalErrorHandler Handler)) \
     macro(LLVMContextRef, ContextCreate, (void)) \
     macro(void, ContextDispose, (LLVMContextRef C)) \
@@ -44,6 +45,7 @@
     macro(void, DumpType, (LLVMTypeRef Val)) \
     macro(LLVMValueRef, AddFunction, (LLVMModuleRef M, const char *Name, LLVMTypeRef FunctionTy)) \
     macro(LLVMValueRef, GetFirstFunction, (LLVMModuleRef M)) \
+    macro(LLVMValueRef, GetNamedFunction, (LLVMModuleRef M, const char *Name)) \
     macro(LLVMValueRef, GetNextFunction, (LLVMValueRef Fn)) \
     macro(LLVMTypeRef, Int1TypeInContext, (LLVMContextRef C)) \
     macro(LLVMTypeRef, Int8TypeInContext, (LLVMContextRef C)) \
@@ -64,6 +66,7 @@
     macro(LLVMValueRef, ConstInt, (LLVMTypeRef IntTy, unsigned long long N, LLVMBool SignExtend)) \
     macro(LLVMValueRef, ConstReal, (LLVMTypeRef RealTy, double N)) \
     macro(void, SetLinkage, (LLVMValueRef Global, LLVMLinkage Linkage)) \
+    macro(const char *, GetValueName, (LLVMValueRef Val)) \
     macro(void, SetFunctionCallConv, (LLVMValueRef Fn, unsigned CC)) \
     macro(void, AddTargetDependentFunctionAttr, (LLVMValueRef Fn, const char *A, const char *V)) \
     macro(LLVMValueRef, GetParam, (LLVMValueRef Fn, unsigned Index)) \
@@ -86,10 +89,13 @@
     macro(LLVMValueRef, BuildUnreachable, (LLVMBuilderRef)) \
     macro(void, AddCase, (LLVMValueRef Switch, LLVMValueRef OnVal, LLVMBasicBlockRef Dest)) \
     macro(LLVMValueRef, BuildAdd, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
+    macro(LLVMValueRef, BuildNSWAdd, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildFAdd, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildSub, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
+    macro(LLVMValueRef, BuildNSWSub, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildFSub, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildMul, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
+    macro(LLVMValueRef, BuildNSWMul, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildFMul, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildSDiv, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
     macro(LLVMValueRef, BuildFDiv, (LLVMBuilderRef, LLVMValueRef LHS, LLVMValueRef RHS, const char *Name)) \
@@ -144,6 +150,8 @@
     macro(LLVMTargetDataRef, GetExecutionEngineTargetData, (LLVMExecutionEngineRef EE)) \
     macro(LLVMTargetMachineRef, GetExecutionEngineTargetMachine, (LLVMExecutionEngineRef EE)) \
     macro(void *, GetPointerToGlobal, (LLVMExecutionEngineRef EE, LLVMValueRef Global)) \
+    macro(void, AddGlobalMapping, (LLVMExecutionEngineRef EE, LLVMValueRef Global, void* Addr)) \
+    macro(uint64_t, GetFunctionAddress, (LLVMExecutionEngineRef EE, const char *Name)) \
     macro(LLVMMCJITMemoryManagerRef, CreateSimpleMCJITMemoryManager, (void *Opaque, LLVMMemoryManagerAllocateCodeSectionCallback AllocateCodeSection, LLVMMemoryManagerAllocateDataSectionCallback AllocateDataSection, LLVMMemoryManagerFinalizeMemoryCallback FinalizeMemory, LLVMMemoryManagerDestroyCallback Destory)) \
     macro(LLVMBool, VerifyModule, (LLVMModuleRef M, LLVMVerifierFailureAction Action, char **OutMessage)) \
     macro(LLVMDisasmContextRef, CreateDisasm, (const char *TripleName, void *DisInfo, int TagType, LLVMOpInfoCallback GetOpInfo, LLVMSymbolLookupCallback SymbolLookUp)) \
@@ -169,7 +177,13 @@
     macro(void, AddInstructionCombiningPass, (LLVMPassManagerRef PM)) \
     macro(void, AddPromoteMemoryToRegisterPass, (LLVMPassManagerRef PM)) \
     macro(void, AddConstantPropagationPass, (LLVMPassManagerRef PM)) \
+    macro(void, AddLoopRotatePass, (LLVMPassManagerRef PM)) \
+    macro(void, AddIndVarSimplifyPass, (LLVMPassManagerRef PM)) \
+    macro(void, AddLoopUnrollPass, (LLVMPassManagerRef PM)) \
+    macro(void, AddLoopVectorizePass, (LLVMPassManagerRef PM)) \
+    macro(void, AddSLPVectorizePass, (LLVMPassManagerRef PM)) \
     macro(void, AddTypeBasedAliasAnalysisPass, (LLVMPassManagerRef PM)) \
+    macro(void, AddScopedNoAliasAAPass, (LLVMPassManagerRef PM)) \
     macro(void, AddBasicAliasAnalysisPass, (LLVMPassManagerRef PM))
 
 #endif // LLVMAPIFunctions_h
@@ -55,6 +55,7 @@
 #include <llvm-c/Transforms/IPO.h>
 #include <llvm-c/Transforms/PassManagerBuilder.h>
 #include <llvm-c/Transforms/Scalar.h>
+#include <llvm-c/Transforms/Vectorize.h>
 
 #include <polly/RegisterPasses.h>
 #include <polly/Canonicalization.h>
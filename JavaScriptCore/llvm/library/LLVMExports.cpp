@@ -28,6 +28,9 @@
 #if HAVE(LLVM)
 
 #include "LLVMAPI.h"
+#include "LLVMParallelCodeGen.h"
+#include "LLVMPassTiming.h"
+#include "LLVMPollyReport.h"
 #include "LLVMTrapCallback.h"
 
 // Include some extra LLVM C++ headers. This is the only place where including LLVM C++
@@ -70,6 +73,104 @@ void initCommandLine(Args... args)
     llvm::cl::ParseCommandLineOptions(sizeof(theArgs) / sizeof(const char*), theArgs);
 }
 
+// JSCPOLLY BEGIN
+// Polly's schedule optimizer is configured through LLVM command line options, so set them
+// the way the command line parser would. Each option can only be set once, unless it is
+// reset in between.
+static llvm::cl::Option* findPollyOption(const char* name)
+{
+#if LLVM_VERSION_MAJOR >= 4 || (LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR >= 9)
+    llvm::StringMap<llvm::cl::Option*>& options = llvm::cl::getRegisteredOptions();
+#else
+    llvm::StringMap<llvm::cl::Option*> options;
+    llvm::cl::getRegisteredOptions(options);
+#endif
+    auto iter = options.find(name);
+    if (iter == options.end())
+        return nullptr;
+    return iter->second;
+}
+
+static bool setPollyOption(const char* name, llvm::StringRef value)
+{
+    llvm::cl::Option* option = findPollyOption(name);
+    if (!option)
+        return false;
+    return !option->addOccurrence(0, name, value);
+}
+
+// Puts the option back to Polly's default and forgets that it was set.
+static bool resetPollyOption(const char* name)
+{
+#if LLVM_VERSION_MAJOR >= 4 || (LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR >= 9)
+    llvm::cl::Option* option = findPollyOption(name);
+    if (!option)
+        return false;
+    option->reset();
+    return true;
+#else
+    UNUSED_PARAM(name);
+    return false;
+#endif
+}
+
+static bool setPollyOptions(const JSC::LLVMPollyOptions& options)
+{
+    bool result = true;
+    if (options.tileSize)
+        result &= setPollyOption("polly-default-tile-size", std::to_string(options.tileSize));
+    if (options.secondLevelTiling)
+        result &= setPollyOption("polly-2nd-level-tiling", "true");
+    if (options.secondLevelTileSize)
+        result &= setPollyOption("polly-2nd-level-default-tile-size", std::to_string(options.secondLevelTileSize));
+    if (options.registerTiling)
+        result &= setPollyOption("polly-register-tiling", "true");
+    if (options.registerTileSize)
+        result &= setPollyOption("polly-register-tiling-default-tile-size", std::to_string(options.registerTileSize));
+    if (options.vectorizer)
+        result &= setPollyOption("polly-vectorizer", options.vectorizer);
+    if (options.fusion)
+        result &= setPollyOption("polly-opt-fusion", options.fusion);
+    if (options.parallel)
+        result &= setPollyOption("polly-parallel", "true");
+    if (options.vectorWidth)
+        result &= setPollyOption("polly-prevect-width", std::to_string(options.vectorWidth));
+    return result;
+}
+
+static bool configurePolly(const JSC::LLVMPollyOptions& options)
+{
+    polly::initializePollyPassesJSCPolly(options.tiling);
+    return setPollyOptions(options);
+}
+
+// For compiles that want other options than the ones configurePolly set. The passes were
+// initialized with the global tiling setting, so this can turn tiling off for one compile but
+// may not be able to turn it on.
+static bool reconfigurePolly(const JSC::LLVMPollyOptions& options)
+{
+    static const char* const pollyOptionNames[] = {
+        "polly-tiling",
+        "polly-default-tile-size",
+        "polly-2nd-level-tiling",
+        "polly-2nd-level-default-tile-size",
+        "polly-register-tiling",
+        "polly-register-tiling-default-tile-size",
+        "polly-vectorizer",
+        "polly-opt-fusion",
+        "polly-parallel",
+        "polly-prevect-width",
+    };
+
+    bool result = true;
+    for (const char* name : pollyOptionNames)
+        result &= resetPollyOption(name);
+    if (!options.tiling)
+        result &= setPollyOption("polly-tiling", "false");
+    return setPollyOptions(options) && result;
+}
+// JSCPOLLY END
+
 extern "C" JSC::LLVMAPI* initializeAndGetJSCLLVMAPI(
     void (*callback)(const char*, ...) NO_RETURN,
     bool* enableFastISel)
@@ -139,11 +240,20 @@ extern "C" JSC::LLVMAPI* initializeAndGetJSCLLVMAPI(
 	// Polly passes
 	result->GetGlobalPassRegistry = LLVMGetGlobalPassRegistry;
 	result->initializePollyPasses = polly::initializePollyPasses;
-	result->initializePollyPassesJSCPolly = polly::initializePollyPassesJSCPolly;
+	result->configurePolly = configurePolly;
+	result->reconfigurePolly = reconfigurePolly;
 	result->registerPollyPasses = polly::registerPollyPasses;
 	result->registerCanonicalicationPasses = polly::registerCanonicalicationPasses;
+	result->addPollyDetectionReportPass = JSC::addPollyDetectionReportPass;
+	result->addPollyCodeGenerationReportPass = JSC::addPollyCodeGenerationReportPass;
     // JSCPOLLY END
 
+    result->splitModuleByFunction = JSC::splitModuleByFunction;
+    result->emitObjectFile = JSC::emitObjectFile;
+    result->addObjectFile = JSC::addObjectFile;
+
+    result->addPassTimingMarker = JSC::addPassTimingMarker;
+
     // Handle conditionally available functions.
 #if LLVM_VERSION_MAJOR >= 4 || (LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR >= 6)
     result->AddLowerSwitchPass = LLVMAddLowerSwitchPass;
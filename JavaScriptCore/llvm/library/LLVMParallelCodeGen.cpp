@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config_llvm.h"
+
+#if HAVE(LLVM)
+
+#include "LLVMParallelCodeGen.h"
+
+// See LLVMExports.cpp for why LLVM C++ headers need this dance.
+
+#define __STDC_LIMIT_MACROS
+#define __STDC_CONSTANT_MACROS
+
+#if COMPILER(CLANG)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-noreturn"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#endif // COMPILER(CLANG)
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/ReaderWriter.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+
+#if COMPILER(CLANG)
+#pragma clang diagnostic pop
+#endif // COMPILER(CLANG)
+
+#undef __STDC_LIMIT_MACROS
+#undef __STDC_CONSTANT_MACROS
+
+#include <algorithm>
+#include <vector>
+
+namespace JSC {
+
+static unsigned instructionCount(const llvm::Function& function)
+{
+    unsigned result = 0;
+    for (const llvm::BasicBlock& block : function)
+        result += block.size();
+    return result;
+}
+
+static void makeHiddenGlobal(llvm::GlobalValue& value)
+{
+    if (value.isDeclaration() || !value.hasLocalLinkage())
+        return;
+    if (!value.hasName())
+        value.setName("jsc.partition.symbol");
+    value.setLinkage(llvm::GlobalValue::ExternalLinkage);
+    value.setVisibility(llvm::GlobalValue::HiddenVisibility);
+}
+
+static LLVMMemoryBufferRef writeBitcode(const llvm::Module& module)
+{
+    llvm::SmallVector<char, 0> bitcode;
+    llvm::raw_svector_ostream stream(bitcode);
+#if LLVM_VERSION_MAJOR >= 7
+    llvm::WriteBitcodeToFile(module, stream);
+#else
+    llvm::WriteBitcodeToFile(&module, stream);
+#endif
+    return llvm::wrap(llvm::MemoryBuffer::getMemBufferCopy(
+        llvm::StringRef(bitcode.data(), bitcode.size())).release());
+}
+
+unsigned splitModuleByFunction(
+    LLVMModuleRef moduleRef, LLVMValueRef mainFunctionRef, unsigned minimumInstructionCount,
+    LLVMMemoryBufferRef* partitions, unsigned maxPartitions)
+{
+    llvm::Module& module = *llvm::unwrap(moduleRef);
+    llvm::Function* mainFunction = llvm::unwrap<llvm::Function>(mainFunctionRef);
+
+    std::vector<std::pair<unsigned, llvm::Function*>> functions;
+    unsigned numLargeFunctions = 0;
+    for (llvm::Function& function : module) {
+        if (function.isDeclaration())
+            continue;
+        unsigned count = instructionCount(function);
+        functions.push_back(std::make_pair(count, &function));
+        if (count >= minimumInstructionCount)
+            numLargeFunctions++;
+    }
+    if (maxPartitions < 2 || numLargeFunctions < 2)
+        return 0;
+
+    // Hand out the functions largest first, each to the partition with the fewest instructions
+    // so far. The main function is placed first so that it owns the first partition.
+    std::sort(functions.begin(), functions.end(),
+        [] (const std::pair<unsigned, llvm::Function*>& a, const std::pair<unsigned, llvm::Function*>& b) {
+            return a.first > b.first;
+        });
+    unsigned numPartitions = std::min<unsigned>(maxPartitions, functions.size());
+    std::vector<unsigned> partitionSizes(numPartitions, 0);
+    llvm::DenseMap<const llvm::Function*, unsigned> partitionOfFunction;
+    partitionOfFunction[mainFunction] = 0;
+    partitionSizes[0] = instructionCount(*mainFunction);
+    for (auto& entry : functions) {
+        if (entry.second == mainFunction)
+            continue;
+        unsigned partition = std::min_element(partitionSizes.begin(), partitionSizes.end()) - partitionSizes.begin();
+        partitionOfFunction[entry.second] = partition;
+        partitionSizes[partition] += entry.first;
+    }
+
+    for (llvm::Function& function : module)
+        makeHiddenGlobal(function);
+    for (llvm::GlobalVariable& variable : module.globals())
+        makeHiddenGlobal(variable);
+
+    for (unsigned i = 0; i < numPartitions; ++i) {
+        // Global variables are defined in the first partition and declared in the others.
+        auto shouldCloneDefinition = [&] (const llvm::GlobalValue* value) -> bool {
+            if (const llvm::Function* function = llvm::dyn_cast<llvm::Function>(value))
+                return partitionOfFunction.lookup(function) == i;
+            return !i;
+        };
+        llvm::ValueToValueMapTy map;
+#if LLVM_VERSION_MAJOR >= 4
+        std::unique_ptr<llvm::Module> partition = llvm::CloneModule(module, map, shouldCloneDefinition);
+#else
+        std::unique_ptr<llvm::Module> partition = llvm::CloneModule(&module, map, shouldCloneDefinition);
+#endif
+        if (i) {
+            for (llvm::Function& function : *partition) {
+                if (function.isDeclaration())
+                    continue;
+                function.addFnAttr(llvm::Attribute::NoUnwind);
+                function.removeFnAttr(llvm::Attribute::UWTable);
+            }
+        }
+        partitions[i] = writeBitcode(*partition);
+    }
+
+    for (llvm::Function& function : module) {
+        if (!function.isDeclaration())
+            function.deleteBody();
+    }
+    for (llvm::GlobalVariable& variable : module.globals())
+        variable.setInitializer(nullptr);
+
+    return numPartitions;
+}
+
+LLVMMemoryBufferRef emitObjectFile(LLVMTargetMachineRef targetMachineRef, LLVMMemoryBufferRef bitcodeRef, char** error)
+{
+    std::unique_ptr<llvm::MemoryBuffer> bitcode(llvm::unwrap(bitcodeRef));
+    const llvm::TargetMachine& engineTargetMachine = *reinterpret_cast<llvm::TargetMachine*>(targetMachineRef);
+
+    llvm::LLVMContext context;
+#if LLVM_VERSION_MAJOR >= 4
+    llvm::Expected<std::unique_ptr<llvm::Module>> module = llvm::parseBitcodeFile(bitcode->getMemBufferRef(), context);
+    if (!module) {
+        *error = strdup(llvm::toString(module.takeError()).c_str());
+        return nullptr;
+    }
+#else
+    llvm::ErrorOr<std::unique_ptr<llvm::Module>> module = llvm::parseBitcodeFile(bitcode->getMemBufferRef(), context);
+    if (!module) {
+        *error = strdup(module.getError().message().c_str());
+        return nullptr;
+    }
+#endif
+
+    // The engine's target machine already holds everything MCJIT would have used, including
+    // the code model and the optimization level of the backend.
+    std::unique_ptr<llvm::TargetMachine> targetMachine(engineTargetMachine.getTarget().createTargetMachine(
+        engineTargetMachine.getTargetTriple().str(), engineTargetMachine.getTargetCPU(),
+        engineTargetMachine.getTargetFeatureString(), engineTargetMachine.Options,
+        engineTargetMachine.getRelocationModel(), engineTargetMachine.getCodeModel(),
+        engineTargetMachine.getOptLevel()));
+
+    llvm::SmallVector<char, 0> object;
+    {
+        llvm::raw_svector_ostream stream(object);
+        llvm::legacy::PassManager passManager;
+        if (targetMachine->addPassesToEmitFile(passManager, stream, llvm::TargetMachine::CGFT_ObjectFile)) {
+            *error = strdup("Target does not support emitting object files");
+            return nullptr;
+        }
+        passManager.run(**module);
+    }
+
+    return llvm::wrap(llvm::MemoryBuffer::getMemBufferCopy(
+        llvm::StringRef(object.data(), object.size())).release());
+}
+
+bool addObjectFile(LLVMExecutionEngineRef engineRef, LLVMMemoryBufferRef objectRef)
+{
+    std::unique_ptr<llvm::MemoryBuffer> buffer(llvm::unwrap(objectRef));
+    auto object = llvm::object::ObjectFile::createObjectFile(buffer->getMemBufferRef());
+    if (!object) {
+#if LLVM_VERSION_MAJOR >= 4
+        llvm::consumeError(object.takeError());
+#endif
+        return false;
+    }
+    llvm::unwrap(engineRef)->addObjectFile(
+        llvm::object::OwningBinary<llvm::object::ObjectFile>(std::move(*object), std::move(buffer)));
+    return true;
+}
+
+} // namespace JSC
+
+#endif // HAVE(LLVM)
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef LLVMParallelCodeGen_h
+#define LLVMParallelCodeGen_h
+
+#if HAVE(LLVM)
+
+#include "LLVMAPI.h"
+
+namespace JSC {
+
+// Splits a module along function boundaries so that the pieces can be code-generated on
+// several threads. Each partition is returned as bitcode, since LLVM contexts can't be shared
+// between threads. mainFunction goes into the first partition and keeps its unwind info; the
+// others are made nounwind so that their objects don't bring in unwind sections of their own.
+// All local symbols are made hidden globals so that the partitions can be linked back together,
+// and the module is left with only declarations. Returns 0 and leaves the module alone unless
+// at least two functions have minimumInstructionCount instructions or more.
+unsigned splitModuleByFunction(
+    LLVMModuleRef, LLVMValueRef mainFunction, unsigned minimumInstructionCount,
+    LLVMMemoryBufferRef* partitions, unsigned maxPartitions);
+
+// Generates an object file for a partition, with a copy of the given target machine. Takes
+// ownership of the bitcode. May be called on any thread, as long as nothing is generating code
+// with targetMachine at the same time. Returns null and sets error on failure.
+LLVMMemoryBufferRef emitObjectFile(LLVMTargetMachineRef, LLVMMemoryBufferRef bitcode, char** error);
+
+// Loads an object file into the execution engine, which takes ownership of it. The engine
+// resolves symbols between its modules and the objects it loaded when it is finalized.
+bool addObjectFile(LLVMExecutionEngineRef, LLVMMemoryBufferRef object);
+
+} // namespace JSC
+
+#endif // HAVE(LLVM)
+
+#endif // LLVMParallelCodeGen_h
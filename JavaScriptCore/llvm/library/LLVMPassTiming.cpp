@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config_llvm.h"
+
+#if HAVE(LLVM)
+
+#include "LLVMPassTiming.h"
+
+// See LLVMExports.cpp for why LLVM C++ headers need this dance.
+
+#define __STDC_LIMIT_MACROS
+#define __STDC_CONSTANT_MACROS
+
+#if COMPILER(CLANG)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-noreturn"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#endif // COMPILER(CLANG)
+
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Pass.h>
+
+#if COMPILER(CLANG)
+#pragma clang diagnostic pop
+#endif // COMPILER(CLANG)
+
+#undef __STDC_LIMIT_MACROS
+#undef __STDC_CONSTANT_MACROS
+
+namespace JSC {
+
+namespace {
+
+class PassTimingMarker : public llvm::ModulePass {
+public:
+    static char ID;
+
+    PassTimingMarker(const LLVMPassTimingClient& client, const char* passName)
+        : llvm::ModulePass(ID)
+        , m_client(client)
+        , m_passName(passName)
+    {
+    }
+
+    void getAnalysisUsage(llvm::AnalysisUsage& usage) const override
+    {
+        usage.setPreservesAll();
+    }
+
+    bool runOnModule(llvm::Module&) override
+    {
+        m_client.didRunPass(m_client.context, m_passName);
+        return false;
+    }
+
+private:
+    LLVMPassTimingClient m_client;
+    const char* m_passName;
+};
+
+char PassTimingMarker::ID = 0;
+
+} // anonymous namespace
+
+void addPassTimingMarker(llvm::legacy::PassManagerBase& passManager, const LLVMPassTimingClient& client, const char* passName)
+{
+    passManager.add(new PassTimingMarker(client, passName));
+}
+
+} // namespace JSC
+
+#endif // HAVE(LLVM)
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config_llvm.h"
+
+#if HAVE(LLVM)
+
+#include "LLVMPollyReport.h"
+
+// See LLVMExports.cpp for why LLVM C++ headers need this dance.
+
+#define __STDC_LIMIT_MACROS
+#define __STDC_CONSTANT_MACROS
+
+#if COMPILER(CLANG)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-noreturn"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#endif // COMPILER(CLANG)
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/RegionInfo.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Pass.h>
+#include <polly/ScopDetection.h>
+#include <polly/ScopDetectionDiagnostic.h>
+
+#if COMPILER(CLANG)
+#pragma clang diagnostic pop
+#endif // COMPILER(CLANG)
+
+#undef __STDC_LIMIT_MACROS
+#undef __STDC_CONSTANT_MACROS
+
+namespace JSC {
+
+namespace {
+
+unsigned numLoopsIn(const llvm::Region& region, const llvm::Loop& loop)
+{
+    unsigned result = region.contains(&loop) ? 1 : 0;
+    for (const llvm::Loop* subLoop : loop)
+        result += numLoopsIn(region, *subLoop);
+    return result;
+}
+
+unsigned numLoopsIn(const llvm::Region& region, const llvm::LoopInfo& loopInfo)
+{
+    unsigned result = 0;
+    for (const llvm::Loop* loop : loopInfo)
+        result += numLoopsIn(region, *loop);
+    return result;
+}
+
+bool hasPrefix(const llvm::BasicBlock* block, const char* prefix)
+{
+    return block->getName().startswith(prefix);
+}
+
+// Reports every SCoP that ScopDetection accepted, and the first reason it gave for every
+// region with loops that it looked at and rejected.
+class PollyDetectionReportPass : public llvm::FunctionPass {
+public:
+    static char ID;
+
+    PollyDetectionReportPass(const LLVMPollyReportClient& client)
+        : llvm::FunctionPass(ID)
+        , m_client(client)
+    {
+    }
+
+    void getAnalysisUsage(llvm::AnalysisUsage& usage) const override
+    {
+        usage.addRequired<llvm::LoopInfoWrapperPass>();
+        usage.addRequired<llvm::RegionInfoPass>();
+        usage.addRequired<polly::ScopDetection>();
+        usage.setPreservesAll();
+    }
+
+    bool runOnFunction(llvm::Function&) override
+    {
+        const llvm::LoopInfo& loopInfo = getAnalysis<llvm::LoopInfoWrapperPass>().getLoopInfo();
+        const polly::ScopDetection& detection = getAnalysis<polly::ScopDetection>();
+
+        for (const llvm::Region* region : detection) {
+            m_client.didDetectScop(
+                m_client.context, region->getEntry()->getName().str().c_str(),
+                numLoopsIn(*region, loopInfo));
+        }
+
+        reportRejections(*getAnalysis<llvm::RegionInfoPass>().getRegionInfo().getTopLevelRegion(), loopInfo, detection);
+        return false;
+    }
+
+private:
+    void reportRejections(const llvm::Region& region, const llvm::LoopInfo& loopInfo, const polly::ScopDetection& detection)
+    {
+        if (detection.isMaxRegionInScop(region, false))
+            return;
+
+        const polly::RejectLog* log = detection.lookupRejectionLog(&region);
+        if (log && log->size() && numLoopsIn(region, loopInfo)) {
+            m_client.didRejectRegion(
+                m_client.context, region.getEntry()->getName().str().c_str(),
+                (*log->begin())->getMessage().c_str());
+        }
+
+        for (const std::unique_ptr<llvm::Region>& subregion : region)
+            reportRejections(*subregion, loopInfo, detection);
+    }
+
+    LLVMPollyReportClient m_client;
+};
+
+char PollyDetectionReportPass::ID = 0;
+
+// Polly's code generator versions each SCoP it optimizes: "polly.split_new_and_old" branches
+// either to the new code, starting at "polly.start", or to the original region. We count
+// the loops of the new code and look for vector instructions in it, and report them against
+// the entry of the original region.
+class PollyCodeGenerationReportPass : public llvm::FunctionPass {
+public:
+    static char ID;
+
+    PollyCodeGenerationReportPass(const LLVMPollyReportClient& client)
+        : llvm::FunctionPass(ID)
+        , m_client(client)
+    {
+    }
+
+    void getAnalysisUsage(llvm::AnalysisUsage& usage) const override
+    {
+        usage.setPreservesAll();
+    }
+
+    bool runOnFunction(llvm::Function& function) override
+    {
+        for (llvm::BasicBlock& block : function) {
+            if (!hasPrefix(&block, "polly.split_new_and_old"))
+                continue;
+
+            llvm::BasicBlock* newEntry = nullptr;
+            llvm::BasicBlock* originalEntry = nullptr;
+            for (llvm::BasicBlock* successor : llvm::successors(&block)) {
+                if (hasPrefix(successor, "polly.start"))
+                    newEntry = successor;
+                else
+                    originalEntry = successor;
+            }
+            if (!newEntry || !originalEntry)
+                continue;
+
+            unsigned numGeneratedLoops = 0;
+            bool isVectorized = false;
+            llvm::SmallPtrSet<llvm::BasicBlock*, 32> seen;
+            llvm::SmallVector<llvm::BasicBlock*, 32> worklist;
+            seen.insert(newEntry);
+            worklist.push_back(newEntry);
+            while (!worklist.empty()) {
+                llvm::BasicBlock* current = worklist.pop_back_val();
+                if (hasPrefix(current, "polly.loop_header"))
+                    numGeneratedLoops++;
+                for (llvm::Instruction& instruction : *current) {
+                    if (instruction.getType()->isVectorTy())
+                        isVectorized = true;
+                }
+                for (llvm::BasicBlock* successor : llvm::successors(current)) {
+                    if (hasPrefix(successor, "polly.merge_new_and_old") || hasPrefix(successor, "polly.exiting"))
+                        continue;
+                    if (seen.insert(successor).second)
+                        worklist.push_back(successor);
+                }
+            }
+
+            m_client.didGenerateScop(
+                m_client.context, originalEntry->getName().str().c_str(), numGeneratedLoops, isVectorized);
+        }
+        return false;
+    }
+
+private:
+    LLVMPollyReportClient m_client;
+};
+
+char PollyCodeGenerationReportPass::ID = 0;
+
+} // anonymous namespace
+
+void addPollyDetectionReportPass(llvm::legacy::PassManagerBase& passManager, const LLVMPollyReportClient& client)
+{
+    passManager.add(new PollyDetectionReportPass(client));
+}
+
+void addPollyCodeGenerationReportPass(llvm::legacy::PassManagerBase& passManager, const LLVMPollyReportClient& client)
+{
+    passManager.add(new PollyCodeGenerationReportPass(client));
+}
+
+} // namespace JSC
+
+#endif // HAVE(LLVM)
@@ -106,6 +106,13 @@ void Compilation::setJettisonReason(JettisonReason jettisonReason, const FireDet
         m_additionalJettisonReason = CString();
 }
 
+PollyReport& Compilation::ensurePollyReport()
+{
+    if (!m_pollyReport)
+        m_pollyReport = std::make_unique<PollyReport>();
+    return *m_pollyReport;
+}
+
 JSValue Compilation::toJS(ExecState* exec) const
 {
     JSObject* result = constructEmptyObject(exec);
@@ -142,6 +149,11 @@ JSValue Compilation::toJS(ExecState* exec) const
         exits->putDirectIndex(exec, i, m_osrExits[i].toJS(exec));
     result->putDirect(exec->vm(), exec->propertyNames().osrExits, exits);
     
+    if (m_pollyReport)
+        result->putDirect(exec->vm(), exec->propertyNames().polly, m_pollyReport->toJS(exec));
+    if (!m_passPipeline.isNull())
+        result->putDirect(exec->vm(), exec->propertyNames().passPipeline, jsString(exec, String::fromUTF8(m_passPipeline)));
+    
     result->putDirect(exec->vm(), exec->propertyNames().numInlinedGetByIds, jsNumber(m_numInlinedGetByIds));
     result->putDirect(exec->vm(), exec->propertyNames().numInlinedPutByIds, jsNumber(m_numInlinedPutByIds));
     result->putDirect(exec->vm(), exec->propertyNames().numInlinedCalls, jsNumber(m_numInlinedCalls));
@@ -35,6 +35,7 @@
 #include "ProfilerOSRExit.h"
 #include "ProfilerOSRExitSite.h"
 #include "ProfilerOriginStack.h"
+#include "ProfilerPollyReport.h"
 #include "ProfilerProfiledBytecodes.h"
 #include <wtf/RefCounted.h>
 #include <wtf/SegmentedVector.h>
@@ -75,6 +76,13 @@ public:
     
     void setJettisonReason(JettisonReason, const FireDetail*);
     
+    // Only FTL compiles that ran Polly have one of these.
+    PollyReport& ensurePollyReport();
+    const PollyReport* pollyReport() const { return m_pollyReport.get(); }
+
+    // The LLVM pass pipeline that the FTL picked for this compile.
+    void setPassPipeline(const CString& passPipeline) { m_passPipeline = passPipeline; }
+    
     JSValue toJS(ExecState*) const;
     
 private:
@@ -87,6 +95,8 @@ private:
     HashMap<OriginStack, std::unique_ptr<ExecutionCounter>> m_counters;
     Vector<OSRExitSite> m_osrExitSites;
     SegmentedVector<OSRExit> m_osrExits;
+    std::unique_ptr<PollyReport> m_pollyReport;
+    CString m_passPipeline;
     unsigned m_numInlinedGetByIds;
     unsigned m_numInlinedPutByIds;
     unsigned m_numInlinedCalls;
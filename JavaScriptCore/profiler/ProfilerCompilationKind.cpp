@@ -48,6 +48,9 @@ void printInternal(PrintStream& out, JSC::Profiler::CompilationKind kind)
     case JSC::Profiler::FTLForOSREntry:
         out.print("FTLForOSREntry");
         return;
+    case JSC::Profiler::FTLForPolly:
+        out.print("FTLForPolly");
+        return;
     default:
         CRASH();
         return;
@@ -33,7 +33,8 @@ enum CompilationKind {
     Baseline,
     DFG,
     FTL,
-    FTLForOSREntry
+    FTLForOSREntry,
+    FTLForPolly
 };
 
 } } // namespace JSC::Profiler
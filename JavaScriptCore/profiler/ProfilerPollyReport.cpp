@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#include "config.h"
+#include "ProfilerPollyReport.h"
+
+#include "JSGlobalObject.h"
+#include "ObjectConstructor.h"
+#include "JSCInlines.h"
+
+namespace JSC { namespace Profiler {
+
+PollyScop::PollyScop(const OriginStack& origin, unsigned numLoops, unsigned numGeneratedLoops, bool isOptimized, bool isVectorized)
+    : m_origin(origin)
+    , m_numLoops(numLoops)
+    , m_numGeneratedLoops(numGeneratedLoops)
+    , m_isOptimized(isOptimized)
+    , m_isVectorized(isVectorized)
+{
+}
+
+PollyScop::~PollyScop()
+{
+}
+
+JSValue PollyScop::toJS(ExecState* exec) const
+{
+    JSObject* result = constructEmptyObject(exec);
+    result->putDirect(exec->vm(), exec->propertyNames().origin, m_origin.toJS(exec));
+    result->putDirect(exec->vm(), exec->propertyNames().loops, jsNumber(m_numLoops));
+    result->putDirect(exec->vm(), exec->propertyNames().generatedLoops, jsNumber(m_numGeneratedLoops));
+    result->putDirect(exec->vm(), exec->propertyNames().isOptimized, jsBoolean(m_isOptimized));
+    result->putDirect(exec->vm(), exec->propertyNames().isTiled, jsBoolean(isTiled()));
+    result->putDirect(exec->vm(), exec->propertyNames().isVectorized, jsBoolean(m_isVectorized));
+    return result;
+}
+
+PollyRejection::PollyRejection(const OriginStack& origin, const CString& reason)
+    : m_origin(origin)
+    , m_reason(reason)
+{
+}
+
+PollyRejection::~PollyRejection()
+{
+}
+
+JSValue PollyRejection::toJS(ExecState* exec) const
+{
+    JSObject* result = constructEmptyObject(exec);
+    result->putDirect(exec->vm(), exec->propertyNames().origin, m_origin.toJS(exec));
+    result->putDirect(exec->vm(), exec->propertyNames().reason, jsString(exec, String::fromUTF8(m_reason)));
+    return result;
+}
+
+PollyReport::PollyReport()
+    : m_milliseconds(0)
+{
+}
+
+PollyReport::~PollyReport()
+{
+}
+
+JSValue PollyReport::toJS(ExecState* exec) const
+{
+    JSObject* result = constructEmptyObject(exec);
+
+    JSArray* scops = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < m_scops.size(); ++i)
+        scops->putDirectIndex(exec, i, m_scops[i].toJS(exec));
+    result->putDirect(exec->vm(), exec->propertyNames().scops, scops);
+
+    JSArray* rejections = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < m_rejections.size(); ++i)
+        rejections->putDirectIndex(exec, i, m_rejections[i].toJS(exec));
+    result->putDirect(exec->vm(), exec->propertyNames().rejections, rejections);
+
+    result->putDirect(exec->vm(), exec->propertyNames().milliseconds, jsNumber(m_milliseconds));
+    return result;
+}
+
+} } // namespace JSC::Profiler
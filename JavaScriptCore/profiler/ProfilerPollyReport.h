@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+
+#ifndef ProfilerPollyReport_h
+#define ProfilerPollyReport_h
+
+#include "JSCJSValue.h"
+#include "ProfilerOriginStack.h"
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+
+namespace JSC { namespace Profiler {
+
+// A region of an FTL compile that Polly modeled as a static control part. The origin is
+// that of the region's entry block.
+class PollyScop {
+public:
+    PollyScop(const OriginStack&, unsigned numLoops, unsigned numGeneratedLoops, bool isOptimized, bool isVectorized);
+    ~PollyScop();
+
+    const OriginStack& origin() const { return m_origin; }
+    unsigned numLoops() const { return m_numLoops; }
+    unsigned numGeneratedLoops() const { return m_numGeneratedLoops; }
+    bool isOptimized() const { return m_isOptimized; }
+    bool isVectorized() const { return m_isVectorized; }
+
+    // Polly only adds loops to a nest when it tiles or strip-mines it.
+    bool isTiled() const { return m_isOptimized && m_numGeneratedLoops > m_numLoops; }
+
+    JSValue toJS(ExecState*) const;
+
+private:
+    OriginStack m_origin;
+    unsigned m_numLoops;
+    unsigned m_numGeneratedLoops;
+    bool m_isOptimized;
+    bool m_isVectorized;
+};
+
+// A region with loops that Polly looked at and could not model.
+class PollyRejection {
+public:
+    PollyRejection(const OriginStack&, const CString& reason);
+    ~PollyRejection();
+
+    const OriginStack& origin() const { return m_origin; }
+    const CString& reason() const { return m_reason; }
+
+    JSValue toJS(ExecState*) const;
+
+private:
+    OriginStack m_origin;
+    CString m_reason;
+};
+
+// What Polly did to one FTL compile.
+class PollyReport {
+public:
+    PollyReport();
+    ~PollyReport();
+
+    void addScop(const PollyScop& scop) { m_scops.append(scop); }
+    void addRejection(const PollyRejection& rejection) { m_rejections.append(rejection); }
+    void setMilliseconds(double milliseconds) { m_milliseconds = milliseconds; }
+
+    const Vector<PollyScop>& scops() const { return m_scops; }
+    const Vector<PollyRejection>& rejections() const { return m_rejections; }
+    double milliseconds() const { return m_milliseconds; }
+
+    JSValue toJS(ExecState*) const;
+
+private:
+    Vector<PollyScop> m_scops;
+    Vector<PollyRejection> m_rejections;
+    double m_milliseconds;
+};
+
+} } // namespace JSC::Profiler
+
+#endif // ProfilerPollyReport_h
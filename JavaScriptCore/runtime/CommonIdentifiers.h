@@ -118,6 +118,7 @@
     macro(forward) \
     macro(from) \
     macro(fromCharCode) \
+    macro(generatedLoops) \
     macro(get) \
     macro(global) \
     macro(go) \
@@ -136,7 +137,10 @@
     macro(instructionCount) \
     macro(isArray) \
     macro(isEnabled) \
+    macro(isOptimized) \
     macro(isPrototypeOf) \
+    macro(isTiled) \
+    macro(isVectorized) \
     macro(isView) \
     macro(isWatchpoint) \
     macro(jettisonReason) \
@@ -147,7 +151,9 @@
     macro(line) \
     macro(locale) \
     macro(localeMatcher) \
+    macro(loops) \
     macro(message) \
+    macro(milliseconds) \
     macro(multiline) \
     macro(name) \
     macro(next) \
@@ -163,14 +169,19 @@
     macro(osrExits) \
     macro(parse) \
     macro(parseInt) \
+    macro(passPipeline) \
+    macro(polly) \
     macro(postMessage) \
     macro(profiledBytecodes) \
     macro(propertyIsEnumerable) \
     macro(prototype) \
     macro(raw) \
+    macro(reason) \
+    macro(rejections) \
     macro(reload) \
     macro(replace) \
     macro(resolve) \
+    macro(scops) \
     macro(sensitivity) \
     macro(set) \
     macro(showModalDialog) \
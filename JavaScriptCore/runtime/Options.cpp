@@ -292,6 +292,7 @@ static void recomputeDependentOptions()
         || Options::verboseCompilationQueue()
         || Options::reportCompileTimes()
         || Options::reportFTLCompileTimes()
+        || Options::recordCompileTimes()
         || Options::verboseCFA()
         || Options::verboseFTLFailure())
         Options::alwaysComputeHash() = true;
@@ -112,9 +112,32 @@ typedef const char* optionString;
     v(bool, jscpolly, false, "enable polly in LLVM passes\n") \
     v(bool, jscpollyNo, false, "enable polly in LLVM passes but only registration\n") \
     v(bool, jscpollyTiling, true, "enable first level tilling in polly\n") \
+    v(unsigned, jscpollyTileSize, 0, "first level tile size used by polly, 0 for polly's default\n") \
+    v(bool, jscpollySecondLevelTiling, false, "tile the tiles polly's first level tiling produces once more\n") \
+    v(unsigned, jscpollySecondLevelTileSize, 0, "second level tile size used by polly, 0 for polly's default\n") \
+    v(bool, jscpollyRegisterTiling, false, "enable register tiling in polly\n") \
+    v(unsigned, jscpollyRegisterTileSize, 0, "register tile size used by polly, 0 for polly's default\n") \
+    v(optionString, jscpollyVectorizer, nullptr, "vectorization strategy of polly: none, polly or stripmine\n") \
+    v(optionString, jscpollyFusion, nullptr, "loop fusion policy of polly's scheduler: min or max\n") \
+    v(unsigned, jscpollyVectorWidth, 0, "width polly strip-mines the innermost loops to for vectorization, 0 for polly's default\n") \
+    v(optionString, jscpollyFunctionOverrides, nullptr, "file with polly settings for individual functions, in the format of dfgWhitelist followed by settings such as polly=off or tileSize=64\n") \
+    v(bool, jscpollyTileSizesFromCaches, false, "derive the polly tile sizes that are left at 0 from the sizes of the host's caches\n") \
+    v(bool, jscpollyParallel, false, "let polly run the outer parallel loops it finds on several threads\n") \
+    v(unsigned, jscpollyParallelLoopThreads, computeNumberOfWorkerThreads(64), "number of threads, counting the one running the FTL code, that run the iterations of a parallel loop\n") \
+    v(unsigned, jscpollyMinimumParallelLoopIterations, 64, "parallel loops with fewer iterations run on one thread\n") \
+    v(optionString, jscpollyCacheDirectory, nullptr, "directory in which to remember, across runs, which functions polly could optimize, so that the others are compiled without it and these skip the background tier\n") \
     v(bool, jscpollyDumpLLVMRT, false, "dumps llvm runtime behavior\n") \
-    v(bool, jscpollyUseStackmaps, true, "enable/disable generation of stackmaps in LLVM code\n") \
+    v(bool, jscpollyVerboseReport, false, "dumps the SCoPs polly detected, rejected and optimized in each FTL compile, and the time it took\n") \
+    v(bool, jscpollyAliasChecks, true, "check at the loop pre-header that the arrays a loop writes don't share storage with the other arrays it accesses, and tell LLVM they don't alias, when compiling with polly\n") \
 	v(bool, jscpollyDumpOSRExit, false, "dump each OSR exit from LLVM code\n") \
+    v(bool, jscpollyPerFunctionPolicy, true, "decide per function whether the FTL runs polly, instead of for every FTL compile\n") \
+    v(bool, jscpollyVerbosePolicy, false, "dumps why polly was or was not selected for each FTL compile\n") \
+    v(unsigned, jscpollyMinimumLoopDepth, 1, "minimum loop nest depth for a function to be compiled with polly\n") \
+    v(unsigned, jscpollyMinimumAffineAccesses, 1, "minimum number of affine array accesses in loops for a function to be compiled with polly\n") \
+    v(double, jscpollyMinimumAffineAccessRatio, 0.5, "minimum weighted ratio of affine array accesses among all array accesses in loops\n") \
+    v(double, jscpollyMinimumExecutionCount, 0, "minimum baseline execution count for a function to be compiled with polly\n") \
+    v(bool, jscpollyBackgroundTier, true, "compile functions selected for polly without it first, and recompile them with polly in the background once their loops are hot\n") \
+    v(unsigned, jscpollyTierUpLoopIterations, 100000, "number of loop iterations plain FTL code runs before it is recompiled with polly\n") \
 	\
     v(bool, reportMustSucceedExecutableAllocations, false, nullptr) \
     \
@@ -167,6 +190,8 @@ typedef const char* optionString;
     v(bool, reportCompileTimes, false, "dumps JS function signature and the time it took to compile\n") \
     v(bool, reportFTLCompileTimes, false, "dumps JS function signature and the time it took to FTL compile\n") \
     v(bool, reportTotalCompileTimes, false, nullptr) \
+    v(bool, recordCompileTimes, false, "record how long each phase of each DFG and FTL compile took, for compileTimes() in the jsc shell\n") \
+    v(unsigned, maximumRecordedCompileTimes, 10000, "number of compiles for which recordCompileTimes keeps the phase times; the histograms and totals cover all of them\n") \
     v(bool, verboseCFA, false, nullptr) \
     v(bool, verboseFTLToJSThunk, false, nullptr) \
     v(bool, verboseFTLFailure, false, nullptr) \
@@ -188,11 +213,19 @@ typedef const char* optionString;
     v(bool, llvmAlwaysFailsBeforeCompile, false, nullptr) \
     v(bool, llvmAlwaysFailsBeforeLink, false, nullptr) \
     v(bool, llvmSimpleOpt, true, nullptr) \
+    v(optionString, llvmPassPipeline, nullptr, "LLVM pass pipeline to use with llvmSimpleOpt instead of the one picked by the cost model: fast, standard, loopHeavy or polyhedral\n") \
+    v(double, llvmLoopHeavyPassPipelineMinimumLoopFraction, 0.5, "fraction of the DFG nodes that have to be in loops for the loop-heavy LLVM pass pipeline to be picked\n") \
+    v(double, llvmLoopHeavyPassPipelineMaximumWarmUpMilliseconds, 50, "code blocks that tier up to the FTL this soon after being created get the loop-heavy LLVM pass pipeline\n") \
+    v(unsigned, llvmLoopHeavyPassPipelineMaximumNodes, 5000, "DFG graphs bigger than this never get the loop-heavy LLVM pass pipeline\n") \
     v(unsigned, llvmBackendOptimizationLevel, 2, nullptr) \
     v(unsigned, llvmOptimizationLevel, 2, nullptr) \
     v(unsigned, llvmSizeLevel, 0, nullptr) \
     v(unsigned, llvmMaxStackSize, 128 * KB, nullptr) \
-    v(bool, llvmDisallowAVX, true, nullptr) \
+    v(bool, llvmDisallowAVX, false, "don't let LLVM use AVX in FTL code, even if the host supports it\n") \
+    v(bool, llvmUseHostCPUFeatures, true, "let LLVM use the SSE4.2, AVX, AVX2 and FMA instructions that the host supports in FTL code\n") \
+    v(bool, useFTLParallelCodeGeneration, true, "generate code for the functions of an FTL module on several threads when more than one of them is large\n") \
+    v(unsigned, ftlParallelCodeGenerationMinimumInstructions, 1000, "number of LLVM instructions a function needs for it to be worth generating code for it on its own thread\n") \
+    v(bool, useFTLSharedExitThunk, true, "let OSR exits that are only reached from their own patchpoint share one exit thunk instead of getting one each\n") \
     v(bool, ftlCrashes, false, nullptr) /* fool-proof way of checking that you ended up in the FTL. ;-) */\
     v(bool, ftlCrashesIfCantInitializeLLVM, false, nullptr) \
     v(bool, clobberAllRegsInFTLICSlowPath, !ASSERT_DISABLED, nullptr) \
@@ -211,6 +244,8 @@ typedef const char* optionString;
     v(bool, useMovHintRemoval, true, nullptr) \
     v(bool, usePutStackSinking, true, nullptr) \
     v(bool, useObjectAllocationSinking, true, nullptr) \
+    v(bool, useInductionVariableOverflowElimination, true, nullptr) \
+    v(bool, useLoopPredication, true, nullptr) \
     v(bool, useCopyBarrierOptimization, true, nullptr) \
     \
     v(bool, useConcurrentJIT, true, "allows the DFG / FTL compilation in threads other than the executing JS thread\n") \
@@ -345,6 +380,10 @@ typedef const char* optionString;
     v(unsigned, fireOSRExitFuzzAtOrAfter, 0, nullptr) \
     \
     v(bool, logB3PhaseTimes, false, nullptr) \
+    v(unsigned, maximumTmpsForAirGraphColoring, 10000, "Air code with more Tmps than this gets its registers allocated by linear scan rather than by graph coloring\n") \
+    v(bool, useParallelAirRegisterAllocation, true, "compute the liveness and interference graph of large Air code on helper threads\n") \
+    v(unsigned, minimumInstsForParallelAirRegisterAllocation, 20000, "Air code with fewer instructions than this computes its liveness and interference graph on one thread\n") \
+    v(unsigned, numberOfAirHelperThreads, computeNumberOfWorkerThreads(4, 2) - 1, "number of threads, not counting the one running the compile, that help with the liveness and interference of large Air code\n") \
     \
     v(bool, useDollarVM, false, "installs the $vm debugging tool in global objects\n") \
     v(optionString, functionOverrides, nullptr, "file with debugging overrides for function bodies\n") \
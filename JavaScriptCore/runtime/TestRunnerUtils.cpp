@@ -27,6 +27,7 @@
 #include "TestRunnerUtils.h"
 
 #include "CodeBlock.h"
+#include "FTLJITCode.h"
 #include "JSCInlines.h"
 
 namespace JSC {
@@ -75,6 +76,21 @@ JSValue numberOfDFGCompiles(JSValue theFunctionValue)
     return jsNumber(0);
 }
 
+JSValue numberOfFTLOSRExitsSharingCode(JSValue theFunctionValue)
+{
+#if ENABLE(FTL_JIT)
+    if (FunctionExecutable* executable = getExecutableForFunction(theFunctionValue)) {
+        CodeBlock* codeBlock = executable->codeBlockFor(CodeForCall);
+        if (codeBlock && codeBlock->jitType() == JITCode::FTLJIT)
+            return jsNumber(codeBlock->jitCode()->ftl()->numberOfOSRExitsSharingCode);
+    }
+#else
+    UNUSED_PARAM(theFunctionValue);
+#endif
+
+    return jsNumber(0);
+}
+
 JSValue setNeverInline(JSValue theFunctionValue)
 {
     if (FunctionExecutable* executable = getExecutableForFunction(theFunctionValue))
@@ -117,6 +133,13 @@ JSValue numberOfDFGCompiles(ExecState* exec)
     return numberOfDFGCompiles(exec->uncheckedArgument(0));
 }
 
+JSValue numberOfFTLOSRExitsSharingCode(ExecState* exec)
+{
+    if (exec->argumentCount() < 1)
+        return jsUndefined();
+    return numberOfFTLOSRExitsSharingCode(exec->uncheckedArgument(0));
+}
+
 JSValue setNeverInline(ExecState* exec)
 {
     if (exec->argumentCount() < 1)
@@ -0,0 +1,46 @@
+//@ runMiscFTLNoCJITTest("--recordCompileTimes=true")
+
+function foo(a) {
+    var result = 0;
+    for (var i = 0; i < a.length; ++i)
+        result += a[i];
+    return result;
+}
+noInline(foo);
+
+var array = [1, 2, 3, 4, 5];
+for (var i = 0; i < 100000; ++i) {
+    var result = foo(array);
+    if (result != 15)
+        throw "Error: bad result: " + result;
+}
+
+var times = JSON.parse(compileTimes());
+
+if (!times.compiles.length)
+    throw "Error: no compiles were recorded";
+for (var i = 0; i < times.compiles.length; ++i) {
+    var compile = times.compiles[i];
+    if (typeof compile.codeBlock != "string" || typeof compile.mode != "string" || typeof compile.path != "string")
+        throw "Error: bad compile record: " + JSON.stringify(compile);
+    if (!(compile.milliseconds >= 0))
+        throw "Error: bad compile time: " + JSON.stringify(compile);
+    for (var phase in compile.phases) {
+        if (!(compile.phases[phase] >= 0))
+            throw "Error: bad time for phase " + phase + ": " + JSON.stringify(compile);
+    }
+}
+
+var numHistogrammed = 0;
+for (var tier of ["DFG", "FTL"]) {
+    var histogram = times.histograms[tier];
+    if (histogram[histogram.length - 1].upToMilliseconds !== null)
+        throw "Error: last bucket of the " + tier + " histogram should be unbounded";
+    for (var i = 0; i < histogram.length; ++i)
+        numHistogrammed += histogram[i].count;
+}
+if (numHistogrammed < times.compiles.length)
+    throw "Error: histograms have fewer compiles than were recorded";
+
+if (!Object.keys(times.phaseTotals).length)
+    throw "Error: no phase totals";
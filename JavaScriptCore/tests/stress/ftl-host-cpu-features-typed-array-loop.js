@@ -0,0 +1,46 @@
+//@ runMiscFTLNoCJITTest("--llvmUseHostCPUFeatures=true", "--llvmDisallowAVX=false")
+//@ runMiscFTLNoCJITTest("--llvmUseHostCPUFeatures=false")
+
+// Float64Array loops are what the vectorizer widens when the host supports AVX. The second
+// function has an inline cache, so it must be compiled without AVX and still interoperate
+// with the first.
+
+function axpy(a, x, y, n) {
+    for (var i = 0; i < n; ++i)
+        y[i] = a * x[i] + y[i];
+}
+noInline(axpy);
+
+function sumWithProperty(object, array, n) {
+    var sum = 0;
+    for (var i = 0; i < n; ++i)
+        sum += array[i] * object.scale;
+    return sum;
+}
+noInline(sumWithProperty);
+
+var n = 1000;
+var x = new Float64Array(n);
+var y = new Float64Array(n);
+for (var i = 0; i < n; ++i)
+    x[i] = i / 4;
+
+var object = { scale: 0.5 };
+
+for (var iteration = 0; iteration < 1000; ++iteration) {
+    for (var i = 0; i < n; ++i)
+        y[i] = i % 3;
+    axpy(2, x, y, n);
+    for (var i = 0; i < n; ++i) {
+        var expected = 2 * (i / 4) + (i % 3);
+        if (y[i] !== expected)
+            throw "Error: bad result at " + i + ": " + y[i] + " but expected " + expected;
+    }
+
+    var sum = sumWithProperty(object, y, n);
+    var expectedSum = 0;
+    for (var i = 0; i < n; ++i)
+        expectedSum += y[i] * 0.5;
+    if (sum !== expectedSum)
+        throw "Error: bad sum: " + sum + " but expected " + expectedSum;
+}
@@ -0,0 +1,30 @@
+//@ runMiscFTLNoCJITTest("--useFTLSharedExitThunk=true")
+//@ runMiscFTLNoCJITTest("--useFTLSharedExitThunk=false")
+
+// The bounds check and the hole check of a[i] exit with the same state and have nothing to
+// profile, so whichever of them fires second shares the code of the first.
+
+function foo(a, i) {
+    return a[i];
+}
+noInline(foo);
+
+var array = [1, 2, 3, 4];
+for (var i = 0; i < 100000; ++i) {
+    var result = foo(array, i & 3);
+    if (result != (i & 3) + 1)
+        throw "Error: bad result at " + i + ": " + result;
+}
+
+var holey = [1, 2, 3, 4];
+delete holey[1];
+
+var result = foo(array, 4);
+if (result !== undefined)
+    throw "Error: bad result out of bounds: " + result;
+result = foo(holey, 1);
+if (result !== undefined)
+    throw "Error: bad result for a hole: " + result;
+
+if (numberOfFTLOSRExitsSharingCode(foo) != 1)
+    throw "Error: expected one exit to share code, got " + numberOfFTLOSRExitsSharingCode(foo);
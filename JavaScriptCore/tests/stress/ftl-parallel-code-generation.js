@@ -0,0 +1,33 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false", "--jscpollyParallel=true", "--jscpollyMinimumParallelLoopIterations=1", "--ftlParallelCodeGenerationMinimumInstructions=1")
+
+// Polly outlines the parallel loop body, so with a tiny minimum size the module is split and the
+// outlined body is generated on a helper thread and linked back in.
+
+function blur(src, dst, width, height) {
+    for (var y = 1; y < height - 1; ++y) {
+        for (var x = 1; x < width - 1; ++x)
+            dst[y * width + x] = (src[(y - 1) * width + x] + src[y * width + x - 1] + src[y * width + x] + src[y * width + x + 1] + src[(y + 1) * width + x]) / 5;
+    }
+}
+noInline(blur);
+
+var width = 64;
+var height = 48;
+var src = new Float64Array(width * height);
+var dst = new Float64Array(width * height);
+for (var i = 0; i < width * height; ++i)
+    src[i] = (i * 7) % 13;
+
+var expected = new Float64Array(width * height);
+for (var y = 1; y < height - 1; ++y) {
+    for (var x = 1; x < width - 1; ++x)
+        expected[y * width + x] = (src[(y - 1) * width + x] + src[y * width + x - 1] + src[y * width + x] + src[y * width + x + 1] + src[(y + 1) * width + x]) / 5;
+}
+
+for (var iteration = 0; iteration < 2000; ++iteration) {
+    blur(src, dst, width, height);
+    for (var i = 0; i < width * height; ++i) {
+        if (dst[i] !== expected[i])
+            throw "Error: bad result at " + i + " in iteration " + iteration + ": " + dst[i];
+    }
+}
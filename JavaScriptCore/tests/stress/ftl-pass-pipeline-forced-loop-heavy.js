@@ -0,0 +1,8 @@
+//@ runMiscFTLNoCJITTest("--useProfiler=true", "--llvmPassPipeline=loopHeavy")
+
+// A forced pass pipeline is used for every FTL compile, and has to produce correct code for both
+// loopless and loop-heavy functions.
+
+load("./resources/ftl-pass-pipeline-test.js");
+
+checkPassPipelines({ glue: "loopHeavy", dot: "loopHeavy" });
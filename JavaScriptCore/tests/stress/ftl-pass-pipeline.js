@@ -0,0 +1,9 @@
+//@ runMiscFTLNoCJITTest("--useProfiler=true", "--llvmLoopHeavyPassPipelineMinimumLoopFraction=0.1")
+
+// Left to the cost model, functions without loops get the fast pass pipeline, and small functions
+// that are mostly loops get the loop-heavy one. The loop fraction is lowered so that dot doesn't
+// depend on how long it took to warm up.
+
+load("./resources/ftl-pass-pipeline-test.js");
+
+checkPassPipelines({ glue: "fast", dot: "loopHeavy" });
@@ -0,0 +1,39 @@
+//@ runMiscFTLNoCJITTest("--useFTLSharedExitThunk=true")
+//@ runMiscFTLNoCJITTest("--useFTLSharedExitThunk=false")
+
+// Exits that are only reached from their own patchpoint go through the shared exit thunk, which
+// finds the exit from the call site and then patches that site. Make several different exits of
+// the same function fire, each more than once, and check that we land at the right one.
+
+function foo(o, a, b, c) {
+    var result = o.f;
+    result += a + 1;
+    result += b * 2;
+    if (c)
+        result += c.g;
+    return result;
+}
+noInline(foo);
+
+for (var i = 0; i < 100000; ++i) {
+    var result = foo({f: 1}, i, 2, i & 1 ? {g: 3} : null);
+    var expected = 1 + i + 1 + 4 + (i & 1 ? 3 : 0);
+    if (result != expected)
+        throw "Error: bad result at " + i + ": " + result;
+}
+
+var cases = [
+    [{f: 1, h: 2}, 1, 2, null, 7],
+    [{f: 1}, 1.5, 2, null, 7.5],
+    [{f: 1}, 1, 2.5, null, 8],
+    [{f: 1}, 1, 2, {g: 3, k: 4}, 10],
+    [{f: "x"}, 1, 2, null, "x24"],
+];
+for (var j = 0; j < 3; ++j) {
+    for (var i = 0; i < cases.length; ++i) {
+        var test = cases[i];
+        var result = foo(test[0], test[1], test[2], test[3]);
+        if (result !== test[4])
+            throw "Error: bad result for case " + i + ": " + result;
+    }
+}
@@ -0,0 +1,33 @@
+function countBelow(start, n) {
+    var count = 0;
+    for (var i = start; i < n; ++i)
+        count++;
+    return count;
+}
+noInline(countBelow);
+
+function lastUpTo(start, n) {
+    var last = 0;
+    for (var i = start; i <= n; ++i)
+        last = i;
+    return [last, i];
+}
+noInline(lastUpTo);
+
+for (var i = 0; i < 10000; ++i) {
+    var result = countBelow(0, 100);
+    if (result !== 100)
+        throw "Error: bad count: " + result;
+    result = lastUpTo(0, 100);
+    if (result[0] !== 100 || result[1] !== 101)
+        throw "Error: bad last: " + result;
+}
+
+var result = countBelow(0x7ffffff0, 0x7fffffff);
+if (result !== 15)
+    throw "Error: bad count near INT_MAX: " + result;
+
+// The increment that leaves this loop does overflow.
+result = lastUpTo(0x7ffffff0, 0x7fffffff);
+if (result[0] !== 0x7fffffff || result[1] !== 0x80000000)
+    throw "Error: bad last near INT_MAX: " + result;
@@ -0,0 +1,57 @@
+//@ runMiscFTLNoCJITTest("--useLoopPredication=true")
+//@ runMiscFTLNoCJITTest("--useLoopPredication=false")
+
+function pairs(array, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i)
+        result += array[2 * i] - array[2 * i + 1];
+    return result;
+}
+noInline(pairs);
+
+function window(array, start, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i)
+        result += array[i + start] * array[i + start + 1];
+    return result;
+}
+noInline(window);
+
+// The hoisted check covers indices that the loop never reaches when it breaks out early.
+function find(array, n, value) {
+    for (var i = 0; i < n; ++i) {
+        if (array[i] == value)
+            return i;
+    }
+    return -1;
+}
+noInline(find);
+
+var array = [];
+for (var i = 0; i < 100; ++i)
+    array.push(i);
+
+for (var i = 0; i < 10000; ++i) {
+    var result = pairs(array, 50);
+    if (result != -50)
+        throw "Error: bad pairs result: " + result;
+    result = window(array, 10, 20);
+    if (result != 8660)
+        throw "Error: bad window result: " + result;
+    result = find(array, 100, i % 100);
+    if (result != i % 100)
+        throw "Error: bad find result: " + result;
+}
+
+var result = pairs(array, 51);
+if (result == result)
+    throw "Error: bad out-of-bounds pairs result: " + result;
+result = window(array, 80, 20);
+if (result == result)
+    throw "Error: bad out-of-bounds window result: " + result;
+result = window(array, -1, 2);
+if (result == result)
+    throw "Error: bad negative window result: " + result;
+result = find(array, 200, 3);
+if (result != 3)
+    throw "Error: bad early exit find result: " + result;
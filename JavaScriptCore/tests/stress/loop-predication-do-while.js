@@ -0,0 +1,74 @@
+//@ runMiscFTLNoCJITTest("--useLoopPredication=true")
+//@ runMiscFTLNoCJITTest("--useLoopPredication=false")
+
+// A do-while loop runs its body once even when the induction variable starts at or past the
+// limit, so the checks hoisted out of it have to cover the initial index. If they didn't, these
+// calls would read past the end of the array, or before its start, instead of exiting.
+
+function sum(array, i, n) {
+    var result = 0;
+    do {
+        result += array[i];
+    } while (++i < n);
+    return result;
+}
+noInline(sum);
+
+function holeFreeSum(array, i, n) {
+    var result = 0;
+    do {
+        result += array[i] * 2;
+    } while (++i < n);
+    return result;
+}
+noInline(holeFreeSum);
+
+var array = [];
+for (var i = 0; i < 100; ++i)
+    array.push(i);
+
+for (var i = 0; i < 10000; ++i) {
+    var result = sum(array, 0, 100);
+    if (result != 4950)
+        throw "Error: bad sum result: " + result;
+    result = holeFreeSum(array, 10, 20);
+    if (result != 290)
+        throw "Error: bad holeFreeSum result: " + result;
+}
+
+// Same indexing type as array, so that only the length differs.
+var empty = [1];
+empty.pop();
+var short = [1, 2, 3];
+// The hole scan must not pass a range that only covers the initial index.
+var holey = [1, 2, 3, 4, 5, 6, 7];
+delete holey[5];
+
+var tests = [
+    [empty, 5, 0],
+    [empty, 0, 0],
+    [short, 5, 0],
+    [short, 3, 3],
+    [short, -5, 0],
+    [array, -1, 0],
+    [array, 100, 50],
+    [holey, 5, 0],
+    [holey, 5, 5]
+];
+
+for (var i = 0; i < tests.length; ++i) {
+    var test = tests[i];
+    var result = sum(test[0], test[1], test[2]);
+    if (result === result)
+        throw "Error: bad sum result for test " + i + ": " + result;
+    result = holeFreeSum(test[0], test[1], test[2]);
+    if (result === result)
+        throw "Error: bad holeFreeSum result for test " + i + ": " + result;
+}
+
+var result = sum(short, 2, 0);
+if (result != 3)
+    throw "Error: bad sum result for the last element: " + result;
+result = sum(array, 0, 100);
+if (result != 4950)
+    throw "Error: bad sum result after the exits: " + result;
@@ -0,0 +1,66 @@
+//@ runMiscFTLNoCJITTest("--useLoopPredication=true")
+//@ runMiscFTLNoCJITTest("--useLoopPredication=false")
+
+function sum(array, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i)
+        result += array[i];
+    return result;
+}
+noInline(sum);
+
+function copy(from, to, n) {
+    for (var i = 0; i < n; ++i)
+        to[i] = from[i + 1];
+}
+noInline(copy);
+
+function countObjects(array, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i)
+        result += array[i].value;
+    return result;
+}
+noInline(countObjects);
+
+var ints = [];
+var doubles = [];
+var objects = [];
+for (var i = 0; i < 100; ++i) {
+    ints.push(i);
+    doubles.push(i + 0.5);
+    objects.push({ value: i });
+}
+var target = new Array(99);
+for (var i = 0; i < 99; ++i)
+    target[i] = 0;
+
+for (var i = 0; i < 10000; ++i) {
+    var result = sum(ints, 100);
+    if (result != 4950)
+        throw "Error: bad int sum: " + result;
+    result = sum(doubles, 100);
+    if (result != 5000)
+        throw "Error: bad double sum: " + result;
+    copy(ints, target, 99);
+    if (target[0] != 1 || target[98] != 99)
+        throw "Error: bad copy: " + target[0] + ", " + target[98];
+    result = countObjects(objects, 100);
+    if (result != 4950)
+        throw "Error: bad object count: " + result;
+}
+
+// Loading a hole goes up the prototype chain, so the scan before the loop has to catch it.
+Array.prototype[50] = 1000;
+delete ints[50];
+delete doubles[50];
+var result = sum(ints, 100);
+if (result != 5900)
+    throw "Error: bad int sum with a hole: " + result;
+result = sum(doubles, 100);
+if (result != 5949.5)
+    throw "Error: bad double sum with a hole: " + result;
+delete objects[50];
+result = countObjects(objects, 100);
+if (result == result)
+    throw "Error: bad object count with a hole: " + result;
@@ -0,0 +1,86 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false", "--jscpollyBackgroundTier=true", "--jscpollyTierUpLoopIterations=1000", "--useProfiler=true")
+
+// With the background tier, the FTL first compiles multiply without polly, and recompiles it with
+// polly once its loops are hot. That recompile has to be installed, and run, in place of the FTL code.
+
+function multiply(a, b, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j) {
+            var sum = 0;
+            for (var k = 0; k < n; ++k)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+noInline(multiply);
+
+var n = 8;
+var a = new Float64Array(n * n);
+var b = new Float64Array(n * n);
+var c = new Float64Array(n * n);
+for (var i = 0; i < n * n; ++i) {
+    a[i] = i % 7;
+    b[i] = (i % 5) - 2;
+}
+
+var expected = new Float64Array(n * n);
+for (var i = 0; i < n; ++i) {
+    for (var j = 0; j < n; ++j) {
+        var sum = 0;
+        for (var k = 0; k < n; ++k)
+            sum += a[i * n + k] * b[k * n + j];
+        expected[i * n + j] = sum;
+    }
+}
+
+function check(iteration) {
+    for (var i = 0; i < n * n; ++i) {
+        if (c[i] !== expected[i])
+            throw "Error: bad result at " + i + " in iteration " + iteration + ": " + c[i];
+    }
+}
+
+function compilationsOf(name, kind) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodesIDs = {};
+    for (var i = 0; i < database.bytecodes.length; ++i) {
+        if (database.bytecodes[i].inferredName == name)
+            bytecodesIDs[database.bytecodes[i].bytecodesID] = true;
+    }
+    return database.compilations.filter(function(compilation) {
+        return bytecodesIDs[compilation.bytecodesID] && compilation.compilationKind == kind;
+    });
+}
+
+function executionCount(compilation) {
+    var result = 0;
+    for (var i = 0; i < compilation.counters.length; ++i)
+        result += compilation.counters[i].executionCount;
+    return result;
+}
+
+// The profiler counts the executions of each compilation's code, so the polly code has been
+// installed once its compilation has counts of its own.
+var pollyCompilation = null;
+for (var iteration = 0; iteration < 1000 && !pollyCompilation; ++iteration) {
+    for (var i = 0; i < 1000; ++i)
+        multiply(a, b, c, n);
+    check(iteration);
+    pollyCompilation = compilationsOf("multiply", "FTLForPolly").filter(function(compilation) {
+        return executionCount(compilation) > 0;
+    })[0];
+}
+
+if (!pollyCompilation)
+    throw "Error: the polly recompile of multiply was never installed";
+if (pollyCompilation.jettisonReason != "NotJettisoned")
+    throw "Error: the polly recompile of multiply was jettisoned: " + pollyCompilation.jettisonReason;
+if (!pollyCompilation.polly || !pollyCompilation.polly.scops.some(function(scop) { return scop.isOptimized; }))
+    throw "Error: the polly recompile of multiply was not optimized by polly";
+
+var ftlCompilations = compilationsOf("multiply", "FTL");
+if (!ftlCompilations.length)
+    throw "Error: multiply was never compiled by the FTL before the polly recompile";
+if (ftlCompilations.some(function(compilation) { return compilation.polly; }))
+    throw "Error: the FTL ran polly before the background tier did";
@@ -0,0 +1,51 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false", "--jscpollyBackgroundTier=false", "--jscpollyCacheDirectory=/tmp", "--useProfiler=true")
+
+// Two copies of the same function have the same polly cache key, so the second one's compile sees
+// what the first one's recorded, the same way a later run of the same program would.
+function makeGather() {
+    return new Function("a", "indices", "n",
+        "var sum = 0; for (var i = 0; i < n; ++i) sum += a[indices[i]]; return sum;");
+}
+
+var a = new Float64Array(64);
+var indices = new Int32Array(64);
+for (var i = 0; i < a.length; ++i) {
+    a[i] = i;
+    indices[i] = (i * 7) % a.length;
+}
+
+function ftlCompilationOf(bytecodesIndex) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodes = database.bytecodes.filter(function(bytecodes) { return bytecodes.inferredName == "anonymous"; });
+    if (bytecodesIndex >= bytecodes.length)
+        return null;
+    var compilations = database.compilations.filter(function(compilation) {
+        return compilation.bytecodesID == bytecodes[bytecodesIndex].bytecodesID && compilation.compilationKind == "FTL";
+    });
+    return compilations.length ? compilations[0] : null;
+}
+
+function runUntilFTLCompiled(gather, bytecodesIndex) {
+    noInline(gather);
+    for (var iteration = 0; iteration < 1000; ++iteration) {
+        for (var i = 0; i < 1000; ++i) {
+            var result = gather(a, indices, a.length);
+            if (result != 2016)
+                throw "Error: bad result: " + result;
+        }
+        var compilation = ftlCompilationOf(bytecodesIndex);
+        if (compilation)
+            return compilation;
+    }
+    throw "Error: copy " + bytecodesIndex + " never got FTL compiled";
+}
+
+// The indirect access keeps polly from optimizing the loop. The first copy's compile may already
+// find that in the cache if the directory is left over from an earlier run.
+var first = runUntilFTLCompiled(makeGather(), 0);
+if (first.polly && first.polly.scops.some(function(scop) { return scop.isOptimized; }))
+    throw "Error: polly optimized the indirect access";
+
+var second = runUntilFTLCompiled(makeGather(), 1);
+if (second.polly)
+    throw "Error: the second copy ran polly even though the first one recorded that it optimizes nothing";
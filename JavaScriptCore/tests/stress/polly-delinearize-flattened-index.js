@@ -0,0 +1,58 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false")
+
+function multiply(a, b, c, rows, inner, cols) {
+    for (var i = 0; i < rows; ++i) {
+        for (var j = 0; j < cols; ++j) {
+            var sum = 0;
+            for (var k = 0; k < inner; ++k)
+                sum += a[i * inner + k] * b[k * cols + j];
+            c[i * cols + j] = sum;
+        }
+    }
+}
+noInline(multiply);
+
+function read(array, i, n, j) {
+    return array[i * n + j];
+}
+noInline(read);
+
+var rows = 5;
+var inner = 7;
+var cols = 3;
+var a = [];
+var b = [];
+var c = [];
+for (var i = 0; i < rows * inner; ++i)
+    a.push((i % 9) + 0.5);
+for (var i = 0; i < inner * cols; ++i)
+    b.push((i % 4) - 1.5);
+for (var i = 0; i < rows * cols; ++i)
+    c.push(0.5);
+
+var expected = [];
+for (var i = 0; i < rows; ++i) {
+    for (var j = 0; j < cols; ++j) {
+        var sum = 0;
+        for (var k = 0; k < inner; ++k)
+            sum += a[i * inner + k] * b[k * cols + j];
+        expected.push(sum);
+    }
+}
+
+for (var iteration = 0; iteration < 10000; ++iteration) {
+    multiply(a, b, c, rows, inner, cols);
+    for (var i = 0; i < rows * cols; ++i) {
+        if (c[i] !== expected[i])
+            throw "Error: bad result at " + i + ": " + c[i] + " but expected " + expected[i];
+    }
+    var result = read(a, 2, inner, 3);
+    if (result !== a[2 * inner + 3])
+        throw "Error: bad read: " + result;
+}
+
+// The index computation overflows int32 here, which must still take the overflow exit rather
+// than wrap around into the array.
+var result = read(a, 0x10000, 0x10000, 1);
+if (result !== undefined)
+    throw "Error: bad overflowing read: " + result;
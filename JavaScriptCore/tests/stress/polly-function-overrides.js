@@ -0,0 +1,113 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=false", "--jscpollyBackgroundTier=false", "--useProfiler=true", "--jscpollyFunctionOverrides=./resources/polly-function-overrides.txt")
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false", "--jscpollyBackgroundTier=false", "--useProfiler=true", "--jscpollyFunctionOverrides=./resources/polly-function-overrides.txt")
+
+function multiply(a, b, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j) {
+            var sum = 0;
+            for (var k = 0; k < n; ++k)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+noInline(multiply);
+
+function transpose(a, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j)
+            c[j * n + i] = a[i * n + j];
+    }
+}
+noInline(transpose);
+
+function addRows(a, c, n) {
+    for (var i = 0; i < n; ++i) {
+        var sum = 0;
+        for (var j = 0; j < n; ++j)
+            sum += a[i * n + j];
+        c[i] = sum;
+    }
+}
+noInline(addRows);
+
+var n = 16;
+var a = new Float64Array(n * n);
+var b = new Float64Array(n * n);
+var c = new Float64Array(n * n);
+for (var i = 0; i < n * n; ++i) {
+    a[i] = i % 7;
+    b[i] = (i % 5) - 2;
+}
+
+var product = new Float64Array(n * n);
+var transposed = new Float64Array(n * n);
+var rows = new Float64Array(n);
+for (var i = 0; i < n; ++i) {
+    for (var j = 0; j < n; ++j) {
+        var sum = 0;
+        for (var k = 0; k < n; ++k)
+            sum += a[i * n + k] * b[k * n + j];
+        product[i * n + j] = sum;
+        transposed[j * n + i] = a[i * n + j];
+        rows[i] += a[i * n + j];
+    }
+}
+
+function check(actual, expected, name, iteration) {
+    for (var i = 0; i < expected.length; ++i) {
+        if (actual[i] !== expected[i])
+            throw "Error: bad " + name + " result at " + i + " in iteration " + iteration + ": " + actual[i];
+    }
+}
+
+for (var iteration = 0; iteration < 2000; ++iteration) {
+    multiply(a, b, c, n);
+    check(c, product, "multiply", iteration);
+    transpose(a, c, n);
+    check(c, transposed, "transpose", iteration);
+    addRows(a, c, n);
+    check(c.subarray(0, n), rows, "addRows", iteration);
+}
+
+// Only FTL compiles that ran polly have a polly report, so the overrides show in which functions
+// have one, whatever jscpolly says.
+function ftlCompilationsOf(name) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodesIDs = {};
+    for (var i = 0; i < database.bytecodes.length; ++i) {
+        if (database.bytecodes[i].inferredName == name)
+            bytecodesIDs[database.bytecodes[i].bytecodesID] = true;
+    }
+    return database.compilations.filter(function(compilation) {
+        return bytecodesIDs[compilation.bytecodesID] && /^FTL/.test(compilation.compilationKind);
+    });
+}
+
+// The FTL compiles on another thread, so give it time to finish.
+function waitForFTLCompilations() {
+    for (var iteration = 0; iteration < 1000; ++iteration) {
+        if (ftlCompilationsOf("multiply").length
+            && ftlCompilationsOf("transpose").length
+            && ftlCompilationsOf("addRows").length)
+            return;
+        for (var i = 0; i < 100; ++i) {
+            multiply(a, b, c, n);
+            transpose(a, c, n);
+            addRows(a, c, n);
+        }
+    }
+    throw "Error: not all functions got FTL compiled";
+}
+waitForFTLCompilations();
+
+function ranPolly(name) {
+    return ftlCompilationsOf(name).some(function(compilation) { return !!compilation.polly; });
+}
+
+if (!ranPolly("multiply"))
+    throw "Error: polly=on was not applied to multiply";
+if (ranPolly("transpose"))
+    throw "Error: polly=off was not applied to transpose";
+if (!ranPolly("addRows"))
+    throw "Error: polly=on was not applied to addRows";
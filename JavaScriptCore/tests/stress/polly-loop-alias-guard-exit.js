@@ -0,0 +1,33 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false")
+
+function shift(dst, src, n) {
+    for (var i = 0; i < n; ++i)
+        dst[i + 1] = src[i] * 2 + 1;
+}
+
+noInline(shift);
+
+function makeArray() {
+    var array = [];
+    for (var i = 0; i < 11; ++i)
+        array.push(i);
+    return array;
+}
+
+for (var i = 0; i < 10000; ++i) {
+    var dst = makeArray();
+    shift(dst, makeArray(), 10);
+    for (var j = 1; j < dst.length; ++j) {
+        if (dst[j] != 2 * j - 1)
+            throw "Error: bad result at " + j + ": " + dst[j];
+    }
+}
+
+// When both arguments are the same array, every store feeds the next load, so the
+// accesses must not be reordered.
+var array = makeArray();
+shift(array, array, 10);
+for (var j = 0; j < array.length; ++j) {
+    if (array[j] != Math.pow(2, j) - 1)
+        throw "Error: bad aliased result at " + j + ": " + array[j];
+}
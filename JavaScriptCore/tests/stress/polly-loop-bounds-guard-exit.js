@@ -0,0 +1,26 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false")
+
+function foo(array, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i)
+        result += array[i] + array[i + 1];
+    return result;
+}
+
+noInline(foo);
+
+var array = [];
+for (var i = 0; i < 100; ++i)
+    array.push(i);
+
+for (var i = 0; i < 10000; ++i) {
+    var result = foo(array, 99);
+    if (result != 9801)
+        throw "Error: bad in-bounds result: " + result;
+}
+
+// The last iteration reads past the end, so the range check at the loop pre-header has to
+// fail and the loop has to run in the baseline code.
+var result = foo(array, 100);
+if (result == result)
+    throw "Error: bad out-of-bounds result: " + result;
@@ -0,0 +1,97 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=true", "--jscpollyVerbosePolicy=true", "--jscpollyBackgroundTier=false", "--useProfiler=true")
+
+// With the per-function policy, only the FTL compiles of functions with affine loop nests run
+// polly, and only those compilations get a polly report.
+
+function multiply(a, b, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j) {
+            var sum = 0;
+            for (var k = 0; k < n; ++k)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+noInline(multiply);
+
+// No loops at all.
+function trace(a, n) {
+    return a[0] + a[n + 1] + a[2 * n + 2];
+}
+noInline(trace);
+
+// The loop reads past the end of the array, so its only access is not in bounds.
+function sumPastTheEnd(a, n) {
+    var sum = 0;
+    for (var i = 0; i < n; ++i) {
+        var value = a[i];
+        if (value !== undefined)
+            sum += value;
+    }
+    return sum;
+}
+noInline(sumPastTheEnd);
+
+var n = 8;
+var a = new Float64Array(n * n);
+var b = new Float64Array(n * n);
+var c = new Float64Array(n * n);
+for (var i = 0; i < n * n; ++i) {
+    a[i] = i % 7;
+    b[i] = (i % 5) - 2;
+}
+var shortArray = [1, 2, 3, 4];
+
+function ftlCompilationOf(name) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodesIDs = {};
+    for (var i = 0; i < database.bytecodes.length; ++i) {
+        if (database.bytecodes[i].inferredName == name)
+            bytecodesIDs[database.bytecodes[i].bytecodesID] = true;
+    }
+    for (var i = 0; i < database.compilations.length; ++i) {
+        var compilation = database.compilations[i];
+        if (bytecodesIDs[compilation.bytecodesID] && compilation.compilationKind == "FTL")
+            return compilation;
+    }
+    return null;
+}
+
+// The FTL compiles on another thread, so give it time to finish before we look for the compilations.
+var names = ["multiply", "trace", "sumPastTheEnd"];
+var compilations = {};
+for (var iteration = 0; iteration < 1000; ++iteration) {
+    for (var i = 0; i < 1000; ++i) {
+        multiply(a, b, c, n);
+        var result = trace(a, n);
+        if (result != 6)
+            throw "Error: bad trace result: " + result;
+        result = sumPastTheEnd(shortArray, 8);
+        if (result != 10)
+            throw "Error: bad sumPastTheEnd result: " + result;
+    }
+    var missing = false;
+    for (var i = 0; i < names.length; ++i) {
+        if (!compilations[names[i]])
+            compilations[names[i]] = ftlCompilationOf(names[i]);
+        if (!compilations[names[i]])
+            missing = true;
+    }
+    if (!missing)
+        break;
+}
+
+for (var i = 0; i < names.length; ++i) {
+    if (!compilations[names[i]])
+        throw "Error: " + names[i] + " was never FTL compiled";
+}
+
+if (!compilations.multiply.polly)
+    throw "Error: the policy did not pick the affine loop nest in multiply";
+if (!compilations.multiply.polly.scops.some(function(scop) { return scop.isOptimized; }))
+    throw "Error: polly did not optimize the loop nest in multiply";
+if (compilations.trace.polly)
+    throw "Error: the policy picked trace, which has no loops";
+if (compilations.sumPastTheEnd.polly)
+    throw "Error: the policy picked sumPastTheEnd, whose only array access is out of bounds";
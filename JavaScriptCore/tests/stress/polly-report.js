@@ -0,0 +1,76 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false", "--jscpollyVerboseReport=true", "--jscpollyBackgroundTier=false", "--useProfiler=true")
+
+function multiply(a, b, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j) {
+            var sum = 0;
+            for (var k = 0; k < n; ++k)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+noInline(multiply);
+
+var n = 8;
+var a = new Float64Array(n * n);
+var b = new Float64Array(n * n);
+var c = new Float64Array(n * n);
+for (var i = 0; i < n * n; ++i) {
+    a[i] = i % 7;
+    b[i] = (i % 5) - 2;
+}
+
+var expected = new Float64Array(n * n);
+for (var i = 0; i < n; ++i) {
+    for (var j = 0; j < n; ++j) {
+        var sum = 0;
+        for (var k = 0; k < n; ++k)
+            sum += a[i * n + k] * b[k * n + j];
+        expected[i * n + j] = sum;
+    }
+}
+
+for (var iteration = 0; iteration < 10000; ++iteration) {
+    multiply(a, b, c, n);
+    for (var i = 0; i < n * n; ++i) {
+        if (c[i] !== expected[i])
+            throw "Error: bad result at " + i + " in iteration " + iteration + ": " + c[i];
+    }
+}
+
+function pollyReportOf(name) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodesIDs = {};
+    for (var i = 0; i < database.bytecodes.length; ++i) {
+        if (database.bytecodes[i].inferredName == name)
+            bytecodesIDs[database.bytecodes[i].bytecodesID] = true;
+    }
+    for (var i = 0; i < database.compilations.length; ++i) {
+        var compilation = database.compilations[i];
+        if (bytecodesIDs[compilation.bytecodesID] && compilation.polly)
+            return compilation.polly;
+    }
+    return null;
+}
+
+// The FTL compiles on another thread, so give it time to finish before we look for its report.
+var report = null;
+for (var iteration = 0; iteration < 1000 && !report; ++iteration) {
+    for (var i = 0; i < 1000; ++i)
+        multiply(a, b, c, n);
+    report = pollyReportOf("multiply");
+}
+
+if (!report)
+    throw "Error: no polly report for multiply";
+if (report.scops.length != 1)
+    throw "Error: expected one SCoP in multiply, got " + report.scops.length;
+if (!report.scops[0].isOptimized)
+    throw "Error: polly did not optimize the SCoP in multiply";
+if (report.scops[0].loops != 3)
+    throw "Error: expected the SCoP in multiply to have 3 loops, got " + report.scops[0].loops;
+if (report.scops[0].generatedLoops < report.scops[0].loops)
+    throw "Error: polly generated " + report.scops[0].generatedLoops + " loops for the 3 loops of multiply";
+if (typeof report.milliseconds != "number")
+    throw "Error: bad polly time: " + report.milliseconds;
@@ -0,0 +1,104 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false", "--jscpollyBackgroundTier=false", "--jscpollyTileSizesFromCaches=true", "--jscpollyRegisterTiling=true", "--jscpollyFusion=max", "--useProfiler=true", "--jscpollyFunctionOverrides=./resources/polly-tile-options.txt")
+
+// multiply and untiledMultiply are the same loop nest, but the overrides turn tiling off for
+// untiledMultiply. Tiling puts a loop over the tiles around each loop it tiles, which is how the
+// polly reports tell whether the tile options took effect.
+
+function multiply(a, b, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j) {
+            var sum = 0;
+            for (var k = 0; k < n; ++k)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+noInline(multiply);
+
+function untiledMultiply(a, b, c, n) {
+    for (var i = 0; i < n; ++i) {
+        for (var j = 0; j < n; ++j) {
+            var sum = 0;
+            for (var k = 0; k < n; ++k)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+noInline(untiledMultiply);
+
+var n = 20;
+var a = new Float64Array(n * n);
+var b = new Float64Array(n * n);
+var c = new Float64Array(n * n);
+for (var i = 0; i < n * n; ++i) {
+    a[i] = i % 7;
+    b[i] = (i % 5) - 2;
+}
+
+var expected = new Float64Array(n * n);
+for (var i = 0; i < n; ++i) {
+    for (var j = 0; j < n; ++j) {
+        var sum = 0;
+        for (var k = 0; k < n; ++k)
+            sum += a[i * n + k] * b[k * n + j];
+        expected[i * n + j] = sum;
+    }
+}
+
+function check(name, iteration) {
+    for (var i = 0; i < n * n; ++i) {
+        if (c[i] !== expected[i])
+            throw "Error: bad " + name + " result at " + i + " in iteration " + iteration + ": " + c[i];
+    }
+}
+
+for (var iteration = 0; iteration < 2000; ++iteration) {
+    multiply(a, b, c, n);
+    check("multiply", iteration);
+    untiledMultiply(a, b, c, n);
+    check("untiledMultiply", iteration);
+}
+
+function pollyReportOf(name) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodesIDs = {};
+    for (var i = 0; i < database.bytecodes.length; ++i) {
+        if (database.bytecodes[i].inferredName == name)
+            bytecodesIDs[database.bytecodes[i].bytecodesID] = true;
+    }
+    for (var i = 0; i < database.compilations.length; ++i) {
+        var compilation = database.compilations[i];
+        if (bytecodesIDs[compilation.bytecodesID] && compilation.polly)
+            return compilation.polly;
+    }
+    return null;
+}
+
+// The FTL compiles on another thread, so give it time to finish before we look for the reports.
+var report = null;
+var untiledReport = null;
+for (var iteration = 0; iteration < 1000 && !(report && untiledReport); ++iteration) {
+    for (var i = 0; i < 100; ++i) {
+        multiply(a, b, c, n);
+        untiledMultiply(a, b, c, n);
+    }
+    report = pollyReportOf("multiply");
+    untiledReport = pollyReportOf("untiledMultiply");
+}
+
+if (!report || !untiledReport)
+    throw "Error: no polly report for multiply or untiledMultiply";
+if (report.scops.length != 1 || !report.scops[0].isOptimized)
+    throw "Error: polly did not optimize the loop nest in multiply";
+if (untiledReport.scops.length != 1 || !untiledReport.scops[0].isOptimized)
+    throw "Error: polly did not optimize the loop nest in untiledMultiply";
+
+// Register tiling unrolls the loops it makes, so only the tiling adds loops.
+var scop = report.scops[0];
+if (scop.generatedLoops < 2 * scop.loops)
+    throw "Error: polly generated " + scop.generatedLoops + " loops for the " + scop.loops + " loops of multiply, so it did not tile them";
+var untiledScop = untiledReport.scops[0];
+if (untiledScop.generatedLoops != untiledScop.loops)
+    throw "Error: polly generated " + untiledScop.generatedLoops + " loops for the " + untiledScop.loops + " loops of untiledMultiply, even though tiling was off";
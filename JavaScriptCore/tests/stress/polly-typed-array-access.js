@@ -0,0 +1,35 @@
+//@ runMiscFTLNoCJITTest("--jscpolly=true", "--jscpollyPerFunctionPolicy=false")
+
+// Each element type gets its own copy of the loop, so that every access stays monomorphic and takes
+// the typed array GEP lowering.
+function makeScale() {
+    return new Function("dst", "src", "n", "factor",
+        "for (var i = 0; i < n; ++i) dst[i] = src[i] * factor;");
+}
+
+function test(scale, constructor, factor, expected) {
+    var src = new constructor(16);
+    var dst = new constructor(16);
+    for (var i = 0; i < src.length; ++i)
+        src[i] = i - 8;
+    scale(dst, src, dst.length, factor);
+    for (var i = 0; i < dst.length; ++i) {
+        if (dst[i] != expected(src[i] * factor))
+            throw "Error: bad result for " + constructor.name + " at " + i + ": " + dst[i];
+    }
+}
+
+var tests = [
+    [Float64Array, 1.5, function(x) { return x; }],
+    [Float32Array, 1.5, Math.fround],
+    [Int8Array, 20, function(x) { return (x << 24) >> 24; }],
+    [Uint16Array, 3, function(x) { return x & 0xffff; }],
+    [Int32Array, 3, function(x) { return x | 0; }]
+];
+
+for (var j = 0; j < tests.length; ++j) {
+    var scale = makeScale();
+    noInline(scale);
+    for (var i = 0; i < 10000; ++i)
+        test(scale, tests[j][0], tests[j][1], tests[j][2]);
+}
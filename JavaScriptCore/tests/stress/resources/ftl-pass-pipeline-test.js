@@ -0,0 +1,71 @@
+// This test module runs a loopless function and a loop-heavy one until the FTL has compiled them,
+// checking their results along the way, and then checks which LLVM pass pipeline each FTL compile
+// used, as recorded by the profiler. Tests that load it have to run with --useProfiler=true.
+
+function glue(o, x) {
+    return o.f + x * 3 - (o.g | 0);
+}
+noInline(glue);
+
+function dot(a, b) {
+    var result = 0;
+    for (var i = 0; i < a.length; ++i)
+        result += a[i] * b[i];
+    return result;
+}
+noInline(dot);
+
+var a = new Float64Array(100);
+var b = new Float64Array(100);
+var expected = 0;
+for (var i = 0; i < a.length; ++i) {
+    a[i] = i;
+    b[i] = 100 - i;
+    expected += i * (100 - i);
+}
+
+function run(iterations) {
+    for (var i = 0; i < iterations; ++i) {
+        var result = glue({f: i, g: 2}, i);
+        if (result != i * 4 - 2)
+            throw "Error: bad glue result at " + i + ": " + result;
+        result = dot(a, b);
+        if (result != expected)
+            throw "Error: bad dot result at " + i + ": " + result;
+    }
+}
+
+function ftlCompilationsOf(name) {
+    var database = JSON.parse(profilerDatabaseJSON());
+    var bytecodesIDs = {};
+    for (var i = 0; i < database.bytecodes.length; ++i) {
+        if (database.bytecodes[i].inferredName == name)
+            bytecodesIDs[database.bytecodes[i].bytecodesID] = true;
+    }
+    return database.compilations.filter(function(compilation) {
+        return bytecodesIDs[compilation.bytecodesID] && /^FTL/.test(compilation.compilationKind);
+    });
+}
+
+// Each FTL compile of glue and dot has to have used the pass pipeline named for it in
+// expectedPassPipelines.
+function checkPassPipelines(expectedPassPipelines) {
+    run(10000);
+
+    // The FTL compiles on another thread, so give it time to finish.
+    for (var iteration = 0; iteration < 1000; ++iteration) {
+        if (ftlCompilationsOf("glue").length && ftlCompilationsOf("dot").length)
+            break;
+        run(100);
+    }
+
+    for (var name in expectedPassPipelines) {
+        var compilations = ftlCompilationsOf(name);
+        if (!compilations.length)
+            throw "Error: " + name + " was never FTL compiled";
+        for (var i = 0; i < compilations.length; ++i) {
+            if (compilations[i].passPipeline != expectedPassPipelines[name])
+                throw "Error: expected " + name + " to use the " + expectedPassPipelines[name] + " pass pipeline, but it used " + compilations[i].passPipeline;
+        }
+    }
+}